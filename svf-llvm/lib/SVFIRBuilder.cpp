@@ -35,6 +35,7 @@
 #include "SVF-LLVM/LLVMUtil.h"
 #include "SVF-LLVM/SymbolTableBuilder.h"
 #include "SVFIR/PAGBuilderFromFile.h"
+#include "SVFIR/SVFFileSystem.h"
 #include "SVFIR/SVFModule.h"
 #include "SVFIR/SVFValue.h"
 #include "Util/CallGraphBuilder.h"
@@ -168,10 +169,10 @@ SVFIR* SVFIRBuilder::build()
         loopAnalysis.build(pag->getICFG());
     }
 
-    // dump SVFIR as JSON
+    // dump a binary snapshot of SVFIR
     if (!Options::DumpJson().empty())
     {
-        assert(false && "please implement SVFIRWriter::writeJsonToPath");
+        SVFIRWriter::writeToPath(pag, Options::DumpJson());
     }
 
     double endTime = SVFStat::getClk(true);
@@ -74,6 +74,8 @@ int main(int argc, char ** argv)
         cfl = std::make_unique<POCRHybrid>(svfir);
     else if (Options::POCRAlias())
         cfl = std::make_unique<POCRAlias>(svfir);
+    else if (Options::CFLMatrix())
+        cfl = std::make_unique<CFLMatrixAlias>(svfir);
     else
         cfl = std::make_unique<CFLAlias>(svfir); // if no svfg is specified, we use CFLAlias as the default one.
 
@@ -30,6 +30,7 @@
 #include "SVF-LLVM/SVFIRBuilder.h"
 #include "Util/CommandLine.h"
 #include "Util/Options.h"
+#include "SVFIR/SVFFileSystem.h"
 
 
 using namespace std;
@@ -47,7 +48,7 @@ std::string replaceExtension(const std::string& path)
         SVFUtil::errs() << "Error: expect file with extension .bc or .ll\n";
         exit(EXIT_FAILURE);
     }
-    return path.substr(0, pos) + ".svf.json";
+    return path.substr(0, pos) + ".svfir";
 }
 
 int main(int argc, char** argv)
@@ -60,11 +61,14 @@ int main(int argc, char** argv)
         LLVMModuleSet::preProcessBCs(moduleNameVec);
     }
 
-    const std::string jsonPath = replaceExtension(moduleNameVec.front());
+    SVFModule* svfModule = LLVMModuleSet::buildSVFModule(moduleNameVec);
+    SVFIRBuilder builder(svfModule);
     // PAG is borrowed from a unique_ptr, so we don't need to delete it.
+    const SVFIR* pag = builder.build();
 
-    assert(false && "Please implement SVFIRWriter::writeJsonToPath");
-    SVFUtil::outs() << "SVF IR is written to '" << jsonPath << "'\n";
+    const std::string snapshotPath = replaceExtension(moduleNameVec.front());
+    SVFIRWriter::writeToPath(pag, snapshotPath);
+    SVFUtil::outs() << "SVF IR is written to '" << snapshotPath << "'\n";
     LLVMModuleSet::releaseLLVMModuleSet();
     return 0;
 }
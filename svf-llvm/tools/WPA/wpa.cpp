@@ -29,6 +29,7 @@
 #include "SVF-LLVM/LLVMUtil.h"
 #include "SVF-LLVM/SVFIRBuilder.h"
 #include "WPA/WPAPass.h"
+#include "SVFIR/SVFFileSystem.h"
 #include "Util/CommandLine.h"
 #include "Util/Options.h"
 
@@ -48,7 +49,7 @@ int main(int argc, char** argv)
 
     if (Options::ReadJson())
     {
-        assert(false && "please implement SVFIRReader::read");
+        pag = SVFIRReader::readFromPath(moduleNameVec.front());
     }
     else
     {
@@ -48,6 +48,7 @@
 
 #include "AE/Core/AbstractValue.h"
 #include "AE/Core/IntervalValue.h"
+#include "AE/Core/PersistentAbsValMap.h"
 #include "SVFIR/SVFVariables.h"
 #include "Util/Z3Expr.h"
 
@@ -60,7 +61,8 @@ class AbstractState
     friend class SVFIR2AbsState;
     friend class RelationSolver;
 public:
-    typedef Map<u32_t, AbstractValue> VarToAbsValMap;
+    /// Copies share storage until written to (see PersistentAbsValMap)
+    typedef PersistentAbsValMap VarToAbsValMap;
 
     typedef VarToAbsValMap AddrToAbsValMap;
 
@@ -72,7 +74,7 @@ public:
 
     AbstractState(VarToAbsValMap&_varToValMap, AddrToAbsValMap&_locToValMap) : _varToAbsVal(_varToValMap), _addrToAbsVal(_locToValMap) {}
 
-    /// copy constructor
+    /// copy constructor, O(1) as the maps are copy-on-write
     AbstractState(const AbstractState&rhs) : _varToAbsVal(rhs.getVarToVal()), _addrToAbsVal(rhs.getLocToVal())
     {
 
@@ -123,7 +125,7 @@ public:
 
     AbstractState&operator=(const AbstractState&rhs)
     {
-        if (rhs != *this)
+        if (&rhs != this)
         {
             _varToAbsVal = rhs._varToAbsVal;
             _addrToAbsVal = rhs._addrToAbsVal;
@@ -153,10 +155,15 @@ public:
     AbstractState bottom() const
     {
         AbstractState inv = *this;
-        for (auto &item: inv._varToAbsVal)
+        for (u32_t i = 0; i < VarToAbsValMap::NumOfChunks; ++i)
         {
-            if (item.second.isInterval())
-                item.second.getInterval().set_to_bottom();
+            if (inv._varToAbsVal.getChunk(i).empty())
+                continue;
+            for (auto &item: inv._varToAbsVal.getMutableChunk(i))
+            {
+                if (item.second.isInterval())
+                    item.second.getInterval().set_to_bottom();
+            }
         }
         return inv;
     }
@@ -165,10 +172,15 @@ public:
     AbstractState top() const
     {
         AbstractState inv = *this;
-        for (auto &item: inv._varToAbsVal)
+        for (u32_t i = 0; i < VarToAbsValMap::NumOfChunks; ++i)
         {
-            if (item.second.isInterval())
-                item.second.getInterval().set_to_top();
+            if (inv._varToAbsVal.getChunk(i).empty())
+                continue;
+            for (auto &item: inv._varToAbsVal.getMutableChunk(i))
+            {
+                if (item.second.isInterval())
+                    item.second.getInterval().set_to_top();
+            }
         }
         return inv;
     }
@@ -323,18 +335,23 @@ public:
     bool equals(const AbstractState&other) const;
 
 
+    /// Chunks shared by lhs and rhs are equal without being compared
     static bool eqVarToValMap(const VarToAbsValMap&lhs, const VarToAbsValMap&rhs)
     {
-        if (lhs.size() != rhs.size()) return false;
-        for (const auto &item: lhs)
+        if (lhs.sharesAll(rhs)) return true;
+        for (u32_t i = 0; i < VarToAbsValMap::NumOfChunks; ++i)
         {
-            auto it = rhs.find(item.first);
-            if (it == rhs.end())
-                return false;
-            if (!item.second.equals(it->second))
-                return false;
-            else
+            if (lhs.sharesChunk(rhs, i)) continue;
+            const VarToAbsValMap::Chunk& lhsChunk = lhs.getChunk(i);
+            const VarToAbsValMap::Chunk& rhsChunk = rhs.getChunk(i);
+            if (lhsChunk.size() != rhsChunk.size()) return false;
+            for (const auto &item: lhsChunk)
             {
+                auto it = rhsChunk.find(item.first);
+                if (it == rhsChunk.end())
+                    return false;
+                if (!item.second.equals(it->second))
+                    return false;
             }
         }
         return true;
@@ -356,16 +373,20 @@ public:
     // lhs >= rhs
     static bool geqVarToValMap(const VarToAbsValMap&lhs, const VarToAbsValMap&rhs)
     {
-        if (rhs.empty()) return true;
-        for (const auto &item: rhs)
+        if (lhs.sharesAll(rhs)) return true;
+        for (u32_t i = 0; i < VarToAbsValMap::NumOfChunks; ++i)
         {
-            auto it = lhs.find(item.first);
-            if (it == lhs.end()) return false;
-            // judge from expr id
-            if (!it->second.getInterval().contain(
-                        item.second.getInterval()))
-                return false;
-
+            if (lhs.sharesChunk(rhs, i)) continue;
+            const VarToAbsValMap::Chunk& lhsChunk = lhs.getChunk(i);
+            for (const auto &item: rhs.getChunk(i))
+            {
+                auto it = lhsChunk.find(item.first);
+                if (it == lhsChunk.end()) return false;
+                // judge from expr id
+                if (!it->second.getInterval().contain(
+                            item.second.getInterval()))
+                    return false;
+            }
         }
         return true;
     }
@@ -24,6 +24,9 @@
 // Xiao Cheng, Jiawei Wang and Yulei Sui. Precise Sparse Abstract Execution via Cross-Domain Interaction.
 // 46th International Conference on Software Engineering. (ICSE24)
 
+#ifndef Z3_EXAMPLE_ABSTRACTVALUE_H
+#define Z3_EXAMPLE_ABSTRACTVALUE_H
+
 #include "AE/Core/IntervalValue.h"
 #include "AE/Core/AddressValue.h"
 #include "Util/SVFUtil.h"
@@ -154,4 +157,6 @@ public:
         return "<" + interval.toString() + ", " + addrs.toString() + ">";
     }
 };
-}
\ No newline at end of file
+}
+
+#endif // Z3_EXAMPLE_ABSTRACTVALUE_H
@@ -67,7 +67,7 @@ public:
         }
         else
         {
-            for (const auto& e : node->getOutEdges())
+            for (const auto& e : node->getOutEdgeRange())
             {
                 if (!e->isIntraCFGEdge() ||
                         node->getFun() != e->getDstNode()->getFun())
@@ -543,6 +543,9 @@ private:
     }
 }; // end class IntervalValue
 
+static_assert(std::is_trivially_copyable<IntervalValue>::value && sizeof(IntervalValue) == 32,
+              "IntervalValue is two BoundedInts, copied by value");
+
 /// Add IntervalValues
 inline IntervalValue operator+(const IntervalValue &lhs,
                                const IntervalValue &rhs)
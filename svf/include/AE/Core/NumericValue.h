@@ -36,6 +36,7 @@
 #include "SVFIR/SVFType.h"
 #include <cfloat> // For DBL_MAX
 #include <cmath>
+#include <type_traits>
 #include <utility>
 
 #define epsilon std::numeric_limits<double>::epsilon();
@@ -72,30 +73,14 @@ public:
     // flag.
     BoundedInt(s64_t fVal, bool isInf) : _iVal(fVal), _isInf(isInf) {}
 
-    // Copy constructor.
-    BoundedInt(const BoundedInt& rhs) : _iVal(rhs._iVal), _isInf(rhs._isInf) {}
-
-    // Copy assignment operator.
-    BoundedInt& operator=(const BoundedInt& rhs)
-    {
-        _iVal = rhs._iVal;
-        _isInf = rhs._isInf;
-        return *this;
-    }
-
-    // Move constructor.
-    BoundedInt(BoundedInt&& rhs) : _iVal(rhs._iVal), _isInf(rhs._isInf) {}
-
-    // Move assignment operator.
-    BoundedInt& operator=(BoundedInt&& rhs)
-    {
-        _iVal = rhs._iVal;
-        _isInf = rhs._isInf;
-        return *this;
-    }
-
-    // Virtual destructor.
-    virtual ~BoundedInt() {}
+    // Copy and move are plain member-wise copies, and there is no virtual
+    // destructor, so BoundedInt is trivially copyable and has no vtable
+    // pointer: an IntervalValue is two 16-byte bounds.
+    BoundedInt(const BoundedInt& rhs) = default;
+    BoundedInt& operator=(const BoundedInt& rhs) = default;
+    BoundedInt(BoundedInt&& rhs) = default;
+    BoundedInt& operator=(BoundedInt&& rhs) = default;
+    ~BoundedInt() = default;
 
     // Checks if the BoundedInt represents positive infinity.
     bool is_plus_infinity() const
@@ -160,57 +145,21 @@ public:
     // Checks if the BoundedInt is less than or equal to another BoundedInt.
     bool leq(const BoundedInt& rhs) const
     {
-        // If only one of the two BoundedInts is infinite.
-        if (is_infinity() ^ rhs.is_infinity())
-        {
-            if (is_infinity())
-            {
-                return is_minus_infinity();
-            }
-            else
-            {
-                return rhs.is_plus_infinity();
-            }
-        }
-        // If both BoundedInts are infinite.
-        if (is_infinity() && rhs.is_infinity())
-        {
-            if (is_minus_infinity())
-                return true;
-            else
-                return rhs.is_plus_infinity();
-        }
+        // If either BoundedInt is infinite, only -oo <= x and x <= +oo hold.
+        if (is_infinity() || rhs.is_infinity())
+            return is_minus_infinity() || rhs.is_plus_infinity();
         // If neither BoundedInt is infinite.
-        else
-            return _iVal <= rhs._iVal;
+        return _iVal <= rhs._iVal;
     }
 
     // Checks if the BoundedInt is greater than or equal to another BoundedInt.
     bool geq(const BoundedInt& rhs) const
     {
-        // If only one of the two BoundedInts is infinite.
-        if (is_infinity() ^ rhs.is_infinity())
-        {
-            if (is_infinity())
-            {
-                return is_plus_infinity();
-            }
-            else
-            {
-                return rhs.is_minus_infinity();
-            }
-        }
-        // If both BoundedInts are infinite.
-        if (is_infinity() && rhs.is_infinity())
-        {
-            if (is_plus_infinity())
-                return true;
-            else
-                return rhs.is_minus_infinity();
-        }
+        // If either BoundedInt is infinite, only +oo >= x and x >= -oo hold.
+        if (is_infinity() || rhs.is_infinity())
+            return is_plus_infinity() || rhs.is_minus_infinity();
         // If neither BoundedInt is infinite.
-        else
-            return _iVal >= rhs._iVal;
+        return _iVal >= rhs._iVal;
     }
 
     /// Reload operator
@@ -301,25 +250,18 @@ public:
             return minus_infinity();
         }
 
-        // If both numbers are positive and their sum would exceed the maximum
-        // representable number, the result is positive infinity.
-        if (lhs._iVal > 0 && rhs._iVal > 0 &&
-                (std::numeric_limits<s64_t>::max() - lhs._iVal) < rhs._iVal)
-        {
-            return plus_infinity();
-        }
-
-        // If both numbers are negative and their sum would be less than the
-        // most negative representable number, the result is negative infinity.
-        if (lhs._iVal < 0 && rhs._iVal < 0 &&
-                (-std::numeric_limits<s64_t>::max() - lhs._iVal) > rhs._iVal)
-        {
+        // If the sum overflows, both numbers have the same sign, which gives
+        // the sign of the infinity. A sum of two negative numbers equal to the
+        // most negative s64_t (which has no finite negation) is negative
+        // infinity as well.
+        s64_t sum;
+        if (__builtin_add_overflow(lhs._iVal, rhs._iVal, &sum))
+            return lhs._iVal > 0 ? plus_infinity() : minus_infinity();
+        if (sum == std::numeric_limits<s64_t>::min() && lhs._iVal < 0 && rhs._iVal < 0)
             return minus_infinity();
-        }
 
-        // If none of the above conditions are met, the numbers can be safely
-        // added.
-        return lhs._iVal + rhs._iVal;
+        // Otherwise the numbers were safely added.
+        return sum;
     }
 
     // Overloads the addition operator to safely add two BoundedInt objects.
@@ -374,7 +316,7 @@ public:
             // If the signs of the numbers are the same, the result is positive
             // infinity. If the signs of the numbers are different, the result
             // is negative infinity.
-            if (lhs._iVal * rhs._iVal > 0)
+            if ((lhs._iVal > 0) == (rhs._iVal > 0))
             {
                 return plus_infinity();
             }
@@ -384,36 +326,17 @@ public:
             }
         }
 
-        // If both numbers are positive and their product would exceed the
-        // maximum representable number, the result is positive infinity.
-        if (lhs._iVal > 0 && rhs._iVal > 0 &&
-                (std::numeric_limits<s64_t>::max() / lhs._iVal) < rhs._iVal)
-        {
-            return plus_infinity();
-        }
-
-        // If both numbers are negative and their product would exceed the
-        // maximum representable number, the result is positive infinity.
-        if (lhs._iVal < 0 && rhs._iVal < 0 &&
-                (std::numeric_limits<s64_t>::max() / lhs._iVal) > rhs._iVal)
-        {
-            return plus_infinity();
-        }
-
-        // If one number is positive and the other is negative and their product
-        // would be less than the most negative representable number, the result
-        // is negative infinity.
-        if ((lhs._iVal > 0 && rhs._iVal < 0 &&
-                (-std::numeric_limits<s64_t>::max() / lhs._iVal) > rhs._iVal) ||
-                (lhs._iVal < 0 && rhs._iVal > 0 &&
-                 (-std::numeric_limits<s64_t>::max() / rhs._iVal) > lhs._iVal))
-        {
+        // If the product overflows, the signs of the numbers give the sign of
+        // the infinity. A product equal to the most negative s64_t (which has
+        // no finite negation) is negative infinity as well.
+        s64_t product;
+        if (__builtin_mul_overflow(lhs._iVal, rhs._iVal, &product))
+            return (lhs._iVal > 0) == (rhs._iVal > 0) ? plus_infinity() : minus_infinity();
+        if (product == std::numeric_limits<s64_t>::min())
             return minus_infinity();
-        }
 
-        // If none of the above conditions are met, the numbers can be safely
-        // multiplied.
-        return lhs._iVal * rhs._iVal;
+        // Otherwise the numbers were safely multiplied.
+        return product;
     }
 
 
@@ -679,7 +602,7 @@ public:
         }
     }
 
-    inline virtual const std::string to_string() const
+    inline const std::string to_string() const
     {
         if (is_minus_infinity())
         {
@@ -717,6 +640,9 @@ public:
         abort();
     }
 };
+static_assert(std::is_trivially_copyable<BoundedInt>::value && sizeof(BoundedInt) == 16,
+              "BoundedInt is copied by value throughout the interval domain");
+
 /*!
  * Bounded double numeric value
  */
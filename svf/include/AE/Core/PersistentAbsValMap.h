@@ -0,0 +1,287 @@
+//===- PersistentAbsValMap.h ----Copy-on-write abstract value map-------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2022>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+/*
+ * PersistentAbsValMap.h
+ *
+ * A map from variable (or address) IDs to abstract values whose copies share
+ * storage until they are written to.
+ *
+ * Keys are spread over NumOfChunks chunks by their low bits. Every chunk is an
+ * ordinary Map held through a shared_ptr, and so is the table of chunks. Copying
+ * a map only copies the table pointer; the first write after a copy clones the
+ * table and the one chunk written to. The states of neighbouring ICFG nodes thus
+ * share all chunks neither of them changed, and two maps holding the same chunk
+ * are known to agree on all of its keys without looking at them.
+ *
+ * Since writes may clone a chunk, a reference returned by operator[] must not be
+ * written through once the map has been copied.
+ */
+
+#ifndef Z3_EXAMPLE_PERSISTENTABSVALMAP_H
+#define Z3_EXAMPLE_PERSISTENTABSVALMAP_H
+
+#include "AE/Core/AbstractValue.h"
+
+#include <iterator>
+#include <memory>
+
+namespace SVF
+{
+
+class PersistentAbsValMap
+{
+public:
+    typedef Map<u32_t, AbstractValue> Chunk;
+    typedef u32_t key_type;
+    typedef AbstractValue mapped_type;
+    typedef Chunk::value_type value_type;
+
+    static constexpr u32_t ChunkBits = 5;
+    static constexpr u32_t NumOfChunks = 1u << ChunkBits;
+
+private:
+    typedef std::shared_ptr<Chunk> ChunkPtr;
+
+    struct ChunkTable
+    {
+        ChunkPtr chunks[NumOfChunks];
+    };
+
+    /// Null for a map which has never been written to.
+    std::shared_ptr<ChunkTable> table;
+
+    static inline u32_t getChunkIdx(u32_t key)
+    {
+        return key & (NumOfChunks - 1);
+    }
+
+    static inline const Chunk& getEmptyChunk()
+    {
+        static const Chunk emptyChunk;
+        return emptyChunk;
+    }
+
+    inline const ChunkPtr* getChunkPtr(u32_t idx) const
+    {
+        return table == nullptr ? nullptr : &table->chunks[idx];
+    }
+
+    /// Make the chunk table ours alone, creating it if need be.
+    inline ChunkTable& getMutableTable()
+    {
+        if (table == nullptr) table = std::make_shared<ChunkTable>();
+        else if (table.use_count() > 1) table = std::make_shared<ChunkTable>(*table);
+        return *table;
+    }
+
+public:
+    /// Iterates over the entries of all chunks in turn. Only const access is
+    /// given; write through operator[] so shared chunks are cloned first.
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef PersistentAbsValMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef const value_type& reference;
+
+        const_iterator() : map(nullptr), chunkIdx(NumOfChunks) {}
+
+        const_iterator(const PersistentAbsValMap* m, u32_t idx, Chunk::const_iterator i)
+            : map(m), chunkIdx(idx), it(i)
+        {
+            skipEmptyChunks();
+        }
+
+        reference operator*() const
+        {
+            return *it;
+        }
+
+        pointer operator->() const
+        {
+            return &*it;
+        }
+
+        const_iterator& operator++()
+        {
+            ++it;
+            skipEmptyChunks();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator& rhs) const
+        {
+            if (chunkIdx != rhs.chunkIdx) return false;
+            return chunkIdx == NumOfChunks || it == rhs.it;
+        }
+
+        bool operator!=(const const_iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+        const PersistentAbsValMap* map;
+        u32_t chunkIdx;
+        Chunk::const_iterator it;
+
+        /// Move to the next entry if the current chunk is exhausted.
+        void skipEmptyChunks()
+        {
+            while (chunkIdx < NumOfChunks && it == map->getChunk(chunkIdx).end())
+            {
+                ++chunkIdx;
+                if (chunkIdx < NumOfChunks) it = map->getChunk(chunkIdx).begin();
+            }
+        }
+    };
+
+    typedef const_iterator iterator;
+
+    PersistentAbsValMap() = default;
+
+    PersistentAbsValMap(std::initializer_list<value_type> entries)
+    {
+        for (const value_type& entry : entries) (*this)[entry.first] = entry.second;
+    }
+
+    PersistentAbsValMap(const PersistentAbsValMap& rhs) = default;
+    PersistentAbsValMap(PersistentAbsValMap&& rhs) noexcept = default;
+    PersistentAbsValMap& operator=(const PersistentAbsValMap& rhs) = default;
+    PersistentAbsValMap& operator=(PersistentAbsValMap&& rhs) noexcept = default;
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0, getChunk(0).begin());
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator();
+    }
+
+    size_t size() const
+    {
+        size_t n = 0;
+        for (u32_t i = 0; i < NumOfChunks; ++i) n += getChunk(i).size();
+        return n;
+    }
+
+    bool empty() const
+    {
+        for (u32_t i = 0; i < NumOfChunks; ++i)
+            if (!getChunk(i).empty()) return false;
+        return true;
+    }
+
+    const_iterator find(u32_t key) const
+    {
+        u32_t idx = getChunkIdx(key);
+        const Chunk& chunk = getChunk(idx);
+        Chunk::const_iterator it = chunk.find(key);
+        if (it == chunk.end()) return end();
+        return const_iterator(this, idx, it);
+    }
+
+    size_t count(u32_t key) const
+    {
+        return getChunk(getChunkIdx(key)).count(key);
+    }
+
+    /// Throws std::out_of_range if key is absent, as Map::at does.
+    const AbstractValue& at(u32_t key) const
+    {
+        return getChunk(getChunkIdx(key)).at(key);
+    }
+
+    /// Default-constructs the value if key is absent.
+    AbstractValue& operator[](u32_t key)
+    {
+        return getMutableChunk(getChunkIdx(key))[key];
+    }
+
+    /// Return true if key was not in the map (the map is unchanged otherwise).
+    bool emplace(u32_t key, const AbstractValue& val)
+    {
+        if (count(key)) return false;
+        return getMutableChunk(getChunkIdx(key)).emplace(key, val).second;
+    }
+
+    void clear()
+    {
+        table.reset();
+    }
+
+    /// Chunk-level access, for operations which process two maps side by side.
+    //@{
+    const Chunk& getChunk(u32_t idx) const
+    {
+        const ChunkPtr* chunk = getChunkPtr(idx);
+        return (chunk == nullptr || *chunk == nullptr) ? getEmptyChunk() : **chunk;
+    }
+
+    /// Clones the chunk first if it is shared with another map.
+    Chunk& getMutableChunk(u32_t idx)
+    {
+        ChunkPtr& chunk = getMutableTable().chunks[idx];
+        if (chunk == nullptr) chunk = std::make_shared<Chunk>();
+        else if (chunk.use_count() > 1) chunk = std::make_shared<Chunk>(*chunk);
+        return *chunk;
+    }
+
+    /// Replace chunk idx of this map with that of rhs, without copying it.
+    void shareChunk(const PersistentAbsValMap& rhs, u32_t idx)
+    {
+        const ChunkPtr* chunk = rhs.getChunkPtr(idx);
+        getMutableTable().chunks[idx] = chunk == nullptr ? nullptr : *chunk;
+    }
+
+    /// Whether both maps hold the same storage for chunk idx, hence the same entries.
+    bool sharesChunk(const PersistentAbsValMap& rhs, u32_t idx) const
+    {
+        const ChunkPtr* lhsChunk = getChunkPtr(idx);
+        const ChunkPtr* rhsChunk = rhs.getChunkPtr(idx);
+        const Chunk* l = lhsChunk == nullptr ? nullptr : lhsChunk->get();
+        const Chunk* r = rhsChunk == nullptr ? nullptr : rhsChunk->get();
+        return l == r;
+    }
+
+    /// Whether both maps are copies of each other that neither has written to since.
+    bool sharesAll(const PersistentAbsValMap& rhs) const
+    {
+        return table == rhs.table;
+    }
+    //@}
+};
+
+} // End namespace SVF
+
+#endif // Z3_EXAMPLE_PERSISTENTABSVALMAP_H
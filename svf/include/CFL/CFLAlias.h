@@ -163,6 +163,17 @@ public:
     /// Initialize POCRHybrid Solver
     virtual void initializeSolver();
 };
+
+class CFLMatrixAlias : public CFLAlias
+{
+public:
+    CFLMatrixAlias(SVFIR* ir) : CFLAlias(ir)
+    {
+    }
+
+    /// Initialize CFLMatrix Solver
+    virtual void initializeSolver();
+};
 } // End namespace SVF
 
 #endif /* INCLUDE_CFL_CFLALIAS_H_*/
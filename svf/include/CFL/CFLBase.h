@@ -76,6 +76,12 @@ public:
     /// Get CFL graph
     CFLGraph* getCFLGraph();
 
+    /// Get CFL solver
+    inline const CFLSolver* getSolver() const
+    {
+        return solver;
+    }
+
     /// Count the num of Nonterminal Edges
     virtual void countSumEdges();
 
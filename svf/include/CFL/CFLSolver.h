@@ -49,6 +49,16 @@ public:
     typedef CFGrammar::Production Production;
     typedef CFGrammar::Symbol Symbol;
 
+    /// Statistics of one round of a round-based solver
+    struct RoundStat
+    {
+        u32_t deltaRows;    ///< rows with new edges at the start of the round
+        u32_t deltaEdges;   ///< new edges at the start of the round
+        u32_t newEdges;     ///< edges derived in the round
+        double time;        ///< seconds spent in the round
+    };
+    typedef std::vector<RoundStat> RoundStats;
+
     static double numOfChecks;
 
     CFLSolver(CFLGraph* _graph, CFGrammar* _grammar): graph(_graph), grammar(_grammar)
@@ -81,6 +91,12 @@ public:
     {
         return grammar;
     }
+
+    /// Per-round statistics, empty for worklist solvers
+    inline const RoundStats& getRoundStats() const
+    {
+        return roundStats;
+    }
     virtual inline bool pushIntoWorklist(const CFLEdge* item)
     {
         return worklist.push(item);
@@ -109,6 +125,7 @@ protected:
     CFGrammar* grammar;
     /// Worklist for resolution
     WorkList worklist;
+    RoundStats roundStats;
 
 };
 
@@ -369,6 +386,127 @@ public:
     void addArc(NodeID src, NodeID dst);
     void meld(NodeID x, TreeNode* uNode, TreeNode* vNode);
 };
+
+/*!
+ * Semi-naive solver over label-indexed adjacency matrices.
+ * Every grammar symbol gets a dense index and a matrix whose rows are the
+ * successors (and, transposed, predecessors) of each node as NodeBS.
+ * Newly derived edges are collected per (symbol, source) row and the
+ * productions are applied to a whole row delta at once: for X -> Y Z the
+ * delta of Y(i,_) joins the Z rows of its targets, and for X -> Z Y it is
+ * unioned into the X row of every Z-predecessor of i. The derived edges
+ * are added to the CFLGraph when solving ends.
+ */
+class CFLMatrixSolver : public CFLSolver
+{
+public:
+    typedef Map<NodeID, NodeBS> Matrix;         ///< rows (by node) of one symbol's matrix
+    typedef std::pair<u32_t, NodeID> RowKey;    ///< (symbol index, node)
+    typedef FIFOWorkList<RowKey> RowWorkList;
+
+    CFLMatrixSolver(CFLGraph* _graph, CFGrammar* _grammar) : CFLSolver(_graph, _grammar)
+    {
+        initialize();
+    }
+    /// Destructor
+    virtual ~CFLMatrixSolver()
+    {
+    }
+
+    /// Build the matrices from the graph edges and the epsilon productions
+    virtual void initialize();
+
+    /// Process CFLEdge
+    virtual void processCFLEdge(const CFLEdge* Y_edge);
+
+    /// Start solving
+    virtual void solve();
+
+    /// Add an edge of the graph to the matrices, to be processed by solve()
+    virtual inline bool pushIntoWorklist(const CFLEdge* item)
+    {
+        return item != nullptr && addGraphEdge(item);
+    }
+    virtual inline bool isWorklistEmpty()
+    {
+        return rowWorklist.empty();
+    }
+
+protected:
+    /// Productions indexed by one right-hand side symbol
+    struct SymbolProds
+    {
+        std::vector<u32_t> single;                      ///< X of X -> Y
+        std::vector<std::pair<u32_t, u32_t>> first;     ///< (X, Z) of X -> Y Z
+        std::vector<std::pair<u32_t, u32_t>> second;    ///< (X, Z) of X -> Z Y
+    };
+
+    /// Dense index of a symbol, created on first use
+    u32_t getSymbolIdx(Symbol sym);
+
+    /// Add a graph edge to the matrices, return true if it is new
+    bool addGraphEdge(const CFLEdge* edge);
+
+    /// Add X(i,i) of the epsilon productions for the nodes added since the last call
+    void addEpsilonEdges();
+
+    /// Add X(src, dst) for every dst in dsts, queue and record the new edges, return their number
+    u32_t addDerivedEdges(u32_t X, NodeID src, const NodeBS& dsts);
+
+    /// Apply all productions with Y on the right-hand side to edges Y(src, dst), dst in dsts
+    void processRow(u32_t Y, NodeID src, const NodeBS& dsts);
+
+    /// Join edges Y(src, dst), dst in dsts, with the matrices, passing every derived
+    /// row X(k, dsts') to addEdges(X, k, dsts') and counting the checks in checks
+    template<typename AddEdges>
+    void joinRow(u32_t Y, NodeID src, const NodeBS& dsts, double& checks, AddEdges addEdges);
+
+    /// Add the derived edges to the graph, where they are queried from
+    void flushDerivedEdges();
+
+    std::vector<Symbol> symbols;                ///< symbol of each index
+    Map<u32_t, u32_t> symToIdx;
+    std::vector<SymbolProds> symProds;
+    std::vector<Matrix> succMatrices;
+    std::vector<Matrix> predMatrices;
+    Map<RowKey, NodeBS> rowDeltas;              ///< edges of each queued row not processed yet
+    RowWorkList rowWorklist;
+    Map<RowKey, NodeBS> derivedEdges;           ///< derived edges not yet in the graph
+    NodeBS epsilonNodes;                        ///< nodes whose epsilon edges were added
+};
+
+/*!
+ * Multi-threaded CFLMatrixSolver, solving by synchronous semi-naive rounds.
+ * The row deltas of a round are partitioned by source node and joined with the
+ * matrices by the worker threads, which leave the matrices untouched and
+ * collect the derived edges in thread-local buffers. The buffers are merged
+ * into the matrices at the barrier ending the round, and the edges new to the
+ * matrices are the deltas of the next round.
+ */
+class CFLParallelSolver : public CFLMatrixSolver
+{
+public:
+    typedef Map<RowKey, NodeBS> EdgeBuffer;
+    typedef std::vector<std::pair<RowKey, NodeBS>> RowDeltas;
+
+    /// Partitions per thread, to balance the threads by work stealing
+    static constexpr u32_t PartitionsPerThread = 4;
+
+    CFLParallelSolver(CFLGraph* _graph, CFGrammar* _grammar, u32_t _threads)
+        : CFLMatrixSolver(_graph, _grammar), threads(_threads)
+    {
+    }
+    /// Destructor
+    virtual ~CFLParallelSolver()
+    {
+    }
+
+    /// Start solving
+    virtual void solve();
+
+private:
+    u32_t threads;
+};
 }
 
 #endif /* INCLUDE_CFL_CFLSolver_H_*/
\ No newline at end of file
@@ -60,6 +60,8 @@ public:
     void CFLGrammarStat();
 
     void CFLSolverStat();
+
+    void CFLRoundStat();
 };
 
 } // End namespace SVF
@@ -55,6 +55,18 @@ class ContextDDA : public CondPTAImpl<ContextCond>, public DDAVFSolver<CxtVar,Cx
 {
 
 public:
+    /// Cross-query cache of answered queries, keyed by the SVFG node defining
+    /// the queried pointer and the context of the query
+    //@{
+    typedef std::pair<NodeID, ContextCond> QueryKey;
+    struct QueryResult
+    {
+        CxtPtSet pts;
+        u32_t oobBudget;    ///< budget the query ran out of, 0 if answered within budget
+    };
+    typedef Map<QueryKey, QueryResult> QueryCache;
+    //@}
+
     /// Constructor
     ContextDDA(SVFIR* _pag, DDAClient* client);
 
@@ -79,6 +91,21 @@ public:
     /// Compute points-to set for a context-sensitive pointer
     virtual const CxtPtSet& computeDDAPts(const CxtVar& cxtVar);
 
+    /// Compute points-to sets for a batch of unconditional pointers (in another
+    /// order, so out-of-budget results may differ from computeDDAPts one by one)
+    virtual void computeDDAPtsInBatch(const OrderedNodeSet& ids) override;
+
+    /// Set the step budget of the following queries. Cached out-of-budget results
+    /// are recomputed once the budget is larger than the one they ran out of.
+    inline void setQueryBudget(u32_t budget)
+    {
+        queryBudget = budget;
+    }
+    inline u32_t getQueryBudget() const
+    {
+        return queryBudget;
+    }
+
     /// Handle out-of-budget dpm
     void handleOutOfBudgetDpm(const CxtLocDPItem& dpm);
 
@@ -223,6 +250,8 @@ private:
     ConstSVFGEdgeSet insensitveEdges;///< insensitive call-return edges
     FlowDDA* flowDDA;			///< downgrade to flowDDA if out-of-budget
     DDAClient* _client;			///< DDA client
+    QueryCache queryCache;		///< results of answered queries
+    u32_t queryBudget;			///< step budget of a query
 };
 
 } // End namespace SVF
@@ -62,6 +62,8 @@ public:
     double _AnaTimeCyclePerQuery;
     double _TotalTimeOfQueries;
     double _TotalTimeOfBKCondition;
+    u32_t _NumOfQueryCacheLookups;
+    u32_t _NumOfQueryCacheHits;
 
     NodeBS _StrongUpdateStores;
 
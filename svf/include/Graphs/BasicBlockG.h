@@ -285,6 +285,9 @@ public:
 typedef GenericGraph<SVFBasicBlock, BasicBlockEdge> GenericBasicBlockGraphTy;
 class BasicBlockGraph: public GenericBasicBlockGraphTy
 {
+    friend class SVFIRWriter;
+    friend class SVFIRReader;
+
 private:
     NodeID id{0};
     const SVFFunction* fun;
@@ -50,6 +50,8 @@ class SVFModule;
 typedef GenericEdge<CallGraphNode> GenericCallGraphEdgeTy;
 class CallGraphEdge : public GenericCallGraphEdgeTy
 {
+    friend class SVFIRWriter;
+    friend class SVFIRReader;
 
 public:
     typedef Set<const CallICFGNode*> CallInstSet;
@@ -113,6 +115,9 @@ public:
 typedef GenericNode<CallGraphNode, CallGraphEdge> GenericCallGraphNodeTy;
 class CallGraphNode : public GenericCallGraphNodeTy
 {
+    friend class SVFIRWriter;
+    friend class SVFIRReader;
+
 private:
     const SVFFunction* fun;
 
@@ -171,6 +176,8 @@ typedef GenericGraph<CallGraphNode, CallGraphEdge> GenericCallGraphTy;
 class CallGraph : public GenericCallGraphTy
 {
     friend class PTACallGraph;
+    friend class SVFIRWriter;
+    friend class SVFIRReader;
 
 public:
     typedef CallGraphEdge::CallGraphEdgeSet CallGraphEdgeSet;
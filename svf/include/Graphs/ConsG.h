@@ -45,7 +45,7 @@ class ConstraintGraph :  public GenericGraph<ConstraintNode,ConstraintEdge>
 {
 
 public:
-    typedef OrderedMap<NodeID, ConstraintNode *> ConstraintNodeIDToNodeMapTy;
+    typedef GenericGraph<ConstraintNode,ConstraintEdge>::IDToNodeMapTy ConstraintNodeIDToNodeMapTy;
     typedef ConstraintEdge::ConstraintEdgeSetTy::iterator ConstraintNodeIter;
     typedef Map<NodeID, NodeID> NodeToRepMap;
     typedef Map<NodeID, NodeBS> NodeToSubsMap;
@@ -330,6 +330,13 @@ public:
             addConstraintNode(new ConstraintNode(gep),gep);
         return gep;
     }
+    /// Get a field node only if it already exists both in SVFIR and on graph (no node is created)
+    inline bool findGepObjVar(NodeID id, const APOffset& apOffset, NodeID& gep)
+    {
+        if (!pag->findGepObjVar(id, apOffset, gep))
+            return false;
+        return sccRepNode(gep) != gep || hasConstraintNode(gep);
+    }
     /// Get a field-insensitive node of a memory object
     inline NodeID getFIObjVar(NodeID id)
     {
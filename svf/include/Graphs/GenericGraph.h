@@ -33,6 +33,8 @@
 #include "SVFIR/SVFType.h"
 #include "Util/iterator.h"
 #include "Graphs/GraphTraits.h"
+#include "Util/DenseNodeMap.h"
+#include <algorithm>
 
 namespace SVF
 {
@@ -40,6 +42,7 @@ namespace SVF
 ///@{
 template <typename, typename> class GenericGraphWriter;
 template <typename, typename> class GenericGraphReader;
+template <typename, typename> class GenericGraph;
 ///@}
 
 /*!
@@ -136,6 +139,8 @@ protected:
 
 class SVFBaseNode
 {
+    friend class SVFIRWriter;
+    friend class SVFIRReader;
 
 public:
 
@@ -421,6 +426,130 @@ protected:
     //@}
 };
 
+/*!
+ * Contiguous range of the (in or out) edges of a node in a frozen graph,
+ * pointing into the CSR arrays of the graph
+ */
+template<class EdgeTy>
+class GEdgeSpan
+{
+public:
+    typedef EdgeTy* const* iterator;
+
+    GEdgeSpan(iterator b = nullptr, iterator e = nullptr) : b(b), e(e) {}
+
+    inline iterator begin() const
+    {
+        return b;
+    }
+    inline iterator end() const
+    {
+        return e;
+    }
+    inline u32_t size() const
+    {
+        return e - b;
+    }
+    inline bool empty() const
+    {
+        return b == e;
+    }
+
+private:
+    iterator b;
+    iterator e;
+};
+
+/*!
+ * Edge iterator of GEdgeRange. It walks the CSR range of a node once its
+ * graph is frozen, and the edge set of the node otherwise.
+ */
+template<class EdgeTy>
+class GEdgeIterator
+{
+public:
+    typedef OrderedSet<EdgeTy*, typename EdgeTy::equalGEdge> GEdgeSetTy;
+
+    typedef std::forward_iterator_tag iterator_category;
+    typedef EdgeTy* value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef EdgeTy* const* pointer;
+    typedef EdgeTy* const& reference;
+
+    GEdgeIterator() : csrIt(nullptr) {}
+    GEdgeIterator(typename GEdgeSetTy::const_iterator it) : setIt(it), csrIt(nullptr) {}
+    GEdgeIterator(typename GEdgeSpan<EdgeTy>::iterator it) : csrIt(it) {}
+
+    inline reference operator*() const
+    {
+        return csrIt ? *csrIt : *setIt;
+    }
+    inline GEdgeIterator& operator++()
+    {
+        if (csrIt)
+            ++csrIt;
+        else
+            ++setIt;
+        return *this;
+    }
+    inline GEdgeIterator operator++(int)
+    {
+        GEdgeIterator tmp(*this);
+        ++*this;
+        return tmp;
+    }
+    inline bool operator==(const GEdgeIterator& rhs) const
+    {
+        return csrIt == rhs.csrIt && (csrIt || setIt == rhs.setIt);
+    }
+    inline bool operator!=(const GEdgeIterator& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+private:
+    typename GEdgeSetTy::const_iterator setIt;
+    typename GEdgeSpan<EdgeTy>::iterator csrIt;
+};
+
+/*!
+ * The (in or out) edges of a node as returned by GenericNode::getInEdgeRange() and
+ * getOutEdgeRange(): the edge set of the node, or its CSR range once the graph is
+ * frozen. Both are ordered by equalGEdge.
+ */
+template<class EdgeTy>
+class GEdgeRange
+{
+public:
+    typedef GEdgeIterator<EdgeTy> iterator;
+    typedef GEdgeIterator<EdgeTy> const_iterator;
+
+    GEdgeRange(const typename iterator::GEdgeSetTy& edges) : b(edges.begin()), e(edges.end()), num(edges.size()) {}
+    GEdgeRange(const GEdgeSpan<EdgeTy>& edges) : b(edges.begin()), e(edges.end()), num(edges.size()) {}
+
+    inline iterator begin() const
+    {
+        return b;
+    }
+    inline iterator end() const
+    {
+        return e;
+    }
+    inline u32_t size() const
+    {
+        return num;
+    }
+    inline bool empty() const
+    {
+        return num == 0;
+    }
+
+private:
+    iterator b;
+    iterator e;
+    u32_t num;
+};
+
 /*!
  * Generic node on the graph as base class
  */
@@ -429,6 +558,7 @@ class GenericNode: public SVFBaseNode
 {
     friend class SVFIRWriter;
     friend class SVFIRReader;
+    friend class GenericGraph<NodeTy, EdgeTy>;
 
 public:
     typedef NodeTy NodeType;
@@ -440,15 +570,23 @@ public:
     typedef typename GEdgeSetTy::iterator iterator;
     typedef typename GEdgeSetTy::const_iterator const_iterator;
     ///@}
+    /// CSR range of edges, used once the graph is frozen
+    typedef GEdgeSpan<EdgeType> GEdgeSpanTy;
+    /// Edges of a node, whether the graph is frozen or not
+    typedef GEdgeRange<EdgeType> GEdgeRangeTy;
 
 private:
 
-    GEdgeSetTy InEdges; ///< all incoming edge of this node
-    GEdgeSetTy OutEdges; ///< all outgoing edge of this node
+    GEdgeSetTy InEdges; ///< all incoming edge of this node (empty if frozen)
+    GEdgeSetTy OutEdges; ///< all outgoing edge of this node (empty if frozen)
+
+    bool frozen;    ///< whether the edges are in the CSR arrays of the graph instead of the edge sets
+    GEdgeSpanTy InEdgesCSR;    ///< incoming edges (if frozen)
+    GEdgeSpanTy OutEdgesCSR;   ///< outgoing edges (if frozen)
 
 public:
     /// Constructor
-    GenericNode(NodeID i, GNodeK k, const SVFType* svfType = nullptr): SVFBaseNode(i, k, svfType)
+    GenericNode(NodeID i, GNodeK k, const SVFType* svfType = nullptr): SVFBaseNode(i, k, svfType), frozen(false)
     {
 
     }
@@ -456,66 +594,98 @@ public:
     /// Destructor
     virtual ~GenericNode()
     {
-        for (auto * edge : OutEdges)
+        for (auto * edge : getOutEdgeRange())
             delete edge;
     }
 
-    /// Get incoming/outgoing edge set
+    /// Get incoming/outgoing edge set (the graph must not be frozen)
     ///@{
     inline const GEdgeSetTy& getOutEdges() const
     {
+        checkNotFrozen();
         return OutEdges;
     }
     inline const GEdgeSetTy& getInEdges() const
     {
+        checkNotFrozen();
         return InEdges;
     }
     ///@}
 
+    /// Get incoming/outgoing edges, from the CSR arrays if the graph is frozen
+    ///@{
+    inline GEdgeRangeTy getOutEdgeRange() const
+    {
+        if (frozen)
+            return GEdgeRangeTy(OutEdgesCSR);
+        return GEdgeRangeTy(OutEdges);
+    }
+    inline GEdgeRangeTy getInEdgeRange() const
+    {
+        if (frozen)
+            return GEdgeRangeTy(InEdgesCSR);
+        return GEdgeRangeTy(InEdges);
+    }
+    ///@}
+
     /// Has incoming/outgoing edge set
     //@{
     inline bool hasIncomingEdge() const
     {
-        return (InEdges.empty() == false);
+        return frozen ? !InEdgesCSR.empty() : !InEdges.empty();
     }
     inline bool hasOutgoingEdge() const
     {
-        return (OutEdges.empty() == false);
+        return frozen ? !OutEdgesCSR.empty() : !OutEdges.empty();
     }
     //@}
 
-    ///  iterators
+    /// Whether the graph of this node is frozen
+    inline bool isFrozen() const
+    {
+        return frozen;
+    }
+
+    ///  iterators of the edge sets, use getIn/OutEdgeRange() if the graph may be frozen
     //@{
     inline iterator OutEdgeBegin()
     {
+        checkNotFrozen();
         return OutEdges.begin();
     }
     inline iterator OutEdgeEnd()
     {
+        checkNotFrozen();
         return OutEdges.end();
     }
     inline iterator InEdgeBegin()
     {
+        checkNotFrozen();
         return InEdges.begin();
     }
     inline iterator InEdgeEnd()
     {
+        checkNotFrozen();
         return InEdges.end();
     }
     inline const_iterator OutEdgeBegin() const
     {
+        checkNotFrozen();
         return OutEdges.begin();
     }
     inline const_iterator OutEdgeEnd() const
     {
+        checkNotFrozen();
         return OutEdges.end();
     }
     inline const_iterator InEdgeBegin() const
     {
+        checkNotFrozen();
         return InEdges.begin();
     }
     inline const_iterator InEdgeEnd() const
     {
+        checkNotFrozen();
         return InEdges.end();
     }
     //@}
@@ -524,35 +694,43 @@ public:
     //@{
     virtual inline iterator directOutEdgeBegin()
     {
+        checkNotFrozen();
         return OutEdges.begin();
     }
     virtual inline iterator directOutEdgeEnd()
     {
+        checkNotFrozen();
         return OutEdges.end();
     }
     virtual inline iterator directInEdgeBegin()
     {
+        checkNotFrozen();
         return InEdges.begin();
     }
     virtual inline iterator directInEdgeEnd()
     {
+        checkNotFrozen();
         return InEdges.end();
     }
 
     virtual inline const_iterator directOutEdgeBegin() const
     {
+        checkNotFrozen();
         return OutEdges.begin();
     }
     virtual inline const_iterator directOutEdgeEnd() const
     {
+        checkNotFrozen();
         return OutEdges.end();
     }
     virtual inline const_iterator directInEdgeBegin() const
     {
+        checkNotFrozen();
         return InEdges.begin();
     }
     virtual inline const_iterator directInEdgeEnd() const
     {
+        checkNotFrozen();
         return InEdges.end();
     }
     //@}
@@ -561,10 +739,12 @@ public:
     //@{
     inline bool addIncomingEdge(EdgeType* inEdge)
     {
+        assert(!frozen && "can not add an edge to a frozen graph, thaw it first!");
         return InEdges.insert(inEdge).second;
     }
     inline bool addOutgoingEdge(EdgeType* outEdge)
     {
+        assert(!frozen && "can not add an edge to a frozen graph, thaw it first!");
         return OutEdges.insert(outEdge).second;
     }
     //@}
@@ -573,6 +753,7 @@ public:
     ///@{
     inline u32_t removeIncomingEdge(EdgeType* edge)
     {
+        assert(!frozen && "can not remove an edge from a frozen graph, thaw it first!");
         iterator it = InEdges.find(edge);
         assert(it != InEdges.end() && "can not find in edge in SVFG node");
         InEdges.erase(it);
@@ -580,6 +761,7 @@ public:
     }
     inline u32_t removeOutgoingEdge(EdgeType* edge)
     {
+        assert(!frozen && "can not remove an edge from a frozen graph, thaw it first!");
         iterator it = OutEdges.find(edge);
         assert(it != OutEdges.end() && "can not find out edge in SVFG node");
         OutEdges.erase(it);
@@ -591,6 +773,8 @@ public:
     //@{
     inline EdgeType* hasIncomingEdge(EdgeType* edge) const
     {
+        if (frozen)
+            return findEdge(InEdgesCSR, edge);
         const_iterator it = InEdges.find(edge);
         if (it != InEdges.end())
             return *it;
@@ -599,6 +783,8 @@ public:
     }
     inline EdgeType* hasOutgoingEdge(EdgeType* edge) const
     {
+        if (frozen)
+            return findEdge(OutEdgesCSR, edge);
         const_iterator it = OutEdges.find(edge);
         if (it != OutEdges.end())
             return *it;
@@ -616,6 +802,28 @@ public:
     {
         return true;
     }
+
+private:
+    /// The edge sets are empty once the graph is frozen, so reading them would
+    /// silently miss every edge: fail in release builds too
+    inline void checkNotFrozen() const
+    {
+        if (frozen)
+        {
+            assert(false && "use getIn/OutEdgeRange() on a frozen graph, or thaw it first!");
+            abort();
+        }
+    }
+
+    /// Binary search of edge in a CSR range (which keeps the order of the edge set)
+    static inline EdgeType* findEdge(const GEdgeSpanTy& edges, EdgeType* edge)
+    {
+        typename EdgeType::equalGEdge less;
+        auto it = std::lower_bound(edges.begin(), edges.end(), edge, less);
+        if (it != edges.end() && !less(edge, *it))
+            return *it;
+        return nullptr;
+    }
 };
 
 /*
@@ -634,7 +842,7 @@ public:
     typedef NodeTy NodeType;
     typedef EdgeTy EdgeType;
     /// NodeID to GenericNode map
-    typedef OrderedMap<NodeID, NodeType*> IDToNodeMapTy;
+    typedef DenseNodeMap<NodeType> IDToNodeMapTy;
 
     /// Node Iterators
     //@{
@@ -643,7 +851,7 @@ public:
     //@}
 
     /// Constructor
-    GenericGraph() : edgeNum(0), nodeNum(0) {}
+    GenericGraph() : frozen(false), edgeNum(0), nodeNum(0) {}
 
     /// Destructor
     virtual ~GenericGraph()
@@ -680,28 +888,29 @@ public:
     /// Add a Node
     inline void addGNode(NodeID id, NodeType* node)
     {
-        IDToNodeMap[id] = node;
+        assert(!frozen && "can not add a node to a frozen graph, thaw it first!");
+        IDToNodeMap.insert(id, node);
         nodeNum++;
     }
 
     /// Get a node
     inline NodeType* getGNode(NodeID id) const
     {
-        const_iterator it = IDToNodeMap.find(id);
-        assert(it != IDToNodeMap.end() && "Node not found!");
-        return it->second;
+        NodeType* node = IDToNodeMap.lookup(id);
+        assert(node && "Node not found!");
+        return node;
     }
 
     /// Has a node
     inline bool hasGNode(NodeID id) const
     {
-        const_iterator it = IDToNodeMap.find(id);
-        return it != IDToNodeMap.end();
+        return IDToNodeMap.lookup(id) != nullptr;
     }
 
     /// Delete a node
     inline void removeGNode(NodeType* node)
     {
+        assert(!frozen && "can not remove a node from a frozen graph, thaw it first!");
         assert(node->hasIncomingEdge() == false
                && node->hasOutgoingEdge() == false
                && "node which have edges can't be deleted");
@@ -730,9 +939,81 @@ public:
         edgeNum++;
     }
 
+    /// Freeze the graph once it is fully built: the in/out edges of all nodes are
+    /// moved from the per-node edge sets into two contiguous CSR arrays, keeping
+    /// the order of the sets, and the sets are released. getIn/OutEdgeRange(), the
+    /// has-edge queries and GenericGraphTraits then work on the CSR ranges, while
+    /// getIn/OutEdges() and the iterators of the edge sets (e.g., OutEdgeBegin())
+    /// abort.
+    /// Nodes and edges can not be added or removed until the graph is thawed.
+    void freeze()
+    {
+        if (frozen)
+            return;
+
+        size_t numOfOutEdges = 0, numOfInEdges = 0;
+        for (const auto& it : IDToNodeMap)
+        {
+            numOfOutEdges += it.second->OutEdges.size();
+            numOfInEdges += it.second->InEdges.size();
+        }
+        // one more slot so that the ranges of edgeless nodes never start at nullptr
+        csrOutEdges.reserve(numOfOutEdges + 1);
+        csrInEdges.reserve(numOfInEdges + 1);
+
+        for (const auto& it : IDToNodeMap)
+        {
+            NodeType* node = it.second;
+            node->OutEdgesCSR = moveToCSR(node->OutEdges, csrOutEdges);
+            node->InEdgesCSR = moveToCSR(node->InEdges, csrInEdges);
+            node->frozen = true;
+        }
+        frozen = true;
+    }
+
+    /// Rebuild the edge sets from the CSR arrays and release the arrays,
+    /// so that the graph can be changed again
+    void thaw()
+    {
+        if (!frozen)
+            return;
+        for (const auto& it : IDToNodeMap)
+        {
+            NodeType* node = it.second;
+            // the CSR ranges are sorted, so each insertion is at the end of the set
+            node->OutEdges.insert(node->OutEdgesCSR.begin(), node->OutEdgesCSR.end());
+            node->InEdges.insert(node->InEdgesCSR.begin(), node->InEdgesCSR.end());
+            node->OutEdgesCSR = GEdgeSpan<EdgeType>();
+            node->InEdgesCSR = GEdgeSpan<EdgeType>();
+            node->frozen = false;
+        }
+        std::vector<EdgeType*>().swap(csrOutEdges);
+        std::vector<EdgeType*>().swap(csrInEdges);
+        frozen = false;
+    }
+
+    inline bool isFrozen() const
+    {
+        return frozen;
+    }
+
 protected:
     IDToNodeMapTy IDToNodeMap; ///< node map
 
+private:
+    bool frozen;    ///< whether the edges are in the CSR arrays
+    std::vector<EdgeType*> csrOutEdges;    ///< out edges of all nodes, node by node
+    std::vector<EdgeType*> csrInEdges;     ///< in edges of all nodes, node by node
+
+    /// Append edges to csr (which has enough capacity), release them and return their range in csr
+    static GEdgeSpan<EdgeType> moveToCSR(typename GenericNode<NodeTy, EdgeTy>::GEdgeSetTy& edges, std::vector<EdgeType*>& csr)
+    {
+        size_t begin = csr.size();
+        csr.insert(csr.end(), edges.begin(), edges.end());
+        edges.clear();
+        return GEdgeSpan<EdgeType>(csr.data() + begin, csr.data() + csr.size());
+    }
+
 public:
     u32_t edgeNum;		///< total num of node
     u32_t nodeNum;		///< total num of edge
@@ -799,7 +1080,7 @@ template<class NodeTy,class EdgeTy> struct GenericGraphTraits<SVF::GenericNode<N
     }
 
     // nodes_iterator/begin/end - Allow iteration over all nodes in the graph
-    typedef mapped_iter<typename SVF::GenericNode<NodeTy,EdgeTy>::iterator, decltype(&edge_dest)> ChildIteratorType;
+    typedef mapped_iter<SVF::GEdgeIterator<EdgeTy>, decltype(&edge_dest)> ChildIteratorType;
 
     static NodeType* getEntryNode(NodeType* pagN)
     {
@@ -808,19 +1089,24 @@ template<class NodeTy,class EdgeTy> struct GenericGraphTraits<SVF::GenericNode<N
 
     static inline ChildIteratorType child_begin(const NodeType* N)
     {
-        return map_iter(N->OutEdgeBegin(), &edge_dest);
+        return map_iter(N->getOutEdgeRange().begin(), &edge_dest);
     }
     static inline ChildIteratorType child_end(const NodeType* N)
     {
-        return map_iter(N->OutEdgeEnd(), &edge_dest);
+        return map_iter(N->getOutEdgeRange().end(), &edge_dest);
     }
+    /// A frozen graph has no separate direct edges
     static inline ChildIteratorType direct_child_begin(const NodeType *N)
     {
-        return map_iter(N->directOutEdgeBegin(), &edge_dest);
+        if (N->isFrozen())
+            return child_begin(N);
+        return map_iter(SVF::GEdgeIterator<EdgeTy>(N->directOutEdgeBegin()), &edge_dest);
     }
     static inline ChildIteratorType direct_child_end(const NodeType *N)
     {
-        return map_iter(N->directOutEdgeEnd(), &edge_dest);
+        if (N->isFrozen())
+            return child_end(N);
+        return map_iter(SVF::GEdgeIterator<EdgeTy>(N->directOutEdgeEnd()), &edge_dest);
     }
 };
 
@@ -839,7 +1125,7 @@ struct GenericGraphTraits<Inverse<SVF::GenericNode<NodeTy,EdgeTy>* > >
     }
 
     // nodes_iterator/begin/end - Allow iteration over all nodes in the graph
-    typedef mapped_iter<typename SVF::GenericNode<NodeTy,EdgeTy>::iterator, decltype(&edge_dest)> ChildIteratorType;
+    typedef mapped_iter<SVF::GEdgeIterator<EdgeTy>, decltype(&edge_dest)> ChildIteratorType;
 
     static inline NodeType* getEntryNode(Inverse<NodeType* > G)
     {
@@ -848,11 +1134,11 @@ struct GenericGraphTraits<Inverse<SVF::GenericNode<NodeTy,EdgeTy>* > >
 
     static inline ChildIteratorType child_begin(const NodeType* N)
     {
-        return map_iter(N->InEdgeBegin(), &edge_dest);
+        return map_iter(N->getInEdgeRange().begin(), &edge_dest);
     }
     static inline ChildIteratorType child_end(const NodeType* N)
     {
-        return map_iter(N->InEdgeEnd(), &edge_dest);
+        return map_iter(N->getInEdgeRange().end(), &edge_dest);
     }
 
     static inline unsigned getNodeID(const NodeType* N)
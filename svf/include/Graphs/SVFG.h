@@ -327,9 +327,8 @@ protected:
 
     virtual inline void getInterVFEdgeAtIndCSFromAInToFIn(ActualINSVFGNode* actualIn, const SVFFunction* callee, SVFGEdgeSetTy& edges)
     {
-        for (SVFGNode::const_iterator outIt = actualIn->OutEdgeBegin(), outEit = actualIn->OutEdgeEnd(); outIt != outEit; ++outIt)
+        for (SVFGEdge* edge : actualIn->getOutEdgeRange())
         {
-            SVFGEdge* edge = *outIt;
             if (edge->getDstNode()->getFun() == callee)
                 edges.insert(edge);
         }
@@ -337,9 +336,8 @@ protected:
 
     virtual inline void getInterVFEdgeAtIndCSFromFOutToAOut(ActualOUTSVFGNode* actualOut, const SVFFunction* callee, SVFGEdgeSetTy& edges)
     {
-        for (SVFGNode::const_iterator inIt = actualOut->InEdgeBegin(), inEit = actualOut->InEdgeEnd(); inIt != inEit; ++inIt)
+        for (SVFGEdge* edge : actualOut->getInEdgeRange())
         {
-            SVFGEdge* edge = *inIt;
             if (edge->getSrcNode()->getFun() == callee)
                 edges.insert(edge);
         }
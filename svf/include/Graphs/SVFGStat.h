@@ -54,6 +54,7 @@ public:
     static const char* TimeOfCreateMUCHI;	///< Time for generating mu/chi for load/store/calls
     static const char* TimeOfInsertingPHI;	///< Time for inserting phis
     static const char* TimeOfSSARenaming;	///< Time for SSA rename
+    static const char* TimeOfModRefAnalysis;	///< Time for mod-ref analysis of callsites
 
     static const char* NumOfMaxRegion;	///< Number of max points-to set in region.
     static const char* NumOfAveragePtsInRegion;	///< Number of average points-to set in region.
@@ -74,6 +75,10 @@ public:
     static const char* NumOfStoreHasChi;	///< Number of stores which have chi
     static const char* NumOfBBHasMSSAPhi;	///< Number of basic blocks which have mssa phi
 
+    static const char* NumOfModRefSets;	///< Number of mod-ref sets of functions and callsites
+    static const char* NumOfUniqueModRefSets;	///< Number of distinct sets storing the mod-ref sets
+    static const char* NumOfModRefBytesSaved;	///< Bytes saved by storing identical mod-ref sets once
+
     MemSSAStat(MemSSA*);
 
     virtual ~MemSSAStat()
@@ -723,7 +723,7 @@ protected:
 
     inline virtual void forEachSuccessor(const NodeT* node, std::function<void(const NodeT*)> func) const
     {
-        for (const auto& e : node->getOutEdges())
+        for (const auto& e : node->getOutEdgeRange())
         {
             func(e->getDstNode());
         }
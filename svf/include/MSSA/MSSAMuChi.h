@@ -42,6 +42,7 @@ class MSSADEF;
  */
 class MRVer
 {
+    friend class MemSSA;
 
 public:
     typedef MSSADEF MSSADef;
@@ -82,6 +83,22 @@ public:
     {
         return vid;
     }
+
+private:
+    /// Versions built in parallel are created without an ID and numbered by
+    /// MemSSA in function order, so that IDs do not depend on the thread which
+    /// built them
+    //@{
+    struct Unnumbered {};
+    MRVer(const MemRegion* m, MRVERSION v, MSSADef* d, Unnumbered) :
+        mr(m), version(v), vid(0),def(d)
+    {
+    }
+    inline void setID()
+    {
+        vid = totalVERNum++;
+    }
+    //@}
 };
 
 
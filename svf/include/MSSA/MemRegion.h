@@ -38,6 +38,7 @@
 #include "Graphs/PTACallGraph.h"
 #include "Graphs/SCC.h"
 #include "SVFIR/SVFIR.h"
+#include "MemoryModel/PersistentPointsToCache.h"
 #include "Util/WorkList.h"
 
 #include <set>
@@ -142,6 +143,7 @@ public:
     typedef Map<const PAGEdge*, const SVFFunction*> PAGEdgeToFunMap;
     typedef OrderedSet<NodeBS, SVFUtil::equalNodeBS> PointsToList;
     typedef Map<const SVFFunction*, NodeBS> FunToPointsToMap;
+    typedef Map<const SVFFunction*, PointsToID> FunToPointsToIDMap;
     typedef Map<const SVFFunction*, PointsToList> FunToPointsTosMap;
     typedef OrderedMap<NodeBS, NodeBS, SVFUtil::equalNodeBS> PtsToRepPtsSetMap;
 
@@ -160,6 +162,7 @@ public:
     typedef Map<const LoadStmt*, NodeBS> LoadsToPointsToMap;
     typedef Map<const StoreStmt*, NodeBS> StoresToPointsToMap;
     typedef Map<const CallICFGNode*, NodeBS> CallSiteToPointsToMap;
+    typedef Map<const CallICFGNode*, PointsToID> CallSiteToPointsToIDMap;
     //@}
 
     /// Maps Mod-Ref analysis
@@ -231,6 +234,20 @@ private:
     CallSiteToPointsToMap csToRefsMap;
     /// Map a callsite to its indirect defs of memory objects
     CallSiteToPointsToMap csToModsMap;
+    /// Final mod-ref sets of functions and callsites, interned in modRefCache
+    //@{
+    FunToPointsToIDMap funToRefSummaryMap;
+    FunToPointsToIDMap funToModSummaryMap;
+    CallSiteToPointsToIDMap csToRefSummaryMap;
+    CallSiteToPointsToIDMap csToModSummaryMap;
+    //@}
+    /// Mod-ref sets of functions and callsites, identical sets are stored once
+    PersistentPointsToCache<NodeBS> modRefCache;
+    /// Time of the mod-ref analysis of callsites
+    double modRefTime;
+    /// Bytes of the mod-ref sets before and after they are interned
+    u64_t modRefBytes;
+    u64_t modRefCompactBytes;
     /// Map a callsite to all its object might pass into its callees
     CallSiteToPointsToMap csToCallSiteArgsPtsMap;
     /// Map a callsite to all its object might return from its callees
@@ -271,6 +288,16 @@ private:
     /// Get reverse topo call graph scc
     void getCallGraphSCCRevTopoOrder(WorkList& worklist);
 
+    /// Mod-Ref analysis of all callsites, solving the call graph SCCs level by level with several threads
+    void parallelModRefAnalysis(u32_t threads);
+
+    /// Mod-Ref analysis of the callsites in the call graph SCC of rep
+    void modRefAnalysisOfSCC(NodeID rep, std::vector<const CallICFGNode*>& refCallSites,
+                             std::vector<const CallICFGNode*>& modCallSites);
+
+    /// Intern the final mod-ref sets of functions and callsites in modRefCache
+    void compactModRefs();
+
 protected:
     MRGenerator(BVDataPTAImpl* p, bool ptrOnly);
 
@@ -384,35 +411,35 @@ protected:
     /// Add indirect def an memory object in the function
     bool addModSideEffectOfCallSite(const CallICFGNode* cs, const NodeBS& mods);
 
-    /// Get indirect refs of a function
+    /// Get indirect refs of a function (once the mod-ref analysis is done)
     inline const NodeBS& getRefSideEffectOfFunction(const SVFFunction* fun)
     {
-        return funToRefsMap[fun];
+        return modRefCache.getActualPts(funToRefSummaryMap[fun]);
     }
-    /// Get indirect mods of a function
+    /// Get indirect mods of a function (once the mod-ref analysis is done)
     inline const NodeBS& getModSideEffectOfFunction(const SVFFunction* fun)
     {
-        return funToModsMap[fun];
+        return modRefCache.getActualPts(funToModSummaryMap[fun]);
     }
-    /// Get indirect refs of a callsite
+    /// Get indirect refs of a callsite (once the mod-ref analysis is done)
     inline const NodeBS& getRefSideEffectOfCallSite(const CallICFGNode* cs)
     {
-        return csToRefsMap[cs];
+        return modRefCache.getActualPts(csToRefSummaryMap[cs]);
     }
-    /// Get indirect mods of a callsite
+    /// Get indirect mods of a callsite (once the mod-ref analysis is done)
     inline const NodeBS& getModSideEffectOfCallSite(const CallICFGNode* cs)
     {
-        return csToModsMap[cs];
+        return modRefCache.getActualPts(csToModSummaryMap[cs]);
     }
     /// Has indirect refs of a callsite
     inline bool hasRefSideEffectOfCallSite(const CallICFGNode* cs)
     {
-        return csToRefsMap.find(cs) != csToRefsMap.end();
+        return csToRefSummaryMap.find(cs) != csToRefSummaryMap.end();
     }
     /// Has indirect mods of a callsite
     inline bool hasModSideEffectOfCallSite(const CallICFGNode* cs)
     {
-        return csToModsMap.find(cs) != csToModsMap.end();
+        return csToModSummaryMap.find(cs) != csToModSummaryMap.end();
     }
     //@}
 
@@ -422,6 +449,30 @@ public:
         return memRegSet.size();
     }
 
+    /// Statistics of the mod-ref analysis of callsites
+    //@{
+    inline double getModRefTime() const
+    {
+        return modRefTime;
+    }
+    /// Number of mod-ref sets of functions and callsites
+    inline u32_t getModRefSetNum() const
+    {
+        return funToRefSummaryMap.size() + funToModSummaryMap.size()
+               + csToRefSummaryMap.size() + csToModSummaryMap.size();
+    }
+    /// Number of distinct sets storing them
+    inline u32_t getUniqueModRefSetNum() const
+    {
+        return modRefCache.numOfPts();
+    }
+    /// Bytes saved by storing identical mod-ref sets once
+    inline u64_t getModRefBytesSaved() const
+    {
+        return modRefBytes > modRefCompactBytes ? modRefBytes - modRefCompactBytes : 0;
+    }
+    //@}
+
     /// Destructor
     virtual ~MRGenerator()
     {
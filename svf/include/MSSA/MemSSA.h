@@ -156,6 +156,15 @@ private:
 
     std::vector<std::unique_ptr<MRVer>> usedMRVers;
 
+    /// Whether this is a worker of buildMemSSA(funs), sharing the regions of its owner
+    bool worker;
+
+    /// Constructor of a worker
+    MemSSA(MemSSA* owner);
+
+    /// Build memory SSA for a function, adding the time of each phase to the given counters
+    void buildFunMemSSA(const SVFFunction& fun, double& muchiTime, double& phiTime, double& renameTime);
+
     /// Release the memory
     void destroy();
 
@@ -316,6 +325,8 @@ public:
     }
     /// We start from here
     virtual void buildMemSSA(const SVFFunction& fun);
+    /// Build memory SSA for all functions in funs, with -mssa-threads threads
+    void buildMemSSA(const std::vector<const SVFFunction*>& funs);
 
     /// Perform statistics
     void performStat();
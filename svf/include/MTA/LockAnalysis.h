@@ -304,6 +304,11 @@ public:
     /// echo inst may have multiple cxt stmt
     /// we check whether every cxt stmt of instructions is protected by a common lock.
     bool isProtectedByCommonLock(const ICFGNode *i1, const ICFGNode *i2);
+    /// Same as isProtectedByCommonLock, without updating the query statistics,
+    /// so that it may be called from several threads after prepareConcurrentQueries
+    bool hasCommonLock(const ICFGNode *i1, const ICFGNode *i2);
+    /// Compute the points-to sets of all lock sites ahead of concurrent hasCommonLock queries
+    void prepareConcurrentQueries();
     bool isProtectedByCommonCxtLock(const ICFGNode *i1, const ICFGNode *i2);
     bool isProtectedByCommonCxtLock(const CxtStmt& cxtStmt1, const CxtStmt& cxtStmt2);
     bool isProtectedByCommonCILock(const ICFGNode *i1, const ICFGNode *i2);
@@ -813,6 +813,26 @@ public:
         }
     }
 
+    /// Whether var has new pts in loc's IN/OUT set, i.e., whether it needs to be propagated
+    //@{
+    /// Return TRUE if var has new pts in loc's IN set
+    inline bool varHasNewDFInPts(LocID loc,const Key& var) const
+    {
+        typename UpdatedVarMap::const_iterator it = inUpdatedVarMap.find(loc);
+        if (it != inUpdatedVarMap.end())
+            return it->second.test(var);
+        return false;
+    }
+    /// Return TRUE if var has new pts in loc's OUT set
+    inline bool varHasNewDFOutPts(LocID loc,const Key& var) const
+    {
+        typename UpdatedVarMap::const_iterator it = outUpdatedVarMap.find(loc);
+        if (it != outUpdatedVarMap.end())
+            return it->second.test(var);
+        return false;
+    }
+    //@}
+
     /// Methods to support type inquiry through isa, cast, and dyn_cast:
     ///@{
     static inline bool classof(const MutableIncDFPTData<Key, KeySet, Data, DataSet> *)
@@ -840,14 +860,6 @@ private:
         if (it != inUpdatedVarMap.end())
             it->second.reset(var);
     }
-    /// Return TRUE if var has new pts in loc's IN set
-    inline bool varHasNewDFInPts(LocID loc,const Key& var)
-    {
-        UpdatedVarMapIter it = inUpdatedVarMap.find(loc);
-        if (it != inUpdatedVarMap.end())
-            return it->second.test(var);
-        return false;
-    }
     /// Get all var which have new pts information in loc's IN set
     inline const DataSet& getDFInUpdatedVar(LocID loc)
     {
@@ -869,14 +881,6 @@ private:
         if (it != outUpdatedVarMap.end())
             it->second.reset(var);
     }
-    /// Return TRUE if var has new pts in loc's OUT set
-    inline bool varHasNewDFOutPts(LocID loc,const Key& var)
-    {
-        UpdatedVarMapIter it = outUpdatedVarMap.find(loc);
-        if (it != outUpdatedVarMap.end())
-            return it->second.test(var);
-        return false;
-    }
     /// Get all var which have new pts information in loc's OUT set
     inline const DataSet& getDFOutUpdatedVar(LocID loc)
     {
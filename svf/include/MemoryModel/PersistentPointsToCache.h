@@ -14,8 +14,11 @@
 #ifndef PERSISTENT_POINTS_TO_H_
 #define PERSISTENT_POINTS_TO_H_
 
+#include <atomic>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <functional>
 
@@ -28,6 +31,13 @@ namespace SVF
 /// PointsToDS and PointsToDFDS. Hides points-to sets and union operations from users and hands
 /// out PointsToIDs.
 /// Points-to sets are interned, and union operations are lazy and hash-consed.
+///
+/// Interning, the operations, and getActualPts may be called from several threads at once.
+/// The interning table and the operation caches are split into shards, each with its own lock,
+/// and the points-to sets are stored in blocks which never move, so getActualPts takes no lock.
+/// Nothing is freed while the cache is in use: the points-to sets of an ID live until clear or
+/// reset, which (like remapAllPts, getAllPts, and printStats) must only be called when no other
+/// thread is using the cache. IDs handed out before a reset must not be used after it.
 template <typename Data>
 class PersistentPointsToCache
 {
@@ -37,29 +47,51 @@ public:
     // TODO: an unordered pair type may be better.
     typedef Map<std::pair<PointsToID, PointsToID>, PointsToID> OpCache;
 
+    /// Counters of one kind of operation. Lookups are the cache hits and unique
+    /// operations the misses; property operations are answered without the cache.
+    struct OpStats
+    {
+        std::atomic<u64_t> total;
+        std::atomic<u64_t> property;
+        std::atomic<u64_t> unique;
+        std::atomic<u64_t> lookup;
+        std::atomic<u64_t> preemptive;
+    };
+
     static PointsToID emptyPointsToId(void)
     {
         return 0;
     };
 
 public:
-    PersistentPointsToCache(void) : idCounter(1)
+    PersistentPointsToCache(void) : idCounter(0)
     {
-        idToPts.push_back(std::make_unique<Data>());
-        ptsToId[Data()] = emptyPointsToId();
+        for (std::atomic<PtsSlot*> &block : blocks) block = nullptr;
+        initEmptyPts();
 
         initStats();
     }
 
+    ~PersistentPointsToCache(void)
+    {
+        clear();
+    }
+
     /// Clear the cache.
     void clear()
     {
-        idToPts.clear();
-        ptsToId.clear();
+        for (std::atomic<PtsSlot*> &block : blocks)
+        {
+            delete[] block.load(std::memory_order_relaxed);
+            block = nullptr;
+        }
+        idCounter = 0;
+
+        for (PtsShard &shard : ptsShards) shard.ptsToId.clear();
 
-        unionCache.clear();
-        complementCache.clear();
-        intersectionCache.clear();
+        for (OpShard &shard : unionCache) shard.cache.clear();
+        for (OpShard &shard : complementCache) shard.cache.clear();
+        for (OpShard &shard : intersectionCache) shard.cache.clear();
     }
 
     /// Resets the cache removing everything except the emptyData it was initialised with.
@@ -68,10 +100,8 @@ public:
         clear();
 
         // Put the empty data back in.
-        ptsToId[Data()] = emptyPointsToId();
-        idToPts.push_back(std::make_unique<Data>());
+        initEmptyPts();
 
-        idCounter = 1;
         // Cache is empty...
         initStats();
     }
@@ -79,25 +109,32 @@ public:
     /// Remaps all points-to sets stored in the cache to the current mapping.
     void remapAllPts(void)
     {
-        for (auto &d : idToPts) d->checkAndRemap();
+        for (PtsShard &shard : ptsShards) shard.ptsToId.clear();
 
         // Rebuild ptsToId from idToPts.
-        ptsToId.clear();
-        for (PointsToID i = 0; i < idToPts.size(); ++i) ptsToId[*idToPts[i]] = i;
+        for (PointsToID i = 0; i < numOfPts(); ++i)
+        {
+            Data &pts = *getSlot(i);
+            pts.checkAndRemap();
+            getPtsShard(pts).ptsToId[pts] = i;
+        }
     }
 
     /// If pts is not in the PersistentPointsToCache, inserts it, assigns an ID, and returns
     /// that ID. If it is, then the ID is returned.
     PointsToID emplacePts(const Data &pts)
     {
+        PtsShard &shard = getPtsShard(pts);
+        std::lock_guard<std::mutex> guard(shard.lock);
+
         // Is it already in the cache?
-        typename PTSToIDMap::const_iterator foundId = ptsToId.find(pts);
-        if (foundId != ptsToId.end()) return foundId->second;
+        typename PTSToIDMap::const_iterator foundId = shard.ptsToId.find(pts);
+        if (foundId != shard.ptsToId.end()) return foundId->second;
 
-        // Otherwise, insert it.
+        // Otherwise, insert it. The set is stored before its ID is published through the shard.
         PointsToID id = newPointsToId();
-        idToPts.push_back(std::make_unique<Data>(pts));
-        ptsToId[pts] = id;
+        getSlot(id) = std::make_unique<Data>(pts);
+        shard.ptsToId[pts] = id;
 
         return id;
     }
@@ -106,8 +143,8 @@ public:
     const Data &getActualPts(PointsToID id) const
     {
         // Check if the points-to set for ID has already been stored.
-        assert(idToPts.size() > id && "PPTC::getActualPts: points-to set not stored!");
-        return *idToPts.at(id);
+        assert(numOfPts() > id && "PPTC::getActualPts: points-to set not stored!");
+        return *getSlot(id);
     }
 
     /// Unions lhs and rhs and returns their union's ID.
@@ -118,7 +155,7 @@ public:
             return lhs | rhs;
         };
 
-        ++totalUnions;
+        ++unionStats.total;
 
         // Order operands so we don't perform x U y and y U x separately.
         std::pair<PointsToID, PointsToID> operands = std::minmax(lhs, rhs);
@@ -127,14 +164,14 @@ public:
         // EMPTY_SET U x
         if (operands.first == emptyPointsToId())
         {
-            ++propertyUnions;
+            ++unionStats.property;
             return operands.second;
         }
 
         // x U x
         if (operands.first == operands.second)
         {
-            ++propertyUnions;
+            ++unionStats.property;
             return operands.first;
         }
 
@@ -143,7 +180,7 @@ public:
 
         if (opPerformed)
         {
-            ++uniqueUnions;
+            ++unionStats.unique;
 
             // We can use lhs/rhs here rather than our ordered operands,
             // because the operation was commutative.
@@ -151,20 +188,20 @@ public:
             // if x U y = z, then x U z = z,
             if (lhs != result)
             {
-                unionCache[std::minmax(lhs, result)] = result;
-                ++preemptiveUnions;
-                ++totalUnions;
+                cacheResult(unionCache, std::minmax(lhs, result), result);
+                ++unionStats.preemptive;
+                ++unionStats.total;
             }
 
             // and y U z = z.
             if (rhs != result)
             {
-                unionCache[std::minmax(rhs, result)] = result;
-                ++preemptiveUnions;
-                ++totalUnions;
+                cacheResult(unionCache, std::minmax(rhs, result), result);
+                ++unionStats.preemptive;
+                ++unionStats.total;
             }
         }
-        else ++lookupUnions;
+        else ++unionStats.lookup;
 
         return result;
     }
@@ -177,27 +214,27 @@ public:
             return lhs - rhs;
         };
 
-        ++totalComplements;
+        ++complementStats.total;
 
         // Property cases.
         // x - x
         if (lhs == rhs)
         {
-            ++propertyComplements;
+            ++complementStats.property;
             return emptyPointsToId();
         }
 
         // x - EMPTY_SET
         if (rhs == emptyPointsToId())
         {
-            ++propertyComplements;
+            ++complementStats.property;
             return lhs;
         }
 
         // EMPTY_SET - x
         if (lhs == emptyPointsToId())
         {
-            ++propertyComplements;
+            ++complementStats.property;
             return emptyPointsToId();
         }
 
@@ -206,28 +243,28 @@ public:
 
         if (opPerformed)
         {
-            ++uniqueComplements;
+            ++complementStats.unique;
 
             // We performed lhs - rhs = result, so...
             if (result != emptyPointsToId())
             {
                 // result AND rhs = EMPTY_SET,
-                intersectionCache[std::minmax(result, rhs)] = emptyPointsToId();
-                ++preemptiveIntersections;
-                ++totalIntersections;
+                cacheResult(intersectionCache, std::minmax(result, rhs), emptyPointsToId());
+                ++intersectionStats.preemptive;
+                ++intersectionStats.total;
 
                 // and result AND lhs = result,
-                intersectionCache[std::minmax(result, lhs)] = result;
-                ++preemptiveIntersections;
-                ++totalIntersections;
+                cacheResult(intersectionCache, std::minmax(result, lhs), result);
+                ++intersectionStats.preemptive;
+                ++intersectionStats.total;
 
                 // and result - rhs = result.
-                complementCache[std::make_pair(result, rhs)] = result;
-                ++preemptiveComplements;
-                ++totalComplements;
+                cacheResult(complementCache, std::make_pair(result, rhs), result);
+                ++complementStats.preemptive;
+                ++complementStats.total;
             }
         }
-        else ++lookupComplements;
+        else ++complementStats.lookup;
 
         return result;
     }
@@ -240,7 +277,7 @@ public:
             return lhs & rhs;
         };
 
-        ++totalIntersections;
+        ++intersectionStats.total;
 
         // Order operands so we don't perform x U y and y U x separately.
         std::pair<PointsToID, PointsToID> operands = std::minmax(lhs, rhs);
@@ -249,14 +286,14 @@ public:
         // EMPTY_SET & x
         if (operands.first == emptyPointsToId())
         {
-            ++propertyIntersections;
+            ++intersectionStats.property;
             return emptyPointsToId();
         }
 
         // x & x
         if (operands.first == operands.second)
         {
-            ++propertyIntersections;
+            ++intersectionStats.property;
             return operands.first;
         }
 
@@ -264,7 +301,7 @@ public:
         const PointsToID result = opPts(lhs, rhs, intersectionOp, intersectionCache, true, opPerformed);
         if (opPerformed)
         {
-            ++uniqueIntersections;
+            ++intersectionStats.unique;
 
             // When the result is empty, we won't be adding anything of substance.
             if (result != emptyPointsToId())
@@ -273,67 +310,89 @@ public:
                 // result AND rhs = result,
                 if (result != rhs)
                 {
-                    intersectionCache[std::minmax(result, rhs)] = result;
-                    ++preemptiveIntersections;
-                    ++totalIntersections;
+                    cacheResult(intersectionCache, std::minmax(result, rhs), result);
+                    ++intersectionStats.preemptive;
+                    ++intersectionStats.total;
                 }
 
                 // and result AND lhs = result,
                 if (result != lhs)
                 {
-                    intersectionCache[std::minmax(result, lhs)] = result;
-                    ++preemptiveIntersections;
-                    ++totalIntersections;
+                    cacheResult(intersectionCache, std::minmax(result, lhs), result);
+                    ++intersectionStats.preemptive;
+                    ++intersectionStats.total;
                 }
 
                 // Also (thanks reviewer #2)
                 // result U lhs = result,
                 if (result != emptyPointsToId() && result != lhs)
                 {
-                    unionCache[std::minmax(lhs, result)] = lhs;
-                    ++preemptiveUnions;
-                    ++totalUnions;
+                    cacheResult(unionCache, std::minmax(lhs, result), lhs);
+                    ++unionStats.preemptive;
+                    ++unionStats.total;
                 }
 
                 // And result U rhs = rhs.
                 if (result != emptyPointsToId() && result != rhs)
                 {
-                    unionCache[std::minmax(rhs, result)] = rhs;
-                    ++preemptiveUnions;
-                    ++totalUnions;
+                    cacheResult(unionCache, std::minmax(rhs, result), rhs);
+                    ++unionStats.preemptive;
+                    ++unionStats.total;
                 }
             }
         }
-        else ++lookupIntersections;
+        else ++intersectionStats.lookup;
 
         return result;
     }
 
+    /// Number of points-to sets stored (and of IDs handed out)
+    inline PointsToID numOfPts(void) const
+    {
+        return idCounter.load(std::memory_order_acquire);
+    }
+
+    /// Operation counters
+    ///@{
+    inline const OpStats &getUnionStats(void) const
+    {
+        return unionStats;
+    }
+    inline const OpStats &getComplementStats(void) const
+    {
+        return complementStats;
+    }
+    inline const OpStats &getIntersectionStats(void) const
+    {
+        return intersectionStats;
+    }
+    ///@}
+
     /// Print statistics on operations and points-to set numbers.
     void printStats(const std::string subtitle) const
     {
         static const unsigned fieldWidth = 25;
         SVFUtil::outs().flags(std::ios::left);
 
-        SVFUtil::outs() << std::setw(fieldWidth) << "UniquePointsToSets"      << idToPts.size()          << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "UniquePointsToSets"      << numOfPts()                  << "\n";
 
-        SVFUtil::outs() << std::setw(fieldWidth) << "TotalUnions"             << totalUnions             << "\n";
-        SVFUtil::outs() << std::setw(fieldWidth) << "PropertyUnions"          << propertyUnions          << "\n";
-        SVFUtil::outs() << std::setw(fieldWidth) << "UniqueUnions"            << uniqueUnions            << "\n";
-        SVFUtil::outs() << std::setw(fieldWidth) << "LookupUnions"            << lookupUnions            << "\n";
-        SVFUtil::outs() << std::setw(fieldWidth) << "PreemptiveUnions"        << preemptiveUnions        << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "TotalUnions"             << unionStats.total             << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "PropertyUnions"          << unionStats.property          << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "UniqueUnions"            << unionStats.unique            << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "LookupUnions"            << unionStats.lookup            << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "PreemptiveUnions"        << unionStats.preemptive        << "\n";
 
-        SVFUtil::outs() << std::setw(fieldWidth) << "TotalComplements"        << totalComplements        << "\n";
-        SVFUtil::outs() << std::setw(fieldWidth) << "PropertyComplements"     << propertyComplements     << "\n";
-        SVFUtil::outs() << std::setw(fieldWidth) << "UniqueComplements"       << uniqueComplements       << "\n";
-        SVFUtil::outs() << std::setw(fieldWidth) << "LookupComplements"       << lookupComplements       << "\n";
-        SVFUtil::outs() << std::setw(fieldWidth) << "PreemptiveComplements"   << preemptiveComplements   << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "TotalComplements"        << complementStats.total        << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "PropertyComplements"     << complementStats.property     << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "UniqueComplements"       << complementStats.unique       << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "LookupComplements"       << complementStats.lookup       << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "PreemptiveComplements"   << complementStats.preemptive   << "\n";
 
-        SVFUtil::outs() << std::setw(fieldWidth) << "TotalIntersections"      << totalIntersections      << "\n";
-        SVFUtil::outs() << std::setw(fieldWidth) << "PropertyIntersections"   << propertyIntersections   << "\n";
-        SVFUtil::outs() << std::setw(fieldWidth) << "UniqueIntersections"     << uniqueIntersections     << "\n";
-        SVFUtil::outs() << std::setw(fieldWidth) << "LookupIntersections"     << lookupIntersections     << "\n";
-        SVFUtil::outs() << std::setw(fieldWidth) << "PreemptiveIntersections" << preemptiveIntersections << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "TotalIntersections"      << intersectionStats.total      << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "PropertyIntersections"   << intersectionStats.property   << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "UniqueIntersections"     << intersectionStats.unique     << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "LookupIntersections"     << intersectionStats.lookup     << "\n";
+        SVFUtil::outs() << std::setw(fieldWidth) << "PreemptiveIntersections" << intersectionStats.preemptive << "\n";
 
         SVFUtil::outs().flush();
     }
@@ -345,24 +404,107 @@ public:
     Map<Data, unsigned> getAllPts(void)
     {
         Map<Data, unsigned> allPts;
-        for (const auto &d : idToPts) allPts[*d] = 1;
+        for (PointsToID i = 0; i < numOfPts(); ++i) allPts[*getSlot(i)] = 1;
         return allPts;
     }
 
     // TODO: ref count API for garbage collection.
 
 private:
+    typedef std::unique_ptr<Data> PtsSlot;
+
+    /// The interning table and each operation cache have 2^ShardBits shards.
+    static const u32_t ShardBits = 6;
+    static const u32_t NumOfShards = 1u << ShardBits;
+    /// Block 0 of idToPts holds 2^FirstBlockBits points-to sets; each block
+    /// after it is twice as large as the previous one.
+    static const u32_t FirstBlockBits = 10;
+    /// Enough blocks for every PointsToID.
+    static const u32_t NumOfBlocks = sizeof(PointsToID) * 8 - FirstBlockBits + 1;
+
+    /// The shards are aligned to cache lines so that threads locking
+    /// different shards do not contend for the same line.
+    struct alignas(64) PtsShard
+    {
+        std::mutex lock;
+        PTSToIDMap ptsToId;
+    };
+    struct alignas(64) OpShard
+    {
+        std::mutex lock;
+        OpCache cache;
+    };
+
+    /// Store the empty set as emptyPointsToId().
+    void initEmptyPts(void)
+    {
+        getSlot(emptyPointsToId()) = std::make_unique<Data>();
+        getPtsShard(Data()).ptsToId[Data()] = emptyPointsToId();
+        idCounter = emptyPointsToId() + 1;
+    }
+
     PointsToID newPointsToId(void)
     {
+        // Threads interning into different shards allocate IDs concurrently.
+        PointsToID id = idCounter.fetch_add(1, std::memory_order_acq_rel);
         // Make sure we don't overflow.
-        assert(idCounter != emptyPointsToId() && "PPTC::newPointsToId: PointsToIDs exhausted! Try a larger type.");
-        return idCounter++;
+        assert(id != emptyPointsToId() && "PPTC::newPointsToId: PointsToIDs exhausted! Try a larger type.");
+        return id;
+    }
+
+    /// The slot of idToPts which holds the points-to set of id, allocating its block if needed.
+    inline PtsSlot &getSlot(PointsToID id) const
+    {
+        // IDs are offset by the size of block 0 so that the position of the top bit gives the block.
+        u64_t offsetId = (u64_t) id + (1u << FirstBlockBits);
+        u32_t topBit = 63 - __builtin_clzll(offsetId);
+        u32_t blockIdx = topBit - FirstBlockBits;
+        PtsSlot *block = blocks[blockIdx].load(std::memory_order_acquire);
+        if (block == nullptr) block = allocBlock(blockIdx);
+        return block[offsetId - ((u64_t) 1 << topBit)];
+    }
+
+    /// Allocate block blockIdx of idToPts unless another thread did it already.
+    PtsSlot *allocBlock(u32_t blockIdx) const
+    {
+        std::lock_guard<std::mutex> guard(blocksLock);
+        PtsSlot *block = blocks[blockIdx].load(std::memory_order_acquire);
+        if (block == nullptr)
+        {
+            block = new PtsSlot[(u64_t) 1 << (blockIdx + FirstBlockBits)];
+            blocks[blockIdx].store(block, std::memory_order_release);
+        }
+        return block;
+    }
+
+    /// Fibonacci hashing: the top bits of the product depend on all bits of key.
+    inline static u32_t getShardIdx(u64_t key)
+    {
+        return (key * 0x9E3779B97F4A7C15ULL) >> (64 - ShardBits);
+    }
+
+    inline PtsShard &getPtsShard(const Data &pts)
+    {
+        return ptsShards[getShardIdx(typename PTSToIDMap::hasher()(pts))];
+    }
+
+    inline static OpShard &getOpShard(OpShard *opCache, const std::pair<PointsToID, PointsToID> &operands)
+    {
+        return opCache[getShardIdx(((u64_t) operands.first << 32) | operands.second)];
+    }
+
+    /// Record that performing the operation of opCache on operands gives result.
+    inline static void cacheResult(OpShard *opCache, const std::pair<PointsToID, PointsToID> &operands, PointsToID result)
+    {
+        OpShard &shard = getOpShard(opCache, operands);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        shard.cache[operands] = result;
     }
 
     /// Performs dataOp on lhs and rhs, checking the opCache first and updating it afterwards.
     /// commutative indicates whether the operation in question is commutative or not.
     /// opPerformed is set to true if the operation was *not* cached and thus performed, false otherwise.
-    inline PointsToID opPts(PointsToID lhs, PointsToID rhs, const DataOp &dataOp, OpCache &opCache,
+    inline PointsToID opPts(PointsToID lhs, PointsToID rhs, const DataOp &dataOp, OpShard *opCache,
                             bool commutative, bool &opPerformed)
     {
         std::pair<PointsToID, PointsToID> operands;
@@ -372,29 +514,30 @@ private:
         else operands = std::make_pair(lhs, rhs);
 
         // Check if we have performed this operation
-        OpCache::const_iterator foundResult = opCache.find(operands);
-        if (foundResult != opCache.end()) return foundResult->second;
+        OpShard &shard = getOpShard(opCache, operands);
+        {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            OpCache::const_iterator foundResult = shard.cache.find(operands);
+            if (foundResult != shard.cache.end()) return foundResult->second;
+        }
 
         opPerformed = true;
 
+        // The operation is performed without holding any lock. Threads which race
+        // on the same operands intern the same result, so they cache the same ID.
         const Data &lhsPts = getActualPts(lhs);
         const Data &rhsPts = getActualPts(rhs);
 
         Data result = dataOp(lhsPts, rhsPts);
 
-        PointsToID resultId;
         // Intern points-to set: check if result already exists.
-        typename PTSToIDMap::const_iterator foundId = ptsToId.find(result);
-        if (foundId != ptsToId.end()) resultId = foundId->second;
-        else
-        {
-            resultId = newPointsToId();
-            idToPts.push_back(std::make_unique<Data>(result));
-            ptsToId[result] = resultId;
-        }
+        PointsToID resultId = emplacePts(result);
 
         // Cache the result, for hash-consing.
-        opCache[operands] = resultId;
+        {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            shard.cache[operands] = resultId;
+        }
 
         return resultId;
     }
@@ -402,60 +545,43 @@ private:
     /// Initialises statistics variables to 0.
     inline void initStats(void)
     {
-
-        totalUnions              = 0;
-        uniqueUnions             = 0;
-        propertyUnions           = 0;
-        lookupUnions             = 0;
-        preemptiveUnions         = 0;
-        totalComplements         = 0;
-        uniqueComplements        = 0;
-        propertyComplements      = 0;
-        lookupComplements        = 0;
-        preemptiveComplements    = 0;
-        totalIntersections       = 0;
-        uniqueIntersections      = 0;
-        propertyIntersections    = 0;
-        lookupIntersections      = 0;
-        preemptiveIntersections  = 0;
+        for (OpStats *stats : { &unionStats, &complementStats, &intersectionStats })
+        {
+            stats->total      = 0;
+            stats->property   = 0;
+            stats->unique     = 0;
+            stats->lookup     = 0;
+            stats->preemptive = 0;
+        }
     }
 
 private:
-    /// Maps points-to IDs (indices) to their corresponding points-to set.
-    /// Reverse of idToPts.
-    /// Elements are only added through push_back, so the number of elements
-    /// stored is the size of the vector.
+    /// Maps points-to IDs to their corresponding points-to set.
+    /// Reverse of ptsToId.
+    /// ID i is stored in block b at index i + 2^FirstBlockBits - 2^(b + FirstBlockBits),
+    /// where b + FirstBlockBits is the top bit of i + 2^FirstBlockBits. Blocks are only
+    /// allocated, never moved, so references to stored sets stay valid until clear.
     /// Not const so we can remap.
-    std::vector<std::unique_ptr<Data>> idToPts;
-    /// Maps points-to sets to their corresponding ID.
-    PTSToIDMap ptsToId;
+    mutable std::atomic<PtsSlot*> blocks[NumOfBlocks];
+    /// Serialises the allocation of blocks.
+    mutable std::mutex blocksLock;
+    /// Maps points-to sets to their corresponding ID, split by the hash of the set.
+    PtsShard ptsShards[NumOfShards];
 
     /// Maps two IDs to their union. Keys must be sorted.
-    OpCache unionCache;
+    OpShard unionCache[NumOfShards];
     /// Maps two IDs to their relative complement.
-    OpCache complementCache;
+    OpShard complementCache[NumOfShards];
     /// Maps two IDs to their intersection. Keys must be sorted.
-    OpCache intersectionCache;
+    OpShard intersectionCache[NumOfShards];
 
-    /// Used to generate new PointsToIDs. Any non-zero is valid.
-    PointsToID idCounter;
+    /// Used to generate new PointsToIDs. Also the number of points-to sets stored.
+    std::atomic<PointsToID> idCounter;
 
     // Statistics:
-    u64_t totalUnions;
-    u64_t uniqueUnions;
-    u64_t propertyUnions;
-    u64_t lookupUnions;
-    u64_t preemptiveUnions;
-    u64_t totalComplements;
-    u64_t uniqueComplements;
-    u64_t propertyComplements;
-    u64_t lookupComplements;
-    u64_t preemptiveComplements;
-    u64_t totalIntersections;
-    u64_t uniqueIntersections;
-    u64_t propertyIntersections;
-    u64_t lookupIntersections;
-    u64_t preemptiveIntersections;
+    OpStats unionStats;
+    OpStats complementStats;
+    OpStats intersectionStats;
 };
 
 } // End namespace SVF
@@ -58,7 +58,7 @@ public:
 
     inline const DataSet& getPts(const Key &var) override
     {
-        PointsToID id = ptsMap[var];
+        PointsToID id = getPtsIdRef(var);
         return ptCache.getActualPts(id);
     }
 
@@ -78,7 +78,7 @@ public:
 
     inline bool unionPts(const Key& dstKey, const Key& srcKey) override
     {
-        PointsToID srcId = ptsMap[srcKey];
+        PointsToID srcId = getPtsIdRef(srcKey);
         return unionPtsFromId(dstKey, srcId);
     }
 
@@ -97,11 +97,11 @@ public:
         DataSet toRemoveData;
         toRemoveData.set(element);
         PointsToID toRemoveId = ptCache.emplacePts(toRemoveData);
-        PointsToID varId = ptsMap[var];
+        PointsToID &varId = getPtsIdRef(var);
         PointsToID complementId = ptCache.complementPts(varId, toRemoveId);
         if (varId != complementId)
         {
-            ptsMap[var] = complementId;
+            varId = complementId;
             clearSingleRevPts(revPtsMap[element], var);
         }
     }
@@ -109,7 +109,7 @@ public:
     void clearFullPts(const Key& var) override
     {
         clearRevPts(getPts(var), var);
-        ptsMap[var] = PersistentPointsToCache<DataSet>::emptyPointsToId();
+        getPtsIdRef(var) = PersistentPointsToCache<DataSet>::emptyPointsToId();
     }
 
     void remapAllPts() override
@@ -135,6 +135,14 @@ public:
         return allPts;
     }
 
+    /// Create the (empty) points-to set of var if it has none. Once var has an entry,
+    /// reading or updating it does not insert into the map shared by all variables,
+    /// so different variables may then be updated by different threads.
+    inline void initPts(const Key &var)
+    {
+        getPtsIdRef(var);
+    }
+
     /// Methods to support type inquiry through isa, cast, and dyn_cast:
     ///@{
     static inline bool classof(const PersistentPTData<Key, KeySet, Data, DataSet> *)
@@ -153,13 +161,13 @@ private:
     /// Renamed because PointsToID and Key may be the same type...
     inline bool unionPtsFromId(const Key &dstKey, PointsToID srcId)
     {
-        PointsToID dstId = ptsMap[dstKey];
+        PointsToID &dstId = getPtsIdRef(dstKey);
         PointsToID newDstId = ptCache.unionPts(dstId, srcId);
 
         bool changed = newDstId != dstId;
         if (changed)
         {
-            ptsMap[dstKey] = newDstId;
+            dstId = newDstId;
 
             // Reverse points-to only needs to be handled when dst's
             // points-to set has changed (i.e., do it the first time only).
@@ -189,6 +197,14 @@ private:
         }
     }
 
+    /// The points-to set ID of var, which is only inserted (as the empty set) if var has none.
+    inline PointsToID &getPtsIdRef(const Key &var)
+    {
+        typename KeyToIDMap::iterator it = ptsMap.find(var);
+        if (it != ptsMap.end()) return it->second;
+        return ptsMap[var];
+    }
+
 protected:
     PersistentPointsToCache<DataSet> &ptCache;
     KeyToIDMap ptsMap;
@@ -429,13 +445,13 @@ public:
 
     const DataSet &getDFInPtsSet(LocID loc, const Key& var) override
     {
-        PointsToID id = dfInPtsMap[loc][var];
+        PointsToID id = getDFInPtIdRef(loc, var);
         return ptCache.getActualPts(id);
     }
 
     const DataSet &getDFOutPtsSet(LocID loc, const Key& var) override
     {
-        PointsToID id = dfOutPtsMap[loc][var];
+        PointsToID id = getDFOutPtIdRef(loc, var);
         return ptCache.getActualPts(id);
     }
 
@@ -469,7 +485,7 @@ public:
         bool changed = false;
         if (this->hasDFInSet(loc))
         {
-            const KeyToIDMap &inKeyToId = dfInPtsMap[loc];
+            const KeyToIDMap &inKeyToId = getDFInMap(loc);
             for (const typename KeyToIDMap::value_type &ki : inKeyToId)
             {
                 const Key var = ki.first;
@@ -490,12 +506,12 @@ public:
     /// Update points-to set of top-level pointers with IN[srcLoc:srcVar].
     bool updateTLVPts(LocID srcLoc, const Key &srcVar, const Key &dstVar) override
     {
-        return unionPtsThroughIds(persPTData.ptsMap[dstVar], getDFInPtIdRef(srcLoc, srcVar));
+        return unionPtsThroughIds(persPTData.getPtsIdRef(dstVar), getDFInPtIdRef(srcLoc, srcVar));
     }
 
     bool updateATVPts(const Key& srcVar, LocID dstLoc, const Key& dstVar) override
     {
-        return unionPtsThroughIds(getDFOutPtIdRef(dstLoc, dstVar), persPTData.ptsMap[srcVar]);
+        return unionPtsThroughIds(getDFOutPtIdRef(dstLoc, dstVar), persPTData.getPtsIdRef(srcVar));
     }
 
     Map<DataSet, unsigned> getAllPts(bool liveOnly) const override
@@ -531,6 +547,22 @@ public:
         return allPts;
     }
 
+    /// Create the (empty) points-to set of the top-level variable var if it has none.
+    inline void initPts(const Key &var)
+    {
+        persPTData.initPts(var);
+    }
+
+    /// Create the (empty) IN and OUT sets of loc if it has none. Once every location
+    /// and top-level variable has been initialised, an update only modifies the sets
+    /// of its own location or variable: updates of different locations and variables
+    /// may then run in different threads.
+    virtual void initDFLoc(LocID loc)
+    {
+        getDFInMap(loc);
+        getDFOutMap(loc);
+    }
+
     /// Methods to support type inquiry through isa, cast, and dyn_cast:
     ///@{
     static inline bool classof(const PersistentDFPTData<Key, KeySet, Data, DataSet> *)
@@ -555,14 +587,31 @@ protected:
 
     PointsToID &getDFInPtIdRef(LocID loc, const Key &var)
     {
-        return dfInPtsMap[loc][var];
+        return getDFInMap(loc)[var];
     }
 
     PointsToID &getDFOutPtIdRef(LocID loc, const Key &var)
     {
-        return dfOutPtsMap[loc][var];
+        return getDFOutMap(loc)[var];
+    }
+
+    /// The IN/OUT sets of loc, which are only inserted if loc has none.
+    ///@{
+    KeyToIDMap &getDFInMap(LocID loc)
+    {
+        typename DFKeyToIDMap::iterator it = dfInPtsMap.find(loc);
+        if (it != dfInPtsMap.end()) return it->second;
+        return dfInPtsMap[loc];
     }
 
+    KeyToIDMap &getDFOutMap(LocID loc)
+    {
+        typename DFKeyToIDMap::iterator it = dfOutPtsMap.find(loc);
+        if (it != dfOutPtsMap.end()) return it->second;
+        return dfOutPtsMap[loc];
+    }
+    ///@}
+
 protected:
     PersistentPointsToCache<DataSet> &ptCache;
 
@@ -680,7 +729,7 @@ public:
         if (varHasNewDFInPts(srcLoc, srcVar))
         {
             removeVarFromDFInUpdatedSet(srcLoc, srcVar);
-            return this->unionPtsThroughIds(this->persPTData.ptsMap[dstVar], this->getDFInPtIdRef(srcLoc, srcVar));
+            return this->unionPtsThroughIds(this->persPTData.getPtsIdRef(dstVar), this->getDFInPtIdRef(srcLoc, srcVar));
         }
 
         return false;
@@ -688,7 +737,7 @@ public:
 
     inline bool updateATVPts(const Key& srcVar, LocID dstLoc, const Key& dstVar) override
     {
-        if (this->unionPtsThroughIds(this->getDFOutPtIdRef(dstLoc, dstVar), this->persPTData.ptsMap[srcVar]))
+        if (this->unionPtsThroughIds(this->getDFOutPtIdRef(dstLoc, dstVar), this->persPTData.getPtsIdRef(srcVar)))
         {
             setVarDFOutSetUpdated(dstLoc, dstVar);
             return true;
@@ -716,6 +765,32 @@ public:
         BasePersDFPTData::clear();
     }
 
+    /// Also create the (empty) updated-variable sets of loc.
+    void initDFLoc(LocID loc) override
+    {
+        BasePersDFPTData::initDFLoc(loc);
+        getUpdatedVars(inUpdatedVarMap, loc);
+        getUpdatedVars(outUpdatedVarMap, loc);
+    }
+
+    /// Whether var has new pts in loc's IN/OUT set, i.e., whether it needs to be propagated
+    ///@{
+    /// Return TRUE if var has a new pts in loc's IN set
+    inline bool varHasNewDFInPts(LocID loc, const Key& var) const
+    {
+        typename UpdatedVarMap::const_iterator it = inUpdatedVarMap.find(loc);
+        if (it != inUpdatedVarMap.end()) return it->second.find(var) != it->second.end();
+        return false;
+    }
+    /// Return TRUE if var has a new pts in loc's OUT set.
+    inline bool varHasNewDFOutPts(LocID loc, const Key& var) const
+    {
+        typename UpdatedVarMap::const_iterator it = outUpdatedVarMap.find(loc);
+        if (it != outUpdatedVarMap.end()) return it->second.find(var) != it->second.end();
+        return false;
+    }
+    ///@}
+
     /// Methods to support type inquiry through isa, cast, and dyn_cast:
     ///@{
     static inline bool classof(const PersistentIncDFPTData<Key, KeySet, Data, DataSet> *)
@@ -736,7 +811,7 @@ private:
     /// Add var into loc's IN updated set. Called when var's pts in loc's IN set is changed.
     inline void setVarDFInSetUpdated(LocID loc, const Key& var)
     {
-        SVFUtil::insertKey(var, inUpdatedVarMap[loc]);
+        SVFUtil::insertKey(var, getUpdatedVars(inUpdatedVarMap, loc));
     }
 
     /// Remove var from loc's IN updated set.
@@ -746,18 +821,10 @@ private:
         if (it != inUpdatedVarMap.end()) it->second.erase(var);
     }
 
-    /// Return TRUE if var has a new pts in loc's IN set
-    inline bool varHasNewDFInPts(LocID loc, const Key& var)
-    {
-        typename UpdatedVarMap::iterator it = inUpdatedVarMap.find(loc);
-        if (it != inUpdatedVarMap.end()) return it->second.find(var) != it->second.end();
-        return false;
-    }
-
     /// Get all variables which have new pts information in loc's IN set
     inline const KeySet& getDFInUpdatedVar(LocID loc)
     {
-        return inUpdatedVarMap[loc];
+        return getUpdatedVars(inUpdatedVarMap, loc);
     }
     ///@}
 
@@ -766,7 +833,7 @@ private:
     /// Add var into loc's OUT updated set. Called when var's pts in loc's OUT set changed
     inline void setVarDFOutSetUpdated(LocID loc, const Key& var)
     {
-        SVFUtil::insertKey(var, outUpdatedVarMap[loc]);
+        SVFUtil::insertKey(var, getUpdatedVars(outUpdatedVarMap, loc));
     }
 
     /// Remove var from loc's OUT updated set.
@@ -776,21 +843,21 @@ private:
         if (it != outUpdatedVarMap.end()) it->second.erase(var);
     }
 
-    /// Return TRUE if var has a new pts in loc's OUT set.
-    inline bool varHasNewDFOutPts(LocID loc, const Key& var)
-    {
-        typename UpdatedVarMap::iterator it = outUpdatedVarMap.find(loc);
-        if (it != outUpdatedVarMap.end()) return it->second.find(var) != it->second.end();
-        return false;
-    }
-
     /// Get all variables which have new pts info in loc's OUT set
     inline const KeySet& getDFOutUpdatedVar(LocID loc)
     {
-        return outUpdatedVarMap[loc];
+        return getUpdatedVars(outUpdatedVarMap, loc);
     }
     ///@}
 
+    /// The updated-variable set of loc in varMap, which is only inserted if loc has none.
+    inline KeySet& getUpdatedVars(UpdatedVarMap& varMap, LocID loc)
+    {
+        typename UpdatedVarMap::iterator it = varMap.find(loc);
+        if (it != varMap.end()) return it->second;
+        return varMap[loc];
+    }
+
 
 private:
     UpdatedVarMap outUpdatedVarMap;
@@ -832,6 +899,36 @@ public:
         return atPTData.getPts(vk);
     }
 
+    /// Returns the ID of the points-to set of vk without creating an entry for it.
+    /// May be called from several threads while the address-taken sets are not written.
+    PointsToID getPtsId(const VersionedKey& vk) const
+    {
+        typename VersionedKeyToIDMap::const_iterator foundId = atPTData.ptsMap.find(vk);
+        return foundId == atPTData.ptsMap.end() ? PersistentPointsToCache<DataSet>::emptyPointsToId() : foundId->second;
+    }
+    /// Top-level analogue of getPtsId(const VersionedKey&).
+    PointsToID getPtsId(const Key& k) const
+    {
+        typename KeyToIDMap::const_iterator foundId = tlPTData.ptsMap.find(k);
+        return foundId == tlPTData.ptsMap.end() ? PersistentPointsToCache<DataSet>::emptyPointsToId() : foundId->second;
+    }
+
+    /// Returns the ID of the union of two points-to sets. Thread-safe (see PersistentPointsToCache).
+    PointsToID unionPtsIds(PointsToID lhs, PointsToID rhs)
+    {
+        return atPTData.ptCache.unionPts(lhs, rhs);
+    }
+
+    /// Unions the points-to set with ID srcId into that of dstVar.
+    bool unionPtsFromId(const VersionedKey& dstVar, PointsToID srcId)
+    {
+        return atPTData.unionPtsFromId(dstVar, srcId);
+    }
+    bool unionPtsFromId(const Key& dstVar, PointsToID srcId)
+    {
+        return tlPTData.unionPtsFromId(dstVar, srcId);
+    }
+
     const KeySet& getRevPts(const Data &data) override
     {
         assert(this->rev && "PersistentVersionedPTData::getRevPts: constructed without reverse PT support!");
@@ -155,6 +155,9 @@ protected:
     ICFG* icfg;
     /// CHGraph
     CommonCHGraph *chgraph;
+    /// Arena of the sparse bit-vector elements allocated while this analysis is
+    /// the latest one alive (-sbv-arena)
+    SparseBitVectorArena* sbvArena;
 
 public:
     /// Get ICFG
@@ -232,6 +235,14 @@ public:
     /// Compute points-to results on-demand, overridden by derived classes
     virtual void computeDDAPts(NodeID) {}
 
+    /// Compute points-to results of a batch of queries on-demand. Derived classes
+    /// may reorder the queries so that later ones reuse the results of earlier ones.
+    virtual void computeDDAPtsInBatch(const OrderedNodeSet& ids)
+    {
+        for (NodeID id : ids)
+            computeDDAPts(id);
+    }
+
     /// Interface exposed to users of our pointer analysis, given Value infos
     virtual AliasResult alias(const SVFVar* V1,
                               const SVFVar* V2) = 0;
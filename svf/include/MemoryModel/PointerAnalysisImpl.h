@@ -32,6 +32,7 @@
 
 #include <Graphs/ConsG.h>
 #include "MemoryModel/PointerAnalysis.h"
+#include "MemoryModel/PointsToFile.h"
 
 namespace SVF
 {
@@ -138,16 +139,17 @@ public:
     /// Remap all points-to sets to use the current mapping.
     void remapPointsToSets(void);
 
-    /// Interface for analysis result storage on filesystem.
+    /// Interface for analysis result storage on filesystem (see PointsToFile.h).
     //@{
     virtual void writeToFile(const std::string& filename);
     virtual void writeObjVarToFile(const std::string& filename);
-    virtual void writePtsResultToFile(std::fstream& f);
-    virtual void writeGepObjVarMapToFile(std::fstream& f);
+    virtual void writeObjFieldSensitivityToFile(PointsToFileWriter& f);
+    virtual void writePtsResultToFile(PointsToFileWriter& f);
+    virtual void writeGepObjVarMapToFile(PointsToFileWriter& f);
     virtual bool readFromFile(const std::string& filename);
-    virtual void readPtsResultFromFile(std::ifstream& f);
-    virtual void readGepObjVarMapFromFile(std::ifstream& f);
-    virtual void readAndSetObjFieldSensitivity(std::ifstream& f, const std::string& delimiterStr);
+    virtual void readPtsResultFromFile(PointsToFileReader& f);
+    virtual void readGepObjVarMapFromFile(PointsToFileReader& f);
+    virtual void readAndSetObjFieldSensitivity(PointsToFileReader& f);
     //@}
 
 protected:
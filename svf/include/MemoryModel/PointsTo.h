@@ -17,6 +17,7 @@
 #include "SVFIR/SVFType.h"
 #include "Util/BitVector.h"
 #include "Util/CoreBitVector.h"
+#include "Util/RoaringBitVector.h"
 #include "Util/SparseBitVector.h"
 
 namespace SVF
@@ -33,6 +34,7 @@ public:
         SBV,
         CBV,
         BV,
+        RBV,
     };
 
     class PointsToIterator;
@@ -152,6 +154,9 @@ private:
     /// and reverseNodeMapping
     bool metaSame(const PointsTo &pt) const;
 
+    /// Destroys the backing data structure, to be reconstructed as another type.
+    void destroyBacking();
+
 private:
     /// Best node mapping we know of the for the analyses at hand.
     static MappingPtr currentBestNodeMapping;
@@ -168,6 +173,8 @@ private:
         CoreBitVector cbv;
         /// Bit vector backing.
         BitVector bv;
+        /// Roaring bit vector backing.
+        RoaringBitVector rbv;
     };
 
     /// Type of this points-to set.
@@ -227,6 +234,7 @@ public:
             SparseBitVector<>::iterator sbvIt;
             CoreBitVector::iterator cbvIt;
             BitVector::iterator bvIt;
+            RoaringBitVector::iterator rbvIt;
         };
     };
 };
@@ -0,0 +1,154 @@
+//===- PointsToFile.h -- Binary store of points-to results --------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PointsToFile.h
+ *
+ * Binary file format used by -write-ander/-read-ander and -ander-snapshot.
+ *
+ * A file is a header followed by a sequence of sections. Each section is tagged
+ * with its kind and byte length, so that readers can skip the sections they are
+ * not interested in (e.g., the versioned results of VFS when FlowSensitive loads
+ * the file) and so that the analyses can append sections in several steps.
+ *
+ * A section body is a table of points-to sets followed by records. Every distinct
+ * points-to set of a section is stored once (numbered as the PersistentPointsToCache
+ * which interns it), as the varint-encoded gaps between its sorted elements;
+ * records refer to sets by their IDs. All integers are LEB128 varints.
+ */
+
+#ifndef INCLUDE_MEMORYMODEL_POINTSTOFILE_H_
+#define INCLUDE_MEMORYMODEL_POINTSTOFILE_H_
+
+#include <fstream>
+#include <memory>
+
+#include "MemoryModel/PointsTo.h"
+#include "Util/SVFUtil.h"
+#include "MemoryModel/PersistentPointsToCache.h"
+
+namespace SVF
+{
+
+class PointsToFile
+{
+public:
+    enum SectionKind : u8_t
+    {
+        ObjFieldSensitivity,    ///< (base object, is field-insensitive) records
+        PtsResult,              ///< (var, points-to set) records
+        VersionedPtsResult,     ///< (object, version, points-to set) records
+        GepObjVarMap,           ///< (base object, offset, gep object) records
+        SolveInfo,              ///< (work, time in ms of the last full solve) record of a snapshot
+        NodeKeys,               ///< (var, scope, kind and ordinal) records of a snapshot
+        ScopeDigests,           ///< (scope, digest) records of a snapshot
+        ConsGEdges,             ///< (edge kind, src, dst) records of a snapshot
+        BindingDigests          ///< (scope, digest) records of the indirect call bindings of a snapshot
+    };
+
+protected:
+    static const char Magic[8];
+    static const u32_t Version;
+};
+
+/*!
+ * Writes sections to a points-to file. Records are buffered and the section is
+ * emitted (with its points-to set table) by endSection().
+ */
+class PointsToFileWriter : public PointsToFile
+{
+public:
+    /// Open filename for writing; append the sections to an existing file if append is set
+    PointsToFileWriter(const std::string& filename, bool append);
+
+    inline bool good() const
+    {
+        return os.good();
+    }
+
+    void beginSection(SectionKind kind);
+    void endSection();
+
+    /// Write into the records of the current section
+    //@{
+    void writeVarint(u64_t v);
+    void writeSignedVarint(s64_t v);
+    void writePts(const PointsTo& pts);
+    //@}
+
+private:
+    std::ofstream os;
+    SectionKind curKind;
+    std::string records;
+    PersistentPointsToCache<PointsTo> ptsCache;
+    PointsToID numOfPts;
+
+    static void appendVarint(std::string& buf, u64_t v);
+};
+
+/*!
+ * Reads sections from a points-to file. The file is mapped into memory and the
+ * points-to sets of a section are only decoded when a record refers to them.
+ */
+class PointsToFileReader : public PointsToFile
+{
+public:
+    PointsToFileReader(const std::string& filename);
+    ~PointsToFileReader();
+
+    inline bool good() const
+    {
+        return begin != nullptr;
+    }
+
+    /// Move to the next section of the given kind, skipping the sections in between.
+    /// Return false if there is no such section.
+    bool seekSection(SectionKind kind);
+
+    /// Whether all records of the current section have been read
+    inline bool atSectionEnd() const
+    {
+        return cur == sectionEnd;
+    }
+
+    /// Read from the records of the current section
+    //@{
+    u64_t readVarint();
+    s64_t readSignedVarint();
+    const PointsTo& readPts();
+    //@}
+
+private:
+    const char* begin;
+    const char* end;
+    const char* cur;
+    const char* sectionEnd;
+    size_t size;
+
+    /// Start of each points-to set of the current section, and the sets decoded so far
+    std::vector<const char*> ptsPos;
+    std::vector<std::unique_ptr<PointsTo>> pts;
+};
+
+} // End namespace SVF
+
+#endif /* INCLUDE_MEMORYMODEL_POINTSTOFILE_H_ */
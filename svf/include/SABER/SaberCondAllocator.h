@@ -35,11 +35,83 @@
 #include "Util/WorkList.h"
 #include "Graphs/SVFG.h"
 #include "Util/Z3Expr.h"
+#include "Util/BDDExpr.h"
 
+#include <optional>
 
 namespace SVF
 {
 
+/**
+ * A path condition, held as a Z3 expression or as a BDD depending on the
+ * backend of the allocator (-saber-bdd). A default-constructed condition
+ * is the null condition, which belongs to neither backend.
+ */
+class SaberCond
+{
+public:
+    SaberCond() = default;
+
+    SaberCond(const Z3Expr& e) : z3Expr(e)
+    {
+    }
+
+    SaberCond(const BDDExpr& b) : bddExpr(b)
+    {
+    }
+
+    inline bool isNull() const
+    {
+        return !z3Expr && bddExpr.isNull();
+    }
+    inline bool isBDD() const
+    {
+        return !bddExpr.isNull();
+    }
+    inline const Z3Expr& getZ3Expr() const
+    {
+        assert(z3Expr && "not a Z3 condition");
+        return *z3Expr;
+    }
+    inline const BDDExpr& getBDDExpr() const
+    {
+        assert(isBDD() && "not a BDD condition");
+        return bddExpr;
+    }
+    /// get id of the Z3 expression or BDD node
+    inline u32_t id() const
+    {
+        return z3Expr ? z3Expr->id() : bddExpr.id();
+    }
+
+    /// Return the null condition
+    static inline SaberCond nullExpr()
+    {
+        return SaberCond();
+    }
+
+    /// Syntactic equality of Z3 conditions, which is equivalence for BDDs
+    friend bool eq(const SaberCond& lhs, const SaberCond& rhs)
+    {
+        if (lhs.z3Expr && rhs.z3Expr)
+            return eq(*lhs.z3Expr, *rhs.z3Expr);
+        return !lhs.z3Expr && !rhs.z3Expr && lhs.bddExpr == rhs.bddExpr;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const SaberCond& cond)
+    {
+        if (cond.z3Expr)
+            out << *cond.z3Expr;
+        else
+            out << BDDExpr::dumpStr(cond.bddExpr);
+        return out;
+    }
+
+private:
+    std::optional<Z3Expr> z3Expr;
+    BDDExpr bddExpr;
+};
+
 /**
  * SaberCondAllocator allocates conditions for each basic block of a certain CFG.
  */
@@ -48,8 +120,8 @@ class SaberCondAllocator
 
 public:
 
-    typedef Z3Expr Condition;   /// z3 condition
-    typedef Map<u32_t, const ICFGNode*> IndexToTermInstMap; /// id to instruction map for z3
+    typedef SaberCond Condition;   /// z3 or BDD condition
+    typedef Map<u32_t, const ICFGNode*> IndexToTermInstMap; /// id to instruction map for conditions
     typedef Map<u32_t,Condition> CondPosMap;		///< map a branch to its Condition
     typedef Map<const SVFBasicBlock*, CondPosMap > BBCondMap;	/// map bb to a Condition
     typedef Set<const SVFBasicBlock*> BasicBlockSet;
@@ -86,35 +158,55 @@ public:
     //@{
     inline Condition condAnd(const Condition& lhs, const Condition& rhs)
     {
-        return Condition::AND(lhs,rhs);
+        if (useBDD)
+            return BDDExpr::AND(lhs.getBDDExpr(), rhs.getBDDExpr());
+        return Z3Expr::AND(lhs.getZ3Expr(), rhs.getZ3Expr());
     }
     inline Condition condOr(const Condition& lhs, const Condition& rhs)
     {
-        return Condition::OR(lhs,rhs);
+        if (useBDD)
+            return BDDExpr::OR(lhs.getBDDExpr(), rhs.getBDDExpr());
+        return Z3Expr::OR(lhs.getZ3Expr(), rhs.getZ3Expr());
     }
     inline Condition condNeg(const Condition& cond)
     {
-        return Condition::NEG(cond);
+        if (useBDD)
+            return BDDExpr::NEG(cond.getBDDExpr());
+        return Z3Expr::NEG(cond.getZ3Expr());
     }
     inline Condition getTrueCond() const
     {
-        return Condition::getTrueCond();
+        if (useBDD)
+            return BDDExpr::getTrueCond();
+        return Z3Expr::getTrueCond();
     }
     inline Condition getFalseCond() const
     {
-        return Condition::getFalseCond();
+        if (useBDD)
+            return BDDExpr::getFalseCond();
+        return Z3Expr::getFalseCond();
+    }
+    /// Whether conditions are BDDs rather than Z3 expressions
+    inline bool isBDDBackend() const
+    {
+        return useBDD;
     }
     /// Iterator every element of the condition
     inline NodeBS exactCondElem(const Condition& cond)
     {
         NodeBS elems;
-        extractSubConds(cond, elems);
+        if (useBDD)
+            extractBDDSubConds(cond, elems);
+        else
+            extractSubConds(cond, elems);
         return elems;
     }
 
     inline std::string dumpCond(const Condition& cond) const
     {
-        return Condition::dumpStr(cond);
+        if (useBDD)
+            return BDDExpr::dumpStr(cond.getBDDExpr());
+        return Z3Expr::dumpStr(cond.getZ3Expr());
     }
 
     /// Allocate a new condition
@@ -123,7 +215,7 @@ public:
     /// Perform path allocation
     void allocate(const SVFModule* module);
 
-    /// Get/Set instruction based on Z3 expression id
+    /// Get/Set instruction based on condition id
     //{@
     inline const ICFGNode* getCondInst(u32_t id) const
     {
@@ -199,7 +291,7 @@ public:
     /// whether condition is satisfiable for all possible boolean guards
     inline bool isAllPathReachable(Condition& condition)
     {
-        return isEquivalentBranchCond(condition, Condition::getTrueCond());
+        return isEquivalentBranchCond(condition, getTrueCond());
     }
 
     /// Whether lhs and rhs are equivalent branch conditions
@@ -234,7 +326,7 @@ public:
     //@}
 
 
-    /// mark neg Z3 expression
+    /// mark neg condition
     inline void setNegCondInst(const Condition &condition, const ICFGNode* inst)
     {
         setCondInst(condition, inst);
@@ -297,14 +389,17 @@ private:
 
     /// extract subexpression from a Z3 expression
     void extractSubConds(const Condition &condition, NodeBS &support) const;
+    /// extract the literals of a BDD
+    void extractBDDSubConds(const Condition &condition, NodeBS &support) const;
 
+    bool useBDD;                            ///< BDD rather than Z3 conditions
 
     FunToExitBBsMap funToExitBBsMap;		///< map a function to all its basic blocks calling program exit
     BBToCondMap bbToCondMap;				///< map a basic block to its path condition starting from root
     const SVFGNode* curEvalSVFGNode{};			///< current llvm value to evaluate branch condition when computing guards
     IndexToTermInstMap idToTermInstMap;     ///key: z3 expression id, value: instruction
     NodeBS negConds;                        ///bit vector for distinguish neg
-    std::vector<Condition> conditionVec;          /// vector storing z3expression
+    std::vector<Condition> conditionVec;          /// vector storing allocated conditions and their negations
     static u32_t totalCondNum; /// a counter for fresh condition
     SVFGNodeToSVFGNodeSetMap removedSUVFEdges;
 
@@ -48,6 +48,84 @@ namespace SVF
 
 typedef GraphReachSolver<SVFG*,CxtDPItem> CFLSrcSnkSolver;
 
+class SrcSnkDDA;
+
+/*!
+ * Computes the forward and backward slices of sources on the SVFG of a checker.
+ * A slicer keeps its own worklist and visited items, so each thread of a
+ * checker can slice a different source with its own slicer.
+ */
+class SrcSnkSlicer : public CFLSrcSnkSolver
+{
+
+public:
+    typedef CxtDPItem DPIm;
+    typedef Set<DPIm> DPImSet;							///< dpitem set
+    typedef Map<const SVFGNode*, DPImSet> SVFGNodeToDPItemsMap; 	///< map a SVFGNode to its visited dpitems
+    typedef ProgSlice::SVFGNodeSet SVFGNodeSet;
+
+    /// Constructor
+    SrcSnkSlicer(const SrcSnkDDA* c, SVFG* g) : checker(c), _curSlice(nullptr)
+    {
+        setGraph(g);
+    }
+
+    /// Compute the forward slice of the slice's source and, unless it reaches a global,
+    /// the backward slice from the sinks it reaches
+    void computeSlice(ProgSlice* slice);
+
+protected:
+    /// Forward traverse
+    void FWProcessCurNode(const DPIm& item) override;
+    /// Backward traverse
+    inline void BWProcessCurNode(const DPIm& item) override
+    {
+        const SVFGNode* node = getNode(item.getCurNodeID());
+        if(_curSlice->inForwardSlice(node))
+        {
+            _curSlice->addToBackwardSlice(node);
+        }
+    }
+    /// Propagate information forward by matching context
+    void FWProcessOutgoingEdge(const DPIm& item, SVFGEdge* edge) override;
+    /// Propagate information backward without matching context, as forward analysis already did it
+    void BWProcessIncomingEdge(const DPIm& item, SVFGEdge* edge) override;
+    /// Whether has been visited or not, in order to avoid recursion on SVFG
+    //@{
+    inline bool forwardVisited(const SVFGNode* node, const DPIm& item)
+    {
+        SVFGNodeToDPItemsMap::const_iterator it = nodeToDPItemsMap.find(node);
+        if(it!=nodeToDPItemsMap.end())
+            return it->second.find(item)!=it->second.end();
+        else
+            return false;
+    }
+    inline void addForwardVisited(const SVFGNode* node, const DPIm& item)
+    {
+        nodeToDPItemsMap[node].insert(item);
+    }
+    inline bool backwardVisited(const SVFGNode* node)
+    {
+        return visitedSet.find(node)!=visitedSet.end();
+    }
+    inline void addBackwardVisited(const SVFGNode* node)
+    {
+        visitedSet.insert(node);
+    }
+    inline void clearVisitedMap()
+    {
+        nodeToDPItemsMap.clear();
+        visitedSet.clear();
+    }
+    //@}
+
+private:
+    const SrcSnkDDA* checker;	///< the checker whose sources and sinks are sliced
+    ProgSlice* _curSlice;		///< slice being computed
+    SVFGNodeToDPItemsMap nodeToDPItemsMap;	///<  record forward visited dpitems
+    SVFGNodeSet visitedSet;	///<  record backward visited nodes
+};
+
 /*!
  * General source-sink analysis, which serves as a base analysis to be extended for various clients
  */
@@ -59,8 +137,6 @@ public:
     typedef Map<const SVFGNode*,ProgSlice*> SVFGNodeToSliceMap;
     typedef SVFGNodeSet::const_iterator SVFGNodeSetIter;
     typedef CxtDPItem DPIm;
-    typedef Set<DPIm> DPImSet;							///< dpitem set
-    typedef Map<const SVFGNode*, DPImSet> SVFGNodeToDPItemsMap; 	///< map a SVFGNode to its visited dpitems
     typedef Set<const CallICFGNode*> CallSiteSet;
     typedef NodeBS SVFGNodeBS;
     typedef ProgSlice::VFWorkList WorkList;
@@ -70,8 +146,6 @@ private:
     SVFGNodeSet sources;		/// source nodes
     SVFGNodeSet sinks;		/// source nodes
     std::unique_ptr<SaberCondAllocator> saberCondAllocator;
-    SVFGNodeToDPItemsMap nodeToDPItemsMap;	///<  record forward visited dpitems
-    SVFGNodeSet visitedSet;	///<  record backward visited nodes
 
 protected:
     SaberSVFGBuilder memSSA;
@@ -141,7 +215,8 @@ public:
     }
     /// Slice operations
     //@{
-    virtual void setCurSlice(const SVFGNode* src);
+    /// Take over the slice to be reported next, releasing the previous one
+    void setCurSlice(ProgSlice* slice);
 
     inline ProgSlice* getCurSlice() const
     {
@@ -249,60 +324,6 @@ public:
     }
 
 protected:
-    /// Forward traverse
-    inline void FWProcessCurNode(const DPIm& item) override
-    {
-        const SVFGNode* node = getNode(item.getCurNodeID());
-        if(isSink(node))
-        {
-            addSinkToCurSlice(node);
-            _curSlice->setPartialReachable();
-        }
-        else
-            addToCurForwardSlice(node);
-    }
-    /// Backward traverse
-    inline void BWProcessCurNode(const DPIm& item) override
-    {
-        const SVFGNode* node = getNode(item.getCurNodeID());
-        if(isInCurForwardSlice(node))
-        {
-            addToCurBackwardSlice(node);
-        }
-    }
-    /// Propagate information forward by matching context
-    void FWProcessOutgoingEdge(const DPIm& item, SVFGEdge* edge) override;
-    /// Propagate information backward without matching context, as forward analysis already did it
-    void BWProcessIncomingEdge(const DPIm& item, SVFGEdge* edge) override;
-    /// Whether has been visited or not, in order to avoid recursion on SVFG
-    //@{
-    inline bool forwardVisited(const SVFGNode* node, const DPIm& item)
-    {
-        SVFGNodeToDPItemsMap::const_iterator it = nodeToDPItemsMap.find(node);
-        if(it!=nodeToDPItemsMap.end())
-            return it->second.find(item)!=it->second.end();
-        else
-            return false;
-    }
-    inline void addForwardVisited(const SVFGNode* node, const DPIm& item)
-    {
-        nodeToDPItemsMap[node].insert(item);
-    }
-    inline bool backwardVisited(const SVFGNode* node)
-    {
-        return visitedSet.find(node)!=visitedSet.end();
-    }
-    inline void addBackwardVisited(const SVFGNode* node)
-    {
-        visitedSet.insert(node);
-    }
-    inline void clearVisitedMap()
-    {
-        nodeToDPItemsMap.clear();
-        visitedSet.clear();
-    }
-    //@}
-
     /// Whether it is all path reachable from a source
     virtual bool isAllPathReachable()
     {
@@ -0,0 +1,510 @@
+//===- SVFFileSystem.h -- Binary snapshot of SVFIR ---------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * SVFFileSystem.h
+ *
+ * Write SVFIR (with its SVFModule, ICFG, CallGraph and CHGraph) into a
+ * compact binary snapshot and read it back without any LLVM dependency.
+ *
+ * Layout of a snapshot:
+ *   header        magic + format version
+ *   declarations  kind (and id) of every object, grouped by table
+ *   contents      fields of every object, in the same order as declarations
+ *
+ * A pointer is written as the 1-based index of its object in the table of
+ * its kind (0 is nullptr). The reader allocates all objects from the
+ * declarations first, so the (often cyclic) references in the contents can
+ * be resolved in a single pass.
+ */
+
+#ifndef INCLUDE_SVFIR_SVFFILESYSTEM_H_
+#define INCLUDE_SVFIR_SVFFILESYSTEM_H_
+
+#include "SVFIR/SVFIR.h"
+#include "Graphs/CHG.h"
+#include "Graphs/CallGraph.h"
+#include "MemoryModel/SVFLoop.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace SVF
+{
+
+/*!
+ * Number the pointers of one table of a snapshot
+ */
+template <typename T>
+class SVFIRPtrPool
+{
+public:
+    /// Add ptr into the pool (if not added yet) and return its index
+    inline u32_t add(const T* ptr)
+    {
+        assert(ptr && "cannot add nullptr into a pool");
+        auto res = ptrToIdx.emplace(ptr, ptrs.size() + 1);
+        if (res.second)
+            ptrs.push_back(ptr);
+        return res.first->second;
+    }
+    inline bool has(const T* ptr) const
+    {
+        return ptrToIdx.find(ptr) != ptrToIdx.end();
+    }
+    inline u32_t getIdx(const T* ptr) const
+    {
+        if (ptr == nullptr)
+            return 0;
+        auto it = ptrToIdx.find(ptr);
+        assert(it != ptrToIdx.end() && "object not collected in the snapshot!");
+        return it->second;
+    }
+    inline const std::vector<const T*>& getPtrs() const
+    {
+        return ptrs;
+    }
+    inline u32_t size() const
+    {
+        return ptrs.size();
+    }
+
+private:
+    Map<const T*, u32_t> ptrToIdx;
+    std::vector<const T*> ptrs;
+};
+
+/*!
+ * Write a SVFIR snapshot
+ */
+class SVFIRWriter
+{
+public:
+    /// Write the SVFIR into the snapshot file at path
+    static void writeToPath(const SVFIR* svfir, const std::string& path);
+
+private:
+    const SVFIR* svfIR;
+    const CHGraph* chg;
+    std::string buf;
+
+    /// Tables of the snapshot
+    //@{
+    SVFIRPtrPool<SVFType> typePool;
+    SVFIRPtrPool<StInfo> stInfoPool;
+    SVFIRPtrPool<SVFValue> valuePool;
+    SVFIRPtrPool<SVFBasicBlock> bbPool;
+    SVFIRPtrPool<ICFGNode> icfgNodePool;
+    SVFIRPtrPool<ICFGEdge> icfgEdgePool;
+    SVFIRPtrPool<SVFLoop> loopPool;
+    SVFIRPtrPool<CallGraphNode> callGraphNodePool;
+    SVFIRPtrPool<ObjTypeInfo> objTypeInfoPool;
+    SVFIRPtrPool<SVFVar> varPool;
+    SVFIRPtrPool<SVFStmt> stmtPool;
+    SVFIRPtrPool<CHNode> chNodePool;
+    //@}
+
+    SVFIRWriter(const SVFIR* svfir);
+
+    /// Number all the objects reachable from the SVFIR
+    void collectPtrs();
+
+    void writeDecls();
+    void writeContents();
+
+    /// Contents of each kind of object
+    //@{
+    void writeType(const SVFType* type);
+    void writeStInfo(const StInfo* stInfo);
+    void writeValue(const SVFValue* value);
+    void writeBasicBlock(const SVFBasicBlock* bb);
+    void writeICFGNode(const ICFGNode* node);
+    void writeICFGEdge(const ICFGEdge* edge);
+    void writeLoop(const SVFLoop* loop);
+    void writeCallGraphEdge(const CallGraphEdge* edge);
+    void writeObjTypeInfo(const ObjTypeInfo* objTypeInfo);
+    void writeVar(const SVFVar* var);
+    void writeStmt(const SVFStmt* stmt);
+    void writeCHNode(const CHNode* node);
+    void writeBaseNode(const SVFBaseNode* node);
+    //@}
+
+    /// Tables of pointers of different kinds
+    //@{
+    inline const SVFIRPtrPool<SVFType>& getPool(const SVFType*) const
+    {
+        return typePool;
+    }
+    inline const SVFIRPtrPool<StInfo>& getPool(const StInfo*) const
+    {
+        return stInfoPool;
+    }
+    inline const SVFIRPtrPool<SVFValue>& getPool(const SVFValue*) const
+    {
+        return valuePool;
+    }
+    inline const SVFIRPtrPool<SVFBasicBlock>& getPool(const SVFBasicBlock*) const
+    {
+        return bbPool;
+    }
+    inline const SVFIRPtrPool<ICFGNode>& getPool(const ICFGNode*) const
+    {
+        return icfgNodePool;
+    }
+    inline const SVFIRPtrPool<ICFGEdge>& getPool(const ICFGEdge*) const
+    {
+        return icfgEdgePool;
+    }
+    inline const SVFIRPtrPool<SVFLoop>& getPool(const SVFLoop*) const
+    {
+        return loopPool;
+    }
+    inline const SVFIRPtrPool<CallGraphNode>& getPool(const CallGraphNode*) const
+    {
+        return callGraphNodePool;
+    }
+    inline const SVFIRPtrPool<ObjTypeInfo>& getPool(const ObjTypeInfo*) const
+    {
+        return objTypeInfoPool;
+    }
+    inline const SVFIRPtrPool<SVFVar>& getPool(const SVFVar*) const
+    {
+        return varPool;
+    }
+    inline const SVFIRPtrPool<SVFStmt>& getPool(const SVFStmt*) const
+    {
+        return stmtPool;
+    }
+    inline const SVFIRPtrPool<CHNode>& getPool(const CHNode*) const
+    {
+        return chNodePool;
+    }
+    //@}
+
+    /// Primitives
+    //@{
+    template <typename T>
+    inline typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type
+    write(T val)
+    {
+        buf.append(reinterpret_cast<const char*>(&val), sizeof(T));
+    }
+    template <typename T>
+    inline void write(const T* ptr)
+    {
+        write<u32_t>(getPool(ptr).getIdx(ptr));
+    }
+    inline void write(const std::string& str)
+    {
+        write<u32_t>(str.size());
+        buf.append(str);
+    }
+    void write(const AccessPath& ap);
+    void write(const NodeBS& bs);
+    template <typename T1, typename T2>
+    inline void write(const std::pair<T1, T2>& pair)
+    {
+        write(pair.first);
+        write(pair.second);
+    }
+    template <typename T, typename A>
+    inline void write(const std::vector<T, A>& vec)
+    {
+        writeContainer(vec);
+    }
+    template <typename T, typename A>
+    inline void write(const std::list<T, A>& list)
+    {
+        writeContainer(list);
+    }
+    template <typename K, typename C, typename A>
+    inline void write(const std::set<K, C, A>& set)
+    {
+        writeContainer(set);
+    }
+    template <typename K, typename H, typename E, typename A>
+    inline void write(const std::unordered_set<K, H, E, A>& set)
+    {
+        writeContainer(set);
+    }
+    template <typename K, typename V, typename C, typename A>
+    inline void write(const std::map<K, V, C, A>& map)
+    {
+        writeContainer(map);
+    }
+    template <typename K, typename V, typename H, typename E, typename A>
+    inline void write(const std::unordered_map<K, V, H, E, A>& map)
+    {
+        writeContainer(map);
+    }
+    template <typename C>
+    inline void writeContainer(const C& container)
+    {
+        write<u32_t>(container.size());
+        for (const auto& elem : container)
+            write(elem);
+    }
+    //@}
+};
+
+/*!
+ * Read a SVFIR snapshot
+ */
+class SVFIRReader
+{
+public:
+    /// Read the snapshot file at path into the (singleton) SVFIR and return it
+    static SVFIR* readFromPath(const std::string& path);
+
+private:
+    const char* cur;
+    const char* end;
+
+    SVFIR* svfIR;
+    ICFG* icfg;
+    CallGraph* callGraph;
+    CHGraph* chg;
+
+    /// Tables of the snapshot
+    //@{
+    std::vector<SVFType*> types;
+    std::vector<StInfo*> stInfos;
+    std::vector<SVFValue*> values;
+    std::vector<SVFBasicBlock*> bbs;
+    std::vector<ICFGNode*> icfgNodes;
+    std::vector<ICFGEdge*> icfgEdges;
+    std::vector<SVFLoop*> loops;
+    std::vector<CallGraphNode*> callGraphNodes;
+    std::vector<ObjTypeInfo*> objTypeInfos;
+    std::vector<SVFVar*> vars;
+    std::vector<SVFStmt*> stmts;
+    std::vector<CHNode*> chNodes;
+    //@}
+
+    SVFIRReader(const char* begin, const char* end);
+
+    /// Report a truncated or corrupt snapshot and abort
+    [[noreturn]] static void corrupt(const char* what);
+
+    /// Allocate all the objects of the snapshot
+    void readDecls();
+    void readContents();
+
+    /// Allocate an object of the given kind
+    //@{
+    SVFType* createType(SVFType::GNodeK kind);
+    SVFValue* createValue(SVFValue::GNodeK kind);
+    ICFGNode* createICFGNode(NodeID id, SVFBaseNode::GNodeK kind);
+    SVFVar* createVar(NodeID id, SVFBaseNode::GNodeK kind);
+    SVFStmt* createStmt(SVFStmt::GEdgeKind kind);
+    //@}
+
+    /// Contents of each kind of object
+    //@{
+    void readType(SVFType* type);
+    void readStInfo(StInfo* stInfo);
+    void readValue(SVFValue* value);
+    void readBasicBlock(SVFBasicBlock* bb);
+    void readICFGNode(ICFGNode* node);
+    ICFGEdge* readICFGEdge();
+    SVFLoop* readLoop();
+    void readCallGraphEdge();
+    void readObjTypeInfo(ObjTypeInfo* objTypeInfo);
+    void readVar(SVFVar* var);
+    void readStmt(SVFStmt* stmt);
+    void readCHNode(CHNode* node);
+    void readBaseNode(SVFBaseNode* node);
+    //@}
+
+    /// Tables of pointers of different kinds
+    //@{
+    inline const std::vector<SVFType*>& getTable(const SVFType*) const
+    {
+        return types;
+    }
+    inline const std::vector<StInfo*>& getTable(const StInfo*) const
+    {
+        return stInfos;
+    }
+    inline const std::vector<SVFValue*>& getTable(const SVFValue*) const
+    {
+        return values;
+    }
+    inline const std::vector<SVFBasicBlock*>& getTable(const SVFBasicBlock*) const
+    {
+        return bbs;
+    }
+    inline const std::vector<ICFGNode*>& getTable(const ICFGNode*) const
+    {
+        return icfgNodes;
+    }
+    inline const std::vector<ICFGEdge*>& getTable(const ICFGEdge*) const
+    {
+        return icfgEdges;
+    }
+    inline const std::vector<SVFLoop*>& getTable(const SVFLoop*) const
+    {
+        return loops;
+    }
+    inline const std::vector<CallGraphNode*>& getTable(const CallGraphNode*) const
+    {
+        return callGraphNodes;
+    }
+    inline const std::vector<ObjTypeInfo*>& getTable(const ObjTypeInfo*) const
+    {
+        return objTypeInfos;
+    }
+    inline const std::vector<SVFVar*>& getTable(const SVFVar*) const
+    {
+        return vars;
+    }
+    inline const std::vector<SVFStmt*>& getTable(const SVFStmt*) const
+    {
+        return stmts;
+    }
+    inline const std::vector<CHNode*>& getTable(const CHNode*) const
+    {
+        return chNodes;
+    }
+    //@}
+
+    /// Primitives
+    //@{
+    inline void readBytes(void* dst, size_t size)
+    {
+        if (size > static_cast<size_t>(end - cur))
+            corrupt("unexpected end of file");
+        std::memcpy(dst, cur, size);
+        cur += size;
+    }
+    template <typename T>
+    inline typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type
+    read(T& val)
+    {
+        readBytes(&val, sizeof(T));
+    }
+    template <typename T>
+    inline T read()
+    {
+        T val;
+        read(val);
+        return val;
+    }
+    /// Read the number of elements of a table or container, each of which
+    /// takes at least one byte, before anything is allocated for them
+    inline u32_t readSize()
+    {
+        u32_t size = read<u32_t>();
+        if (size > static_cast<size_t>(end - cur))
+            corrupt("element count beyond the end of file");
+        return size;
+    }
+    /// Pointers are written as their 1-based index in their table (SVFIRPtrPool),
+    /// with 0 standing for nullptr, so idx == table.size() is the last object
+    template <typename T>
+    inline void read(T*& ptr)
+    {
+        u32_t idx = read<u32_t>();
+        const auto& table = getTable(ptr);
+        if (idx > table.size())
+            corrupt("invalid object index");
+        ptr = idx == 0 ? nullptr : static_cast<T*>(table[idx - 1]);
+    }
+    inline void read(std::string& str)
+    {
+        u32_t size = read<u32_t>();
+        if (size > static_cast<size_t>(end - cur))
+            corrupt("unexpected end of file");
+        str.assign(cur, size);
+        cur += size;
+    }
+    void read(AccessPath& ap);
+    void read(NodeBS& bs);
+    template <typename T1, typename T2>
+    inline void read(std::pair<T1, T2>& pair)
+    {
+        read(pair.first);
+        read(pair.second);
+    }
+    template <typename T, typename A>
+    inline void read(std::vector<T, A>& vec)
+    {
+        vec.resize(readSize());
+        for (T& elem : vec)
+            read(elem);
+    }
+    template <typename T, typename A>
+    inline void read(std::list<T, A>& list)
+    {
+        for (u32_t i = 0, size = read<u32_t>(); i < size; ++i)
+        {
+            T elem;
+            read(elem);
+            list.push_back(elem);
+        }
+    }
+    template <typename K, typename C, typename A>
+    inline void read(std::set<K, C, A>& set)
+    {
+        readSet(set);
+    }
+    template <typename K, typename H, typename E, typename A>
+    inline void read(std::unordered_set<K, H, E, A>& set)
+    {
+        readSet(set);
+    }
+    template <typename K, typename V, typename C, typename A>
+    inline void read(std::map<K, V, C, A>& map)
+    {
+        readMap(map);
+    }
+    template <typename K, typename V, typename H, typename E, typename A>
+    inline void read(std::unordered_map<K, V, H, E, A>& map)
+    {
+        readMap(map);
+    }
+    template <typename S>
+    inline void readSet(S& set)
+    {
+        for (u32_t i = 0, size = read<u32_t>(); i < size; ++i)
+        {
+            typename S::value_type elem;
+            read(elem);
+            set.insert(elem);
+        }
+    }
+    template <typename M>
+    inline void readMap(M& map)
+    {
+        for (u32_t i = 0, size = read<u32_t>(); i < size; ++i)
+        {
+            typename M::key_type key;
+            read(key);
+            read(map[key]);
+        }
+    }
+    //@}
+};
+
+} // End namespace SVF
+
+#endif /* INCLUDE_SVFIR_SVFFILESYSTEM_H_ */
@@ -417,6 +417,8 @@ public:
     NodeID getGepObjVar(const BaseObjVar* baseObj, const APOffset& ap);
     /// Get a field obj SVFIR node according to a mem obj and a given offset
     NodeID getGepObjVar(NodeID id, const APOffset& ap) ;
+    /// Get an existing field obj SVFIR node, return false if it has not been created yet
+    bool findGepObjVar(NodeID id, const APOffset& ap, NodeID& gep);
     /// Get a field-insensitive obj SVFIR node according to a mem obj
     //@{
     inline NodeID getFIObjVar(const BaseObjVar* obj) const
@@ -684,6 +686,8 @@ private:
 
     /// Add a temp field value node, this method can only invoked by getGepValVar
     NodeID addGepValNode(NodeID curInst, const ValVar* base, const AccessPath& ap, NodeID i, const SVFType* type, const ICFGNode* node);
+    /// Look up a field obj node, setting newLS to the offset to create it at if it does not exist yet
+    bool lookupGepObjVar(const BaseObjVar* baseObj, const APOffset& apOffset, NodeID& gep, APOffset& newLS);
     /// Add a field obj node, this method can only invoked by getGepObjVar
     NodeID addGepObjNode(const BaseObjVar* baseObj, const APOffset& apOffset, const NodeID gepId);
     /// Add a field-insensitive node, this method can only invoked by getFIGepObjNode
@@ -0,0 +1,295 @@
+//===- BDDExpr.h -- BDD conditions----------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+/*
+ * BDDExpr.h
+ *
+ * A reduced ordered binary decision diagram (ROBDD) package for propositional
+ * conditions over boolean variables, e.g., the branch conditions of SABER.
+ *
+ * Nodes are hash-consed through a unique table, so two conditions are equivalent
+ * iff they are the same node. AND/OR/NEG results are memoised in a direct-mapped
+ * computed table. Nodes no longer reachable from a live BDDExpr are garbage
+ * collected once the node table grows past a threshold.
+ */
+
+#ifndef BDDEXPR_H_
+#define BDDEXPR_H_
+
+#include "Util/GeneralType.h"
+
+namespace SVF
+{
+
+/*!
+ * Node table, unique table and computed table shared by all BDDExprs.
+ * Not thread-safe: conditions are built by a single thread.
+ */
+class BDDManager
+{
+    friend class BDDExpr;
+
+public:
+    static constexpr u32_t FalseNode = 0;
+    static constexpr u32_t TrueNode = 1;
+    /// Variable index of the two terminals, ordered below every variable
+    static constexpr u32_t TerminalVar = UINT32_MAX;
+
+    /// Get the BDD manager, singleton design here to make sure we only have one node table
+    static BDDManager& getManager();
+
+    /// Statistics
+    //@{
+    inline u32_t getNodeNum() const
+    {
+        return nodes.size() - freeNodes.size();
+    }
+    inline u32_t getPeakNodeNum() const
+    {
+        return peakNodeNum;
+    }
+    inline u32_t getGCNum() const
+    {
+        return gcNum;
+    }
+    inline u64_t getCacheLookups() const
+    {
+        return cacheLookups;
+    }
+    inline u64_t getCacheHits() const
+    {
+        return cacheHits;
+    }
+    //@}
+
+private:
+    struct BDDNode
+    {
+        u32_t var;  ///< variable tested by this node
+        u32_t lo;   ///< successor when the variable is false
+        u32_t hi;   ///< successor when the variable is true
+        u32_t ref;  ///< number of BDDExprs holding this node
+    };
+
+    enum OpCode
+    {
+        OpAnd, OpOr, OpNeg
+    };
+
+    struct CacheEntry
+    {
+        u32_t op;
+        u32_t lhs;
+        u32_t rhs;
+        u32_t res;
+    };
+
+    typedef std::pair<u32_t, u64_t> NodeKey;  ///< (var, lo:hi)
+    typedef Map<NodeKey, u32_t> UniqueTable;
+
+    static constexpr u32_t CacheBits = 18;
+    static constexpr u32_t InitGCThreshold = 1u << 16;
+
+    BDDManager();
+
+    /// Node accessors
+    //@{
+    inline u32_t var(u32_t n) const
+    {
+        return nodes[n].var;
+    }
+    inline u32_t lo(u32_t n) const
+    {
+        return nodes[n].lo;
+    }
+    inline u32_t hi(u32_t n) const
+    {
+        return nodes[n].hi;
+    }
+    //@}
+
+    /// Reference counting by BDDExpr (the terminals are never collected)
+    //@{
+    inline void incRef(u32_t n)
+    {
+        if (n > TrueNode)
+            ++nodes[n].ref;
+    }
+    inline void decRef(u32_t n)
+    {
+        if (n > TrueNode)
+        {
+            assert(nodes[n].ref > 0 && "BDD node released too often");
+            --nodes[n].ref;
+        }
+    }
+    //@}
+
+    /// Top-level operations, which may first garbage collect dead nodes
+    //@{
+    u32_t getVarNode(u32_t v);
+    u32_t AND(u32_t lhs, u32_t rhs);
+    u32_t OR(u32_t lhs, u32_t rhs);
+    u32_t NEG(u32_t n);
+    //@}
+
+    /// Recursive operations, which never collect the nodes they work on
+    //@{
+    u32_t makeNode(u32_t v, u32_t lo, u32_t hi);
+    u32_t apply(OpCode op, u32_t lhs, u32_t rhs);
+    u32_t neg(u32_t n);
+    //@}
+
+    /// Computed table
+    //@{
+    inline CacheEntry& getCacheEntry(u32_t op, u32_t lhs, u32_t rhs)
+    {
+        size_t h = Hash<std::pair<u32_t, u64_t>>()(std::make_pair(op, ((u64_t)lhs << 32) | rhs));
+        return cache[h & (cache.size() - 1)];
+    }
+    bool lookupCache(u32_t op, u32_t lhs, u32_t rhs, u32_t& res);
+    void insertCache(u32_t op, u32_t lhs, u32_t rhs, u32_t res);
+    //@}
+
+    /// Free the nodes not reachable from any BDDExpr if the table grew past the threshold
+    void collectGarbage();
+
+    std::vector<BDDNode> nodes;
+    std::vector<u32_t> freeNodes;   ///< collected slots of nodes, reused first
+    UniqueTable uniqueTable;
+    std::vector<CacheEntry> cache;
+    u32_t gcThreshold;
+    u32_t peakNodeNum;
+    u32_t gcNum;
+    u64_t cacheLookups;
+    u64_t cacheHits;
+};
+
+/*!
+ * A condition as a handle to a BDD node. The null BDDExpr stands for no condition.
+ */
+class BDDExpr
+{
+public:
+    static constexpr u32_t NullNode = UINT32_MAX;
+
+    BDDExpr() : node(NullNode)
+    {
+    }
+
+    BDDExpr(const BDDExpr& rhs) : node(rhs.node)
+    {
+        if (node != NullNode)
+            BDDManager::getManager().incRef(node);
+    }
+
+    BDDExpr& operator=(const BDDExpr& rhs)
+    {
+        if (node != rhs.node)
+        {
+            BDDExpr copy(rhs);
+            std::swap(node, copy.node);
+        }
+        return *this;
+    }
+
+    ~BDDExpr()
+    {
+        if (node != NullNode)
+            BDDManager::getManager().decRef(node);
+    }
+
+    inline bool isNull() const
+    {
+        return node == NullNode;
+    }
+    /// get id, the same for and only for equivalent conditions
+    inline u32_t id() const
+    {
+        return node;
+    }
+    inline bool isTrue() const
+    {
+        return node == BDDManager::TrueNode;
+    }
+    inline bool isFalse() const
+    {
+        return node == BDDManager::FalseNode;
+    }
+
+    friend bool operator==(const BDDExpr& lhs, const BDDExpr& rhs)
+    {
+        return lhs.node == rhs.node;
+    }
+    friend bool operator!=(const BDDExpr& lhs, const BDDExpr& rhs)
+    {
+        return lhs.node != rhs.node;
+    }
+
+    /// Return the unique true condition
+    static inline BDDExpr getTrueCond()
+    {
+        return BDDExpr(BDDManager::TrueNode);
+    }
+    /// Return the unique false condition
+    static inline BDDExpr getFalseCond()
+    {
+        return BDDExpr(BDDManager::FalseNode);
+    }
+    /// Return the condition of boolean variable v
+    static inline BDDExpr getVarCond(u32_t v)
+    {
+        return BDDExpr(BDDManager::getManager().getVarNode(v));
+    }
+    /// compute NEG
+    static inline BDDExpr NEG(const BDDExpr& expr)
+    {
+        return BDDExpr(BDDManager::getManager().NEG(expr.node));
+    }
+    /// compute AND, used for branch condition
+    static inline BDDExpr AND(const BDDExpr& lhs, const BDDExpr& rhs)
+    {
+        return BDDExpr(BDDManager::getManager().AND(lhs.node, rhs.node));
+    }
+    /// compute OR, used for branch condition
+    static inline BDDExpr OR(const BDDExpr& lhs, const BDDExpr& rhs)
+    {
+        return BDDExpr(BDDManager::getManager().OR(lhs.node, rhs.node));
+    }
+
+    /// Collect the literals on the paths to true, as (variable, polarity) pairs
+    static void getLiterals(const BDDExpr& expr, Set<std::pair<u32_t, bool>>& literals);
+
+    /// output BDD as a disjunction of its paths to true
+    static std::string dumpStr(const BDDExpr& expr);
+
+private:
+    explicit BDDExpr(u32_t n) : node(n)
+    {
+        BDDManager::getManager().incRef(node);
+    }
+
+    u32_t node;
+};
+
+} // End namespace SVF
+
+#endif /* BDDEXPR_H_ */
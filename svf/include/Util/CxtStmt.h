@@ -457,46 +457,45 @@ private:
 
 } // End namespace SVF
 // Specialise has for class defined in this header file
+// Contexts are interned, so their IDs are hashed together with the other fields.
 template <> struct std::hash<SVF::CxtThread>
 {
     size_t operator()(const SVF::CxtThread& cs) const
     {
-        std::hash<SVF::CallStrCxt> h;
-        return h(cs.getContext());
+        SVF::Hash<std::pair<SVF::u32_t, const SVF::ICFGNode*>> h;
+        return h(std::make_pair(cs.getContext().getId(), cs.getThread()));
     }
 };
 template <> struct std::hash<SVF::CxtThreadProc>
 {
     size_t operator()(const SVF::CxtThreadProc& ctp) const
     {
-        std::hash<SVF::NodeID> h;
-        return h(ctp.getTid());
+        SVF::Hash<std::pair<SVF::NodeID, std::pair<SVF::u32_t, const SVF::SVFFunction*>>> h;
+        return h(std::make_pair(ctp.getTid(), std::make_pair(ctp.getContext().getId(), ctp.getProc())));
     }
 };
 template <> struct std::hash<SVF::CxtThreadStmt>
 {
     size_t operator()(const SVF::CxtThreadStmt& cts) const
     {
-        std::hash<SVF::NodeID> h;
-        return h(cts.getTid());
+        SVF::Hash<std::pair<SVF::NodeID, std::pair<SVF::u32_t, const SVF::ICFGNode*>>> h;
+        return h(std::make_pair(cts.getTid(), std::make_pair(cts.getContext().getId(), cts.getStmt())));
     }
 };
 template <> struct std::hash<SVF::CxtStmt>
 {
     size_t operator()(const SVF::CxtStmt& cs) const
     {
-        std::hash<SVF::ICFGNode*> h;
-        SVF::ICFGNode* inst = const_cast<SVF::ICFGNode*> (cs.getStmt());
-        return h(inst);
+        SVF::Hash<std::pair<SVF::u32_t, const SVF::ICFGNode*>> h;
+        return h(std::make_pair(cs.getContext().getId(), cs.getStmt()));
     }
 };
 template <> struct std::hash<SVF::CxtProc>
 {
     size_t operator()(const SVF::CxtProc& cs) const
     {
-        std::hash<SVF::SVFFunction*> h;
-        SVF::SVFFunction* fun = const_cast<SVF::SVFFunction*> (cs.getProc());
-        return h(fun);
+        SVF::Hash<std::pair<SVF::u32_t, const SVF::SVFFunction*>> h;
+        return h(std::make_pair(cs.getContext().getId(), cs.getProc()));
     }
 };
 #endif /* INCLUDE_UTIL_CXTSTMT_H_ */
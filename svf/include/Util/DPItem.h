@@ -32,6 +32,7 @@
 
 #include "MemoryModel/ConditionalPT.h"
 #include <algorithm>    // std::sort
+#include <atomic>
 
 namespace SVF
 {
@@ -283,8 +284,10 @@ public:
         {
             context.push_back(ctx);
 
-            if(context.size() > maximumCxt)
-                maximumCxt = context.size();
+            // SABER slices sources in parallel (-saber-threads), so record the maximum atomically
+            u32_t cxtSize = context.size();
+            u32_t maxCxt = maximumCxt.load(std::memory_order_relaxed);
+            while (cxtSize > maxCxt && !maximumCxt.compare_exchange_weak(maxCxt, cxtSize, std::memory_order_relaxed));
             return true;
         }
         else   /// handle out of context limit case
@@ -375,7 +378,7 @@ protected:
     static u32_t maximumPathLen;
     bool concreteCxt;
 public:
-    static u32_t maximumCxt;
+    static std::atomic<u32_t> maximumCxt;
     static u32_t maximumPath;
 };
 
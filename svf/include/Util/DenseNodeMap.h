@@ -0,0 +1,309 @@
+//===- DenseNodeMap.h -- Vector-backed map from node IDs to nodes ------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * DenseNodeMap.h
+ *
+ * The node table of GenericGraph. Node IDs handed out by NodeIDAllocator are
+ * (mostly) dense, so nodes are kept in a vector indexed by ID and a lookup is a
+ * single load. IDs far beyond the populated range (e.g., the values allocated
+ * from UINT_MAX downwards by the SEQUENTIAL and REVERSE_DENSE strategies) go to
+ * an ordered map instead, so that a few sparse IDs can not blow up the vector.
+ *
+ * Iteration is in ascending order of IDs, as with the OrderedMap it replaces.
+ */
+
+#ifndef DENSENODEMAP_H_
+#define DENSENODEMAP_H_
+
+#include <algorithm>
+#include <assert.h>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "Util/GeneralType.h"
+
+namespace SVF
+{
+
+template <typename NodeTy>
+class DenseNodeMap
+{
+public:
+    typedef NodeID key_type;
+    typedef NodeTy* mapped_type;
+    typedef std::pair<const NodeID, NodeTy*> value_type;
+
+private:
+    /// Slot i holds (i, node), or (i, nullptr) if there is no node i
+    typedef std::vector<value_type> DenseTy;
+    /// Nodes whose IDs are beyond the dense range
+    typedef OrderedMap<NodeID, NodeTy*> SparseTy;
+
+    /// IDs below this always go to the dense range, however sparse they are;
+    /// beyond it, an ID only does if the dense range stays at least half full
+    static const size_t MinDenseSize = 1024;
+    /// Position of an iterator which has moved past the dense range
+    static const size_t NoPos = static_cast<size_t>(-1);
+
+public:
+    /*!
+     * Iterates the dense range and then the sparse map. Positions in the dense
+     * range are indices, so iterators stay valid when nodes are added or removed
+     * (except for an iterator to a removed node or into the sparse map when
+     * the dense range grows over it).
+     */
+    template <bool IsConst>
+    class Iterator
+    {
+        friend class DenseNodeMap;
+        template <bool> friend class Iterator;
+        typedef typename std::conditional<IsConst, const DenseNodeMap, DenseNodeMap>::type OwnerTy;
+        typedef typename std::conditional<IsConst, typename SparseTy::const_iterator,
+                typename SparseTy::iterator>::type SparseIterTy;
+
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef typename std::conditional<IsConst, const typename DenseNodeMap::value_type,
+                typename DenseNodeMap::value_type>::type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef value_type* pointer;
+        typedef value_type& reference;
+
+        Iterator() : owner(nullptr), pos(NoPos) {}
+
+        /// iterator to const_iterator
+        template <bool C = IsConst, typename = typename std::enable_if<C>::type>
+        Iterator(const Iterator<false>& it) : owner(it.owner), pos(it.pos), sparseIt(it.sparseIt) {}
+
+        inline reference operator*() const
+        {
+            return pos != NoPos ? owner->dense[pos] : *sparseIt;
+        }
+        inline pointer operator->() const
+        {
+            return &**this;
+        }
+
+        inline Iterator& operator++()
+        {
+            if (pos == NoPos)
+                ++sparseIt;
+            else if ((pos = owner->nextDensePos(pos + 1)) == NoPos)
+                sparseIt = owner->sparse.begin();
+            return *this;
+        }
+        inline Iterator operator++(int)
+        {
+            Iterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        inline Iterator& operator--()
+        {
+            if (pos == NoPos && sparseIt != owner->sparse.begin())
+                --sparseIt;
+            else
+            {
+                pos = owner->prevDensePos(pos == NoPos ? owner->dense.size() : pos);
+                assert(pos != NoPos && "decrementing the begin iterator!");
+            }
+            return *this;
+        }
+        inline Iterator operator--(int)
+        {
+            Iterator it = *this;
+            --*this;
+            return it;
+        }
+
+        inline bool operator==(const Iterator& rhs) const
+        {
+            return pos == rhs.pos && (pos != NoPos || sparseIt == rhs.sparseIt);
+        }
+        inline bool operator!=(const Iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+        OwnerTy* owner;
+        size_t pos;             ///< index into the dense range, or NoPos
+        SparseIterTy sparseIt;  ///< position in the sparse map once pos is NoPos
+
+        Iterator(OwnerTy* o, size_t p, SparseIterTy s) : owner(o), pos(p), sparseIt(s) {}
+    };
+
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+    DenseNodeMap() : numOfDenseNodes(0) {}
+
+    /// Iterators
+    //@{
+    inline iterator begin()
+    {
+        return iterator(this, nextDensePos(0), sparse.begin());
+    }
+    inline iterator end()
+    {
+        return iterator(this, NoPos, sparse.end());
+    }
+    inline const_iterator begin() const
+    {
+        return const_iterator(this, nextDensePos(0), sparse.begin());
+    }
+    inline const_iterator end() const
+    {
+        return const_iterator(this, NoPos, sparse.end());
+    }
+    //@}
+
+    inline size_t size() const
+    {
+        return numOfDenseNodes + sparse.size();
+    }
+    inline bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /// Return the node of id, or nullptr if there is none
+    inline NodeTy* lookup(NodeID id) const
+    {
+        if (id < dense.size())
+            return dense[id].second;
+        if (sparse.empty())
+            return nullptr;
+        typename SparseTy::const_iterator it = sparse.find(id);
+        return it != sparse.end() ? it->second : nullptr;
+    }
+
+    inline size_t count(NodeID id) const
+    {
+        return lookup(id) != nullptr;
+    }
+
+    inline iterator find(NodeID id)
+    {
+        if (id < dense.size())
+            return dense[id].second ? iterator(this, id, sparse.begin()) : end();
+        return iterator(this, NoPos, sparse.find(id));
+    }
+    inline const_iterator find(NodeID id) const
+    {
+        if (id < dense.size())
+            return dense[id].second ? const_iterator(this, id, sparse.begin()) : end();
+        return const_iterator(this, NoPos, sparse.find(id));
+    }
+
+    /// Map id to node, replacing the node already mapped from id (if any)
+    void insert(NodeID id, NodeTy* node)
+    {
+        assert(node && "inserting a null node!");
+        if (id >= dense.size())
+        {
+            // Keep at least half of the dense slots occupied.
+            if (id >= MinDenseSize && id >= 2 * (size() + 1))
+            {
+                sparse[id] = node;
+                return;
+            }
+            growDense(id + 1);
+        }
+        if (dense[id].second == nullptr)
+            ++numOfDenseNodes;
+        dense[id].second = node;
+    }
+
+    /// Remove the node of id; return the number of nodes removed
+    size_t erase(NodeID id)
+    {
+        if (id < dense.size())
+        {
+            if (dense[id].second == nullptr)
+                return 0;
+            dense[id].second = nullptr;
+            --numOfDenseNodes;
+            return 1;
+        }
+        return sparse.erase(id);
+    }
+
+    inline void erase(const_iterator it)
+    {
+        erase(it->first);
+    }
+
+    void clear()
+    {
+        dense.clear();
+        sparse.clear();
+        numOfDenseNodes = 0;
+    }
+
+private:
+    DenseTy dense;
+    SparseTy sparse;
+    size_t numOfDenseNodes; ///< number of non-null slots in dense
+
+    /// Extend the dense range to [0, n) and move the sparse nodes it now covers
+    void growDense(size_t n)
+    {
+        if (n > dense.capacity())
+            dense.reserve(std::max(n, 2 * dense.capacity()));
+        for (size_t i = dense.size(); i < n; ++i)
+            dense.emplace_back(i, nullptr);
+
+        typename SparseTy::iterator last = sparse.lower_bound(n);
+        for (typename SparseTy::iterator it = sparse.begin(); it != last; ++it)
+        {
+            dense[it->first].second = it->second;
+            ++numOfDenseNodes;
+        }
+        sparse.erase(sparse.begin(), last);
+    }
+
+    /// First non-null slot at or after pos, or NoPos
+    inline size_t nextDensePos(size_t pos) const
+    {
+        for (size_t n = dense.size(); pos < n; ++pos)
+            if (dense[pos].second)
+                return pos;
+        return NoPos;
+    }
+
+    /// Last non-null slot before pos, or NoPos
+    inline size_t prevDensePos(size_t pos) const
+    {
+        while (pos > 0)
+            if (dense[--pos].second)
+                return pos;
+        return NoPos;
+    }
+};
+
+} // End namespace SVF
+
+#endif /* DENSENODEMAP_H_ */
@@ -44,6 +44,8 @@ namespace SVF
 class ExtAPI
 {
     friend class LLVMModuleSet;
+    friend class SVFIRWriter;
+    friend class SVFIRReader;
 private:
 
     static ExtAPI *extOp;
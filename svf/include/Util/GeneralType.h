@@ -30,6 +30,7 @@
 #pragma once
 #include <cstdint>
 #include <deque>
+#include <iterator>
 #include <iostream>
 #include <list>
 #include <map>
@@ -119,9 +120,179 @@ template <typename Key, typename Value, typename Hash = Hash<Key>,
                     typedef std::list<NodeID> NodeList;
                     typedef std::deque<NodeID> NodeDeque;
                     typedef NodeSet EdgeSet;
-                    typedef std::vector<u32_t> CallStrCxt;
                     typedef unsigned Version;
                     typedef Set<Version> VersionSet;
                     typedef std::pair<NodeID, Version> VersionedVar;
                     typedef Set<VersionedVar> VersionedVarSet;
-}
\ No newline at end of file
+
+/*!
+ * A calling context, i.e., a string of call site IDs from the outermost call to
+ * the most recent one. Contexts are hash-consed into a global trie of call sites
+ * shared by all threads, so a context is the 32-bit ID of its trie node: copying,
+ * push_back, pop_back, back, comparison and hashing take constant time, while
+ * indexing and iteration walk up the trie and are linear in size().
+ *
+ * Trie nodes are never freed. New nodes are added under a lock; reading a node is
+ * lock-free since nodes live in chunks which never move.
+ */
+class CallStrCxt
+{
+public:
+    typedef u32_t value_type;
+
+    /// Iterates over the call sites from the outermost to the most recent one
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef u32_t value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const u32_t* pointer;
+        typedef u32_t reference;
+
+        const_iterator(const CallStrCxt* c, u32_t i) : cxt(c), idx(i) {}
+
+        inline u32_t operator*() const
+        {
+            return (*cxt)[idx];
+        }
+        inline const_iterator& operator++()
+        {
+            ++idx;
+            return *this;
+        }
+        inline const_iterator operator++(int)
+        {
+            const_iterator old = *this;
+            ++idx;
+            return old;
+        }
+        inline bool operator==(const const_iterator& rhs) const
+        {
+            return cxt == rhs.cxt && idx == rhs.idx;
+        }
+        inline bool operator!=(const const_iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+        inline u32_t getIndex() const
+        {
+            return idx;
+        }
+
+    private:
+        const CallStrCxt* cxt;
+        u32_t idx;
+    };
+    typedef const_iterator iterator;
+
+    /// The empty context
+    CallStrCxt() : id(EmptyCxt) {}
+
+    /// ID of the context, the same for and only for equal contexts
+    inline u32_t getId() const
+    {
+        return id;
+    }
+    inline u32_t size() const
+    {
+        return getNode(id).depth;
+    }
+    inline bool empty() const
+    {
+        return id == EmptyCxt;
+    }
+    inline void clear()
+    {
+        id = EmptyCxt;
+    }
+    /// The most recent call site
+    inline u32_t back() const
+    {
+        assert(!empty() && "empty context has no call site");
+        return getNode(id).callSite;
+    }
+    inline void push_back(u32_t callSite)
+    {
+        id = getChild(id, callSite);
+    }
+    inline void pop_back()
+    {
+        assert(!empty() && "pop an empty context");
+        id = getNode(id).parent;
+    }
+    /// The index-th call site, counting from the outermost one
+    u32_t operator[](u32_t index) const
+    {
+        assert(index < size() && "index out of bound");
+        u32_t n = id;
+        for (u32_t i = size() - 1; i > index; --i)
+            n = getNode(n).parent;
+        return getNode(n).callSite;
+    }
+    /// Remove the call site at pos, which re-interns all call sites after it
+    const_iterator erase(const_iterator pos);
+
+    inline const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+    inline const_iterator end() const
+    {
+        return const_iterator(this, size());
+    }
+
+    /// Contexts are ordered by ID, which is cheaper than lexicographically
+    //@{
+    inline bool operator==(const CallStrCxt& rhs) const
+    {
+        return id == rhs.id;
+    }
+    inline bool operator!=(const CallStrCxt& rhs) const
+    {
+        return id != rhs.id;
+    }
+    inline bool operator<(const CallStrCxt& rhs) const
+    {
+        return id < rhs.id;
+    }
+    //@}
+
+    /// Number of distinct contexts created so far, including the empty one
+    static u32_t getNumOfCxts();
+
+private:
+    struct CxtNode
+    {
+        u32_t parent;   ///< context without the most recent call site
+        u32_t callSite; ///< the most recent call site
+        u32_t depth;    ///< number of call sites
+    };
+
+    static constexpr u32_t EmptyCxt = 0;
+    static constexpr u32_t ChunkBits = 14;
+    static constexpr u32_t MaxChunks = 1u << (32 - ChunkBits);
+
+    static inline const CxtNode& getNode(u32_t n)
+    {
+        return chunks[n >> ChunkBits][n & ((1u << ChunkBits) - 1)];
+    }
+    /// Return the context of parent followed by callSite, creating it if need be
+    static u32_t getChild(u32_t parent, u32_t callSite);
+
+    /// Node storage, whose first chunk holds the empty context
+    static CxtNode firstChunk[1u << ChunkBits];
+    static CxtNode* chunks[MaxChunks];
+
+    u32_t id;
+};
+
+} // End namespace SVF
+
+template <> struct std::hash<SVF::CallStrCxt>
+{
+    size_t operator()(const SVF::CallStrCxt& cxt) const
+    {
+        return cxt.getId();
+    }
+};
\ No newline at end of file
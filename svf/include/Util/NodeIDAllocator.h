@@ -127,6 +127,7 @@ public:
         static const std::string RegioningTime;
         static const std::string DistanceMatrixTime;
         static const std::string FastClusterTime;
+        static const std::string StreamingTime;
         static const std::string DendrogramTraversalTime;
         static const std::string EvalTime;
         static const std::string TotalTime;
@@ -179,6 +180,14 @@ public:
                                                 const size_t numObjects, const Map<NodeID, unsigned> &nodeMap,
                                                 double &distanceMatrixTime);
 
+        /// Allocates the objects of a region without a distance matrix: the points-to sets are
+        /// streamed from the most to the least occurring, each handing out consecutive identifiers
+        /// to its objects which have none yet, so the most common sets span the fewest words. Time
+        /// and memory are linear in the size of the points-to sets (after sorting them).
+        static inline void streamRegion(const std::vector<std::pair<const PointsTo *, unsigned>> &pointsToSets,
+                                        const OrderedSet<NodeID> &regionObjects, std::vector<NodeID> &nodeMap,
+                                        unsigned &allocCounter);
+
         /// Traverses the dendrogram produced by fastcluster, making node o, where o is the nth leaf (per
         /// recursive DFS) map to n. index is the dendrogram node to work off. The traversal should start
         /// at the top, which is the "last" (consider that it is 2D) element of the dendrogram, numObjects - 1.
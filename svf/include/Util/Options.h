@@ -71,14 +71,21 @@ public:
     /// Time limit for the main phase (i.e., the actual solving) of FS analyses.
     static const Option<u32_t> FsTimeLimit;
 
+    /// Number of threads for the propagation between SVFG SCCs in FS.
+    static const Option<u32_t> FsThreads;
+
     /// Time limit for the Andersen's analyses.
     static const Option<u32_t> AnderTimeLimit;
 
     /// Number of threads for the versioning phase.
     static const Option<u32_t> VersioningThreads;
 
+    /// Number of threads for the loads, stores and version propagation in the main phase of VFS.
+    static const Option<u32_t> VfsThreads;
+
     // ContextDDA.cpp
     static const Option<u32_t> CxtBudget;
+    static const Option<bool> DDAQueryCache;
 
     // DDAPass.cpp
     static const Option<u32_t> MaxPathLen;
@@ -90,6 +97,7 @@ public:
     static const Option<bool> PrintCPts;
     static const Option<bool> PrintQueryPts;
     static const Option<bool> WPANum;
+    static const Option<bool> DDABatch;
     static OptionMultiple<PointerAnalysis::PTATY> DDASelected;
 
     // FlowDDA.cpp
@@ -128,6 +136,7 @@ public:
     static const Option<u32_t> IndirectCallLimit;
     static const Option<bool> UsePreCompFieldSensitive;
     static const Option<bool> EnableAliasCheck;
+    static const Option<bool> SBVArena;
     static const Option<bool> EnableTypeCheck;
     static const Option<bool> EnableThreadCallGraph;
     static const Option<bool> ConnectVCallOnCHA;
@@ -143,6 +152,8 @@ public:
     static const Option<std::string> MSSAFun;
     // static const llvm::cl::opt<string> MSSAFun;
     static const OptionMap<MemSSA::MemPartition> MemPar;
+    /// Number of threads computing mod-ref and building the memory SSA of functions.
+    static const Option<u32_t> MSSAThreads;
 
     // SVFG builder (SVFGBuilder.cpp)
     static const Option<bool> SVFGWithIndirectCall;
@@ -162,6 +173,10 @@ public:
     //MTAStat.cpp
     static const Option<bool> AllPairMHP;
 
+    // MTA.cpp
+    /// Number of threads checking the candidate race pairs.
+    static const Option<u32_t> MTAThreads;
+
     // TCT.cpp
     static const Option<bool> TCTDotGraph;
 
@@ -171,6 +186,8 @@ public:
     // Source-sink analyzer (SrcSnkDDA.cpp)
     static const Option<bool> DumpSlice;
     static const Option<u32_t> CxtLimit;
+    /// Number of threads slicing the sources of a SABER checker.
+    static const Option<u32_t> SaberThreads;
 
     // CHG.cpp
     static const Option<bool> DumpCHA;
@@ -197,6 +214,7 @@ public:
 
     // SaberCondAllocator.cpp
     static const Option<bool> PrintPathCond;
+    static const Option<bool> SaberBDD;
 
     // SaberSVFGBuilder.cpp
     static const Option<bool> CollectExtRetGlobals;
@@ -212,8 +230,10 @@ public:
     static const Option<std::string> WriteAnder;
     // static const Option<string> ReadAnder;
     static const Option<std::string> ReadAnder;
+    static const Option<std::string> AnderSnapshot;
     static const Option<bool> DiffPts;
     static Option<bool> DetectPWC;
+    static const Option<u32_t> AnderThreads;
     static const Option<bool> VtableInSVFIR;
 
     // WPAPass.cpp
@@ -236,6 +256,8 @@ public:
     static const Option<bool>  CFLSVFG;
     static const Option<bool> POCRAlias;
     static const Option<bool> POCRHybrid;
+    static const Option<bool> CFLMatrix;
+    static const Option<u32_t> CFLThreads;
     static const Option<bool> Customized;
 
     // Loop Analysis
@@ -0,0 +1,261 @@
+//===- RoaringBitVector.h -- Compressed bit vector data structure ------------//
+
+/*
+ * RoaringBitVector.h
+ *
+ * Two-level compressed bit vector in the style of Roaring bitmaps.
+ *
+ * Bits are grouped into chunks of 2^16 by their high 16 bits. The chunks
+ * holding at least one bit are kept, sorted, in one contiguous vector, and each
+ * stores its low 16 bits in whichever container is smallest:
+ *  - an array container: sorted 16-bit values, for at most 4096 bits,
+ *  - a run container: sorted [first, last] ranges, for long runs of bits,
+ *  - a bitmap container: 1024 64-bit words otherwise.
+ * The container of a chunk is a function of its bits only, so equal vectors
+ * have equal representations.
+ */
+
+#ifndef ROARINGBITVECTOR_H_
+#define ROARINGBITVECTOR_H_
+
+#include <assert.h>
+#include <vector>
+
+#include "SVFIR/SVFType.h"
+
+namespace SVF
+{
+
+/// A compressed bit vector split into chunks of 2^16 bits, each stored as a
+/// sorted array, a list of runs, or a bitmap, whichever is smallest.
+/// Binary operations work chunk by chunk with a kernel per pair of container
+/// kinds; bitmap kernels are plain loops over words which the compiler
+/// vectorises.
+/// Abbreviated RBV.
+class RoaringBitVector
+{
+public:
+    typedef unsigned long long Word;
+
+    class RoaringBitVectorIterator;
+    typedef RoaringBitVectorIterator const_iterator;
+    typedef const_iterator iterator;
+
+    /// Bits per chunk and words per bitmap container.
+    static constexpr u32_t ChunkBits = 16;
+    static constexpr u32_t BitmapWords = (1u << ChunkBits) / 64;
+    /// Largest array container; larger chunks are runs or bitmaps.
+    static constexpr u32_t MaxArraySize = 4096;
+    /// Largest run container; a bitmap is smaller beyond it.
+    static constexpr u32_t MaxRuns = 2047;
+
+public:
+    /// Construct empty RBV.
+    RoaringBitVector(void) = default;
+
+    RoaringBitVector(const RoaringBitVector &rbv) = default;
+    RoaringBitVector(RoaringBitVector &&rbv) noexcept = default;
+    RoaringBitVector &operator=(const RoaringBitVector &rhs) = default;
+    RoaringBitVector &operator=(RoaringBitVector &&rhs) noexcept = default;
+
+    /// Returns true if no bits are set.
+    bool empty(void) const
+    {
+        return chunks.empty();
+    }
+
+    /// Returns number of bits set.
+    u32_t count(void) const;
+
+    /// Empty the RBV.
+    void clear(void);
+
+    /// Returns true if bit is set in this RBV.
+    bool test(u32_t bit) const;
+
+    /// Check if bit is set. If it is, returns false.
+    /// Otherwise, sets bit and returns true.
+    bool test_and_set(u32_t bit);
+
+    /// Sets bit in the RBV.
+    void set(u32_t bit)
+    {
+        test_and_set(bit);
+    }
+
+    /// Resets bit in the RBV.
+    void reset(u32_t bit);
+
+    /// Returns true if this RBV is a superset of rhs.
+    bool contains(const RoaringBitVector &rhs) const;
+
+    /// Returns true if this RBV and rhs share any set bits.
+    bool intersects(const RoaringBitVector &rhs) const;
+
+    /// Returns true if this RBV and rhs have the same bits set.
+    bool operator==(const RoaringBitVector &rhs) const;
+
+    /// Returns true if either this RBV or rhs has a bit set unique to the other.
+    bool operator!=(const RoaringBitVector &rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /// Put union of this RBV and rhs into this RBV.
+    /// Returns true if RBV changed.
+    bool operator|=(const RoaringBitVector &rhs);
+
+    /// Put intersection of this RBV and rhs into this RBV.
+    /// Returns true if RBV changed.
+    bool operator&=(const RoaringBitVector &rhs);
+
+    /// Remove set bits in rhs from this RBV.
+    /// Returns true if RBV changed.
+    bool operator-=(const RoaringBitVector &rhs)
+    {
+        return intersectWithComplement(rhs);
+    }
+
+    /// Put intersection of this RBV with complement of rhs into this RBV.
+    /// Returns true if this RBV changed.
+    bool intersectWithComplement(const RoaringBitVector &rhs);
+
+    /// Put intersection of lhs with complement of rhs into this RBV.
+    void intersectWithComplement(const RoaringBitVector &lhs, const RoaringBitVector &rhs);
+
+    /// Hash for this RBV.
+    size_t hash(void) const;
+
+    const_iterator begin(void) const;
+    const_iterator end(void) const;
+
+private:
+    enum ContainerKind : u8_t
+    {
+        ArrayKind,
+        RunKind,
+        BitmapKind,
+    };
+
+    /// The set bits of one chunk, in one of three containers.
+    struct Chunk
+    {
+        /// High 16 bits of all bits in this chunk.
+        u32_t key;
+        ContainerKind kind;
+        /// Number of bits set; never 0.
+        u32_t card;
+        /// Number of runs of consecutive set bits, kept for bitmaps only.
+        u32_t runs;
+        /// Sorted values of an array container, or [first, last] pairs of a run container.
+        std::vector<u16_t> data;
+        /// Words of a bitmap container.
+        std::vector<Word> words;
+
+        explicit Chunk(u32_t k) : key(k), kind(ArrayKind), card(0), runs(0) {}
+
+        bool test(u32_t low) const;
+        bool set(u32_t low);
+        bool reset(u32_t low);
+
+        /// Write the bits of this chunk into a zeroed bitmap of BitmapWords words.
+        void toBitmap(Word *bitmap) const;
+        /// Take the bits of bitmap, picking the smallest container for them.
+        void fromBitmap(const Word *bitmap);
+        /// Move to the smallest container for the current card and runs.
+        void normalise(void);
+
+        /// Kernels; each returns true if this chunk changed.
+        //@{
+        bool unionWith(const Chunk &rhs);
+        bool intersectWith(const Chunk &rhs);
+        bool subtract(const Chunk &rhs);
+        //@}
+        bool contains(const Chunk &rhs) const;
+        bool intersects(const Chunk &rhs) const;
+        bool operator==(const Chunk &rhs) const;
+
+        u32_t first(void) const;
+        u32_t last(void) const;
+    };
+
+    /// Returns the index of the first chunk with a key not less than key.
+    size_t lowerBound(u32_t key) const;
+
+    /// Chunks with at least one bit set, sorted by key.
+    std::vector<Chunk> chunks;
+
+public:
+    class RoaringBitVectorIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = u32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = u32_t *;
+        using reference = u32_t &;
+
+        RoaringBitVectorIterator(void) = delete;
+
+        /// Returns an iterator to the beginning of rbv if end is false, and to
+        /// the end of rbv if end is true.
+        RoaringBitVectorIterator(const RoaringBitVector *rbv, bool end=false);
+
+        RoaringBitVectorIterator(const RoaringBitVectorIterator &rbv) = default;
+        RoaringBitVectorIterator(RoaringBitVectorIterator &&rbv) = default;
+
+        RoaringBitVectorIterator &operator=(const RoaringBitVectorIterator &rbv) = default;
+        RoaringBitVectorIterator &operator=(RoaringBitVectorIterator &&rbv) = default;
+
+        /// Pre-increment: ++it.
+        const RoaringBitVectorIterator &operator++(void);
+
+        /// Post-increment: it++.
+        const RoaringBitVectorIterator operator++(int);
+
+        /// Dereference: *it.
+        u32_t operator*(void) const
+        {
+            return (rbv->chunks[chunk].key << ChunkBits) | low;
+        }
+
+        /// Equality: *this == rhs.
+        bool operator==(const RoaringBitVectorIterator &rhs) const
+        {
+            return chunk == rhs.chunk && low == rhs.low;
+        }
+
+        /// Inequality: *this != rhs.
+        bool operator!=(const RoaringBitVectorIterator &rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+        /// Point to the first bit of the current chunk, if any.
+        void enterChunk(void);
+
+    private:
+        /// RoaringBitVector we are iterating over.
+        const RoaringBitVector *rbv;
+        /// Index of the chunk we are looking at.
+        size_t chunk;
+        /// Index of the value (array) or run (run container) we are looking at.
+        u32_t pos;
+        /// Low 16 bits of the current bit.
+        u32_t low;
+    };
+};
+
+template <>
+struct Hash<RoaringBitVector>
+{
+    size_t operator()(const RoaringBitVector &rbv) const
+    {
+        return rbv.hash();
+    }
+};
+
+} // End namespace SVF
+
+#endif  // ROARINGBITVECTOR_H_
@@ -12,9 +12,13 @@
 #include <cassert>
 #include <cstring>
 #include <climits>
+#include <cstdint>
 #include <limits>
 #include <iterator>
 #include <list>
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 // Appease GCC?
 #ifdef __has_builtin
@@ -497,13 +501,194 @@ public:
     }
 };
 
+/// An arena for the list nodes of SparseBitVectors.
+/// Nodes are carved out of large blocks and recycled through free lists, one
+/// per node size. Arenas form a stack: nodes allocated while an arena is on
+/// top come from it, and all others from the heap. A released arena frees all
+/// of its blocks at once, as soon as the last node allocated from it is freed.
+/// Nodes are not bound to the owner of their SparseBitVector: a set which
+/// outlives its arena, or grows while another arena is on top, keeps the
+/// blocks of every arena it has nodes from.
+///
+/// The allocator of SparseBitVectors is stateless, so that arenas do not make
+/// every SparseBitVector larger: a node finds its arena in the header of its
+/// block. Blocks are aligned to their size, and every slot of a block starts
+/// 8 bytes past a 16-byte boundary, whereas heap nodes come from the default
+/// operator new and are at least 16-byte aligned.
+///
+/// Each thread has its own free lists and block for each arena, so allocating
+/// and freeing a node takes no lock. A thread only locks the arena to take
+/// a new block or the free slots given back by exited threads.
+class SparseBitVectorArena
+{
+public:
+    /// Bytes per block.
+    static constexpr size_t BlockSize = 1 << 16;
+    /// Larger nodes are allocated from the heap.
+    static constexpr size_t MaxSlotSize = 256;
+    /// Slot sizes are multiples of SlotAlign, and slots start at SlotOffset modulo SlotAlign.
+    static constexpr size_t SlotAlign = 16;
+    static constexpr size_t SlotOffset = 8;
+
+    /// Push a new arena, which becomes the current one.
+    static SparseBitVectorArena* push();
+
+    /// Take this arena off the stack. No other thread may allocate from the
+    /// arena meanwhile.
+    void release();
+
+    /// Arena new nodes are allocated from, nullptr for the heap.
+    static inline SparseBitVectorArena* getCurrent()
+    {
+        return current.load(std::memory_order_acquire);
+    }
+
+    /// Allocate bytes for a node from the current arena (or the heap), and free
+    /// a node of bytes allocated by allocate. Without arenas, nodes cost what
+    /// they cost with std::allocator, plus a load of the current arena.
+    //@{
+    static inline void* allocate(size_t bytes)
+    {
+        SparseBitVectorArena* arena = getCurrent();
+        if (arena == nullptr || bytes > MaxSlotSize)
+        {
+            if (countHeapNodes.load(std::memory_order_relaxed))
+                numOfHeapNodes.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(bytes);
+        }
+        return arena->allocateSlot(bytes);
+    }
+    static inline void deallocate(void* p, size_t bytes)
+    {
+        if (isArenaNode(p))
+            deallocateSlot(p, bytes);
+        else
+            ::operator delete(p);
+    }
+    //@}
+
+    /// Statistics over all arenas, only counted once an arena has been pushed
+    //@{
+    /// Number of nodes allocated from the heap.
+    static inline size_t getNumOfHeapNodes()
+    {
+        return numOfHeapNodes.load(std::memory_order_relaxed);
+    }
+    /// Number of nodes allocated from arenas.
+    static inline size_t getNumOfArenaNodes()
+    {
+        return numOfArenaNodes.load(std::memory_order_relaxed);
+    }
+    /// Number of blocks allocated by arenas.
+    static inline size_t getNumOfBlocks()
+    {
+        return numOfBlocks.load(std::memory_order_relaxed);
+    }
+    //@}
+
+private:
+    /// Free lists and unused part of a block of one thread for one arena.
+    struct ThreadCache
+    {
+        SparseBitVectorArena* arena;
+        size_t arenaId;
+        void* freeLists[MaxSlotSize / SlotAlign];
+        char* top;
+        char* end;
+    };
+
+    static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= SlotAlign, "heap nodes would look like arena nodes");
+
+    SparseBitVectorArena();
+    ~SparseBitVectorArena();
+
+    /// Arena nodes are the only ones which do not start at a multiple of SlotAlign.
+    static inline bool isArenaNode(void* p)
+    {
+        return (reinterpret_cast<uintptr_t>(p) & (SlotAlign - 1)) == SlotOffset;
+    }
+    void* allocateSlot(size_t bytes);
+    static void deallocateSlot(void* p, size_t bytes);
+
+    /// The free lists of this arena of the calling thread.
+    ThreadCache& getThreadCache();
+    /// Refill the free list of slot in cache, or give it a new block.
+    void refill(ThreadCache& cache, size_t slot);
+    /// Give the free slots and the unused block of an exiting thread back.
+    void giveBack(ThreadCache& cache);
+    /// Drop a reference (a live node, or the stack) and delete this arena at the last one.
+    void unref();
+    /// Whether the arena of cache has not been deleted (the lock of the arena list must be held).
+    static bool isLive(const ThreadCache& cache);
+
+    friend struct ThreadCaches;
+
+    size_t id;
+    /// Live nodes, plus one until the arena is released.
+    std::atomic<size_t> refs;
+    /// Free slots and unused parts of blocks given back by exited threads.
+    void* freeLists[MaxSlotSize / SlotAlign];
+    std::vector<std::pair<char*, char*>> spareBlocks;
+    std::vector<char*> blocks;
+    /// Guards the members above (but id and refs).
+    std::mutex mutex;
+
+    static std::atomic<SparseBitVectorArena*> current;
+    /// Whether heap nodes are counted: without arenas, every SparseBitVector
+    /// element would otherwise hit the shared counter.
+    static std::atomic<bool> countHeapNodes;
+    static std::atomic<size_t> numOfHeapNodes;
+    static std::atomic<size_t> numOfArenaNodes;
+    static std::atomic<size_t> numOfBlocks;
+};
+
+/// Allocator for the element lists of SparseBitVectors, which takes its nodes
+/// from the arena that is current when a node is allocated. It is stateless:
+/// nodes of different arenas can be in the same list.
+template <typename T>
+class SparseBitVectorAllocator
+{
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    SparseBitVectorAllocator() = default;
+
+    template <typename U>
+    SparseBitVectorAllocator(const SparseBitVectorAllocator<U>&) {}
+
+    T* allocate(size_t n)
+    {
+        static_assert(alignof(T) <= SparseBitVectorArena::SlotOffset, "over-aligned SparseBitVector node");
+        return static_cast<T*>(SparseBitVectorArena::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+        SparseBitVectorArena::deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const SparseBitVectorAllocator<U>&) const
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const SparseBitVectorAllocator<U>&) const
+    {
+        return false;
+    }
+};
+
 template <unsigned ElementSize = 128>
 class SparseBitVector
 {
     friend class SVFIRWriter;
     friend class SVFIRReader;
 
-    using ElementList = std::list<SparseBitVectorElement<ElementSize>>;
+    using ElementList = std::list<SparseBitVectorElement<ElementSize>,
+          SparseBitVectorAllocator<SparseBitVectorElement<ElementSize>>>;
     using ElementListIter = typename ElementList::iterator;
     using ElementListConstIter = typename ElementList::const_iterator;
     enum
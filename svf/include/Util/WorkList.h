@@ -43,6 +43,10 @@
 #include <vector>
 #include <deque>
 #include <set>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <algorithm>
 
 namespace SVF
 {
@@ -312,6 +316,91 @@ private:
     DataVector data_list;    ///< work list using std::vector.
 };
 
+/**
+ * Worklist over a fixed batch of data shared by several worker threads.
+ * The batch is split into one contiguous range per worker. A worker pops
+ * from its own range first and steals from the ranges of other workers
+ * once its own range is drained, so no pop ever blocks.
+ */
+template<class Data>
+class WorkStealingList
+{
+    typedef std::vector<Data> DataVector;
+public:
+    WorkStealingList(const DataVector& data, u32_t workers)
+        : data_list(data), numOfWorkers(workers),
+          fronts(new std::atomic<size_t>[workers]), ends(workers)
+    {
+        assert(workers > 0 && "need at least one worker");
+        size_t chunk = (data.size() + workers - 1) / workers;
+        for (u32_t i = 0; i < workers; ++i)
+        {
+            fronts[i].store(std::min(data.size(), i * chunk));
+            ends[i] = std::min(data.size(), (i + 1) * chunk);
+        }
+    }
+
+    ~WorkStealingList() {}
+
+    inline u32_t workers() const
+    {
+        return numOfWorkers;
+    }
+
+    /**
+     * Pop a data for worker tid, stealing from other workers if needed.
+     * Return false once all ranges are drained.
+     */
+    inline bool pop(u32_t tid, Data& data)
+    {
+        for (u32_t i = 0; i < numOfWorkers; ++i)
+        {
+            u32_t victim = (tid + i) % numOfWorkers;
+            size_t idx = fronts[victim].fetch_add(1, std::memory_order_relaxed);
+            if (idx < ends[victim])
+            {
+                data = data_list[idx];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Apply fn(data, tid) to every data in the batch using the given number
+     * of worker threads (runs in the calling thread when there is only one).
+     */
+    template<class Fn>
+    static void forEach(const DataVector& data, u32_t workers, Fn fn)
+    {
+        if (workers <= 1 || data.size() <= 1)
+        {
+            for (const Data& d : data)
+                fn(d, 0);
+            return;
+        }
+        WorkStealingList<Data> list(data, workers);
+        auto worker = [&list, &fn](u32_t tid)
+        {
+            Data d;
+            while (list.pop(tid, d))
+                fn(d, tid);
+        };
+        std::vector<std::thread> threads;
+        for (u32_t i = 1; i < workers; ++i)
+            threads.push_back(std::thread(worker, i));
+        worker(0);
+        for (std::thread& t : threads)
+            t.join();
+    }
+
+private:
+    const DataVector& data_list;    ///< the batch of data (owned by the caller).
+    u32_t numOfWorkers;    ///< number of workers.
+    std::unique_ptr<std::atomic<size_t>[]> fronts;    ///< next unclaimed index of each range.
+    std::vector<size_t> ends;    ///< end (exclusive) of each range.
+};
+
 } // End namespace SVF
 
 #endif /* WORKLIST_H_ */
@@ -78,6 +78,8 @@ public:
 
     virtual void readPtsFromFile(const std::string& filename);
 
+    virtual void solveIncrementally(const std::string& filename);
+
     virtual void solveConstraints();
 
     /// Initialize analysis
@@ -161,6 +163,14 @@ public:
     static u32_t numOfProcessedStore;  /// Number of processed Store edge
     static u32_t numOfSfrs;
     static u32_t numOfFieldExpand;
+    static u32_t numOfParallelLevels;  /// Number of wave levels propagated by more than one thread
+    static u32_t numOfDeferredGeps;    /// Number of field objects created after a parallel propagation
+    static u32_t numOfIncChangedScopes;  /// Number of functions and globals changed since the snapshot
+    static u32_t numOfIncReusedPts;      /// Number of points-to sets reused from the snapshot
+    static u32_t numOfIncResetPts;       /// Number of points-to sets of the snapshot recomputed
+    static u64_t numOfIncBaselineWork;   /// Number of edges processed by the full solve of the snapshot
+    static double timeOfIncBaselineSolve; /// Time of the full solve of the snapshot
+    static double timeOfIncSolve;         /// Time of loading the snapshot and solving from it
 
     static u32_t numOfSCCDetection;
     static double timeOfSCCDetection;
@@ -174,6 +184,8 @@ public:
     //@}
 
 protected:
+    friend class AndersenSnapshot;
+
     /// Constraint Graph
     ConstraintGraph* consCG;
     CallSite2DummyValPN
@@ -195,7 +207,7 @@ public:
 
     /// Constructor
     Andersen(SVFIR* _pag, PTATY type = Andersen_WPA, bool alias_check = true)
-        :  AndersenBase(_pag, type, alias_check)
+        :  AndersenBase(_pag, type, alias_check), wavesFromWorklist(false)
     {
     }
 
@@ -261,6 +273,7 @@ public:
     }
 
 protected:
+    friend class AndersenSnapshot;
 
     CallSite2DummyValPN callsite2DummyValPN;        ///< Map an instruction to a dummy obj which created at an indirect callsite, which invokes a heap allocator
 
@@ -325,6 +338,8 @@ protected:
         if (consCG->addCopyCGEdge(src, dst))
         {
             updatePropaPts(src, dst);
+            if (wavesFromWorklist)
+                waveCandidates.insert(src);
             return true;
         }
         return false;
@@ -354,6 +369,12 @@ protected:
     /// SCC detection
     virtual NodeStack& SCCDetect();
 
+    /// Set once a snapshot is loaded: only the nodes in the worklist and the sources
+    /// of new copy edges have points-to sets which are not propagated yet, so SCC
+    /// detection and the waves are restricted to what is reachable from them.
+    bool wavesFromWorklist;
+    NodeSet waveCandidates;
+
 
 
     /// Sanitize pts for field insensitive objects
@@ -430,6 +451,45 @@ public:
     virtual bool handleStore(NodeID id, const ConstraintEdge* store);
 };
 
+/**
+ * Multi-threaded wave propagation with diff points-to set (-ander-threads=N).
+ * After SCC detection and merging, the nodes of a wave are grouped into
+ * topological levels. The copy/gep propagation into the successors of a level
+ * is computed by N workers, each successor being owned by exactly one worker,
+ * and only the newly derived points-to targets are committed sequentially.
+ * Load/store handling and field collapsing stay sequential, so the result is
+ * the same as AndersenWaveDiff.
+ */
+class AndersenParallel : public AndersenWaveDiff
+{
+
+public:
+    typedef std::vector<const ConstraintEdge*> EdgeVector;
+    /// A field object which has to be created sequentially: <index of dst, gep edge, object>
+    typedef std::tuple<u32_t, const NormalGepCGEdge*, NodeID> DeferredGep;
+
+    AndersenParallel(SVFIR* _pag, PTATY type = AndersenWaveDiff_WPA, bool alias_check = true): AndersenWaveDiff(_pag, type, alias_check) {}
+
+    virtual void solveWorklist();
+
+protected:
+    /// Group the nodes of a wave by their topological level
+    void computeLevels(NodeStack& nodeStack, std::vector<NodeVector>& levels);
+
+    /// Propagate the diff points-to sets of all nodes in a level to their successors
+    void processLevel(const NodeVector& level);
+
+    /// Compute the points-to targets flowing into dst through edges of the current level
+    void collectIncomingPts(const EdgeVector& inEdges, u32_t dstIdx, PointsTo& pts,
+                            std::vector<DeferredGep>& deferred);
+
+    /// Get PTA name
+    virtual const std::string PTAName() const
+    {
+        return "AndersenParallelWPA";
+    }
+};
+
 } // End namespace SVF
 
 #endif /* INCLUDE_WPA_ANDERSEN_H_ */
@@ -0,0 +1,155 @@
+//===- AndersenSnapshot.h -- Snapshots for incremental Andersen's analysis ----//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenSnapshot.h
+ *
+ * Snapshots of Andersen's analysis for re-solving an edited program (-ander-snapshot).
+ *
+ * A snapshot is a -write-ander file with extra sections describing the SVFIR and
+ * the constraint graph it was solved on. Node IDs are not stable across builds of
+ * an edited program, so SVFIR variables are matched by a key: their scope (the
+ * function they belong to, or their name for globals), their kind and their
+ * IR name, or their ordinal among the unnamed variables of that scope and kind
+ * which are or are not pointers alike. Every scope also has a
+ * digest of its variables and statements, which tells which functions changed.
+ *
+ * Loading a snapshot maps the old variables to the new ones by key, in changed
+ * scopes too, and resets the variables that may depend on a deleted constraint:
+ * the variables without a new counterpart, the targets of deleted statements, the
+ * parameters connected at indirect callsites whose caller or callee changed its
+ * argument lists (as told by a second digest of those lists), and everything
+ * reachable from them in the old constraint graph, including the copy edges solved
+ * for loads, stores and indirect calls and the objects stored into through reset
+ * pointers. A variable mapped to a different one in a changed scope only differs in
+ * its statements, which are deleted and added ones. All other variables start from
+ * their old points-to sets, which are below the new solution, so solving from there
+ * yields the same result as solving from scratch. If more than half of the
+ * non-empty sets are reset, the program is solved from scratch instead.
+ *
+ * The copy edges derived between kept variables are restored as well, so that a
+ * kept variable is only processed again if one of its constraints is new or
+ * involves a reset variable; the others are marked as already propagated, and
+ * the waves of AndersenWaveDiff skip the part of the graph they cannot reach.
+ */
+
+#ifndef INCLUDE_WPA_ANDERSENSNAPSHOT_H_
+#define INCLUDE_WPA_ANDERSENSNAPSHOT_H_
+
+#include "MemoryModel/PointsToFile.h"
+
+namespace SVF
+{
+
+class AndersenBase;
+class SVFIR;
+class SVFVar;
+
+class AndersenSnapshot
+{
+public:
+    /// (scope, kind and name or ordinal) of a variable
+    typedef std::pair<u64_t, u64_t> VarKey;
+    /// (kind, src, dst, field offset) of a statement edge
+    typedef std::tuple<u32_t, NodeID, NodeID, APOffset> StmtEdgeRecord;
+
+    /// Old constraint graph records: the kinds of ConstraintEdge, plus these
+    enum ExtraEdgeKind : u32_t
+    {
+        RepEdge = 16,       ///< (sub, rep) of a collapsed SCC
+        IndCallEdge,        ///< (function pointer, parameter or return receiver connected through it)
+        StmtEdge = 32       ///< edges of the initial graph are recorded with their kind plus StmtEdge
+    };
+
+    /// Compute the keys and digests of the current SVFIR; to be called before solving.
+    AndersenSnapshot(AndersenBase* p);
+
+    /// Seed the analysis with the reusable part of the solution in filename.
+    /// Return false if filename cannot be read.
+    bool load(const std::string& filename);
+
+    /// Store the solution, the SVFIR keys and digests and the constraint graph into filename.
+    void write(const std::string& filename);
+
+    /// Statistics of the last load
+    //@{
+    inline u32_t getNumOfChangedScopes() const
+    {
+        return numOfChangedScopes;
+    }
+    inline u32_t getNumOfReusedVars() const
+    {
+        return numOfReusedVars;
+    }
+    inline u32_t getNumOfResetVars() const
+    {
+        return numOfResetVars;
+    }
+    /// Edges processed by the full solve the snapshot derives from
+    inline u64_t getBaselineWork() const
+    {
+        return baselineWork;
+    }
+    /// Time of the full solve the snapshot derives from
+    inline double getBaselineTime() const
+    {
+        return baselineTime;
+    }
+    //@}
+
+    /// Edges processed so far by Andersen's analysis
+    static u64_t getWork();
+
+private:
+    /// Scope of var: its function, or its name for globals
+    u64_t getScope(const SVFVar* var) const;
+    /// Hash of the key of var, recursing into the bases of field objects
+    u64_t hashVar(NodeID id) const;
+
+    void computeKeys();
+    void computeDigests();
+    void recordStmtEdges();
+
+    AndersenBase* pta;
+    SVFIR* pag;
+
+    /// Variables created before solving; the others have no key
+    NodeID numOfInitialNodes;
+    std::vector<VarKey> keys;
+    std::vector<bool> hasKey;
+    Map<VarKey, NodeID> keyToVar;
+    Map<u64_t, u64_t> scopeDigests;
+    /// Digests of the argument lists bound at the indirect calls of each scope
+    Map<u64_t, u64_t> bindingDigests;
+    /// Edges of the constraint graph before solving
+    std::vector<StmtEdgeRecord> stmtEdges;
+
+    u32_t numOfChangedScopes;
+    u32_t numOfReusedVars;
+    u32_t numOfResetVars;
+    u64_t baselineWork;
+    double baselineTime;
+};
+
+} // End namespace SVF
+
+#endif /* INCLUDE_WPA_ANDERSENSNAPSHOT_H_ */
@@ -69,6 +69,9 @@ public:
         numOfProcessedPhi = numOfProcessedActualParam = numOfProcessedFormalRet = 0;
         numOfProcessedMSSANode = 0;
         maxSCCSize = numOfSCC = numOfNodesInSCC = 0;
+        numOfParallelLevels = numOfSkippedProps = 0;
+        numOfParallelSCCs = numOfDeferredSCCs = 0;
+        parallelPropaTime = parallelSolveTime = 0;
         iterationForPrintStat = OnTheFlyIterBudgetForStat;
     }
 
@@ -296,6 +299,10 @@ protected:
     u32_t maxSCCSize;
     u32_t numOfSCC;
     u32_t numOfNodesInSCC;
+    u32_t numOfParallelLevels;	///< Number of SCC levels whose propagation was checked by more than one thread
+    u32_t numOfSkippedProps;	///< Number of propagations found not to add any target by the workers
+    u32_t numOfParallelSCCs;	///< Number of SCCs solved by the workers
+    u32_t numOfDeferredSCCs;	///< Number of SCCs solved again sequentially as they had to change the SVFIR
 
     double solveTime;	///< time of solve.
     double sccTime;	///< time of SCC detection.
@@ -311,6 +318,8 @@ protected:
     double storeTime;	///< time of store edges
     double phiTime;	///< time of phi nodes.
     double updateCallGraphTime; ///< time of updating call graph
+    double parallelPropaTime; ///< time of checking propagations in worker threads
+    double parallelSolveTime; ///< time of solving SCCs in worker threads
 
     NodeBS svfgHasSU;
     //@}
@@ -318,6 +327,118 @@ protected:
     void svfgStat();
 };
 
+/*!
+ * Multi-threaded flow-sensitive analysis (-fs-threads=N).
+ * The SCCs of the SVFG are grouped into topological levels and solved level by
+ * level, so every SCC is solved once after all of its predecessors. The SCCs of
+ * a level are not connected to each other and are solved by N workers. Each
+ * worker only writes the points-to data of the nodes of its SCCs and of the
+ * variables they define, through the IDs of the (thread-safe) persistent
+ * points-to cache. The propagations along the edges leaving a level are done
+ * once all of its SCCs are solved. The result is the same as FlowSensitive.
+ */
+class FlowSensitiveParallel : public FlowSensitive
+{
+
+public:
+    /// Propagation of an object along an indirect edge
+    typedef std::pair<const IndirectSVFGEdge*, NodeID> IndirectProp;
+
+    explicit FlowSensitiveParallel(SVFIR* _pag, PTATY type = FSSPARSE_WPA) : FlowSensitive(_pag, type)
+    {
+        solvingInParallel = parallelPtsData = false;
+        numOfInitialisedPAGNodes = 0;
+    }
+
+    /// Get PTA name
+    const std::string PTAName() const override
+    {
+        return "FlowSensitiveParallel";
+    }
+
+    /// Initialize analysis
+    void initialize() override;
+
+protected:
+    void initWorklist() override;
+
+    void solveWorklist() override;
+
+    /// Group the SCCs of topoOrder (by their representatives) into topological levels
+    void computeLevels(std::vector<NodeVector>& levels);
+
+    /// Create the points-to entries of every SVFG node and SVFIR variable, so
+    /// that the workers never insert into the maps shared by all of them
+    void initParallelPtsData();
+
+    /// Solve the SCCs of a level, collecting the nodes which have to propagate out of them
+    void solveLevel(const NodeVector& level, NodeBS& changedNodes);
+
+    /// Solve the SCC of rep with the worklist of worker tid
+    void solveSCC(NodeID rep, NodeBS& changedNodes, u32_t tid);
+
+    /// Propagate from the changed nodes of a level to the later levels
+    void propagateLevel(const NodeBS& changedNodes);
+
+    /// Whether prop can add a points-to target (run by the workers)
+    bool mayAddPts(const IndirectProp& prop);
+
+    /// Node counts and strong updates of a worker, added to the statistics of
+    /// FlowSensitive once the workers of a level are done
+    struct WorkerStat
+    {
+        u32_t numOfProcessedAddr = 0;
+        u32_t numOfProcessedCopy = 0;
+        u32_t numOfProcessedGep = 0;
+        u32_t numOfProcessedPhi = 0;
+        u32_t numOfProcessedLoad = 0;
+        u32_t numOfProcessedStore = 0;
+        u32_t numOfProcessedMSSANode = 0;
+        NodeBS strongUpdates;	///< stores last processed as strong updates
+        NodeBS weakUpdates;	///< stores last processed as weak updates
+    };
+
+    /// Process a node in a worker, as processSVFGNode but without writing the
+    /// statistics shared by all workers (the time of each kind of node is not
+    /// recorded)
+    bool processNodeInWorker(SVFGNode* node, WorkerStat& ws);
+    /// Process a gep node in a worker: the SCC of the gep is deferred if the gep
+    /// would have to create a field object or collapse an object
+    bool processGepInWorker(const GepSVFGNode* edge);
+    bool processLoadInWorker(const LoadSVFGNode* load);
+    bool processStoreInWorker(const StoreSVFGNode* store, WorkerStat& ws);
+    /// Propagate along edge in a worker, as propFromSrcToDst
+    bool propInWorker(const SVFGEdge* edge);
+    /// Add the statistics of the workers to those of FlowSensitive
+    void mergeWorkerStats();
+
+    /// Whether src and dst are in the same SCC
+    inline bool inSameSCC(NodeID src, NodeID dst) const
+    {
+        return nodeToSCC[src] == nodeToSCC[dst];
+    }
+
+    /// Representatives of the SVFG SCCs in topological order
+    NodeVector topoOrder;
+    /// Position in topoOrder of the SCC of each SVFG node
+    std::vector<u32_t> nodeToSCC;
+    /// Worklists of solveSCC (one per worker), kept to reuse their storage
+    std::vector<FIFOWorkList<NodeID>> sccWorklists;
+    /// Statistics of solveSCC (one per worker)
+    std::vector<WorkerStat> workerStats;
+    /// Whether each SVFG node received new data from propagateLevel
+    std::vector<u8_t> changedDsts;
+    /// Whether the SCC at each position of topoOrder met a gep node which has to
+    /// create a field object or collapse an object (only written by its worker)
+    std::vector<u8_t> deferredSCCs;
+    /// Whether the SCCs are being solved by the workers
+    bool solvingInParallel;
+    /// Whether the points-to data supports updates from several workers
+    bool parallelPtsData;
+    /// Number of SVFIR nodes when the points-to entries were created
+    u32_t numOfInitialisedPAGNodes;
+};
+
 } // End namespace SVF
 
 #endif /* FLOWSENSITIVEANALYSIS_H_ */
@@ -37,7 +37,8 @@ private:
     typedef CoreBitVector MeldVersion;
 
 public:
-    typedef Map<NodeID, Version> ObjToVersionMap;
+    /// Versions of objects at a location, sorted by object.
+    typedef std::vector<std::pair<NodeID, Version>> ObjToVersionMap;
     typedef Map<VersionedVar, const DummyVersionPropSVFGNode *> VarToPropNodeMap;
 
     typedef std::vector<ObjToVersionMap> LocVersionMap;
@@ -102,6 +103,12 @@ protected:
     virtual void processNode(NodeID n) override;
     virtual void updateConnectedNodes(const SVFGEdgeSetTy& newEdges) override;
 
+    /// With -vfs-threads > 1, solves in rounds: the nodes in the worklist other
+    /// than loads and stores are processed one at a time, then the loads, the
+    /// stores and the version propagation of the round are processed object by
+    /// object with several threads (see processByObject).
+    virtual void solveWorklist() override;
+
     /// Override to do nothing. Instead, we will use propagateVersion when necessary.
     virtual bool propAlongIndirectEdge(const IndirectSVFGEdge*) override
     {
@@ -116,6 +123,40 @@ private:
     void prelabel(void);
     /// Meld label the prelabeled SVFG.
     void meldLabel(void);
+    /// Work of a round on one object o.
+    struct ObjectWork
+    {
+        /// (l, pts(q)) for the stores l: *p = q with o in pts(p).
+        std::vector<std::pair<NodeID, PointsToID>> stores;
+        /// (l, c) for the stores l through which o:c flows to the version of o l yields.
+        std::vector<std::pair<NodeID, Version>> weakStores;
+        /// (i, l) for the i-th load of the round, l: p = *q, reading o.
+        std::vector<std::pair<u32_t, NodeID>> loads;
+        /// Versions of o which changed and have yet to be propagated.
+        std::vector<Version> versions;
+    };
+
+    /// What the work of a round on one object changes, to be written to vPtD.
+    struct ObjectResult
+    {
+        /// Versions of o which changed, with their new points-to sets.
+        std::vector<std::pair<Version, PointsToID>> versions;
+        /// (i, pts(o:c)) to be unioned into the pointer defined by the i-th load.
+        std::vector<std::pair<u32_t, PointsToID>> loads;
+        /// Stores which changed a version of o.
+        std::vector<NodeID> stores;
+    };
+
+    /// Processes loads and stores, and propagates pendingVersions, one object
+    /// per task with several threads. Each task only reads vPtD; the versions,
+    /// pointers and statements which changed are then updated sequentially.
+    void processByObject(const std::vector<const LoadSVFGNode *> &loads,
+                         const std::vector<const StoreSVFGNode *> &stores);
+
+    /// Does the work of a round on o without writing to vPtD. Called by the
+    /// worker threads.
+    void processObject(const NodeID o, const ObjectWork &work, ObjectResult &result) const;
+
     /// Melds v2 into v1 (in place), returns whether a change occurred.
     static bool meld(MeldVersion &mv1, const MeldVersion &mv2);
 
@@ -185,7 +226,7 @@ private:
 
     void writeVersionedAnalysisResultToFile(const std::string& filename);
 
-    void readVersionedAnalysisResultFromFile(std::ifstream& F);
+    void readVersionedAnalysisResultFromFile(PointsToFileReader& F);
 
     void readPtsFromFile(const std::string& filename) override;
 
@@ -221,6 +262,17 @@ private:
     /// Points-to DS for working with versions.
     BVDataPTAImpl::VersionedPTDataTy *vPtD;
 
+    /// vPtD when it is persistent, which version propagation with several
+    /// threads requires (nullptr otherwise).
+    BVDataPTAImpl::PersVersionedPTDataTy *persVPtD;
+
+    /// Number of threads propagating versions in the main phase.
+    u32_t versionPropThreads;
+
+    /// Versions of objects which changed and have yet to be propagated to the
+    /// versions relying on them (only used with several threads).
+    Map<NodeID, std::vector<Version>> pendingVersions;
+
     /// deltaMap[l] means SVFG node l is a delta node, i.e., may get new
     /// incoming edges due to OTF callgraph construction.
     std::vector<bool> deltaMap;
@@ -244,6 +296,9 @@ private:
     double prelabelingTime;  ///< Time to prelabel SVFG.
     double meldLabelingTime; ///< Time to meld label SVFG.
     double versionPropTime;  ///< Time to propagate versions to versions which rely on them.
+    double objectRoundTime;  ///< Time of the loads, stores and version propagation done by object.
+    u32_t numOfVersionPropRounds; ///< Number of rounds of loads, stores and version propagation done by object.
+    std::vector<double> versioningThreadUtil; ///< Busy time over meld labeling time of each versioning thread.
     //@}
 
     static VersionedFlowSensitive *vfspta;
@@ -56,44 +56,88 @@ u32_t AbstractState::hash() const
     return pairH({h, h2});
 }
 
-AbstractState AbstractState::widening(const AbstractState& other)
+/// Apply op to each value of lhs whose key is also in rhs.
+/// Chunks shared by lhs and rhs are skipped, as op(v, v) == v for all lattice
+/// operations below, so only the chunks in which the maps differ are visited.
+template<typename Op>
+static void updateCommonVals(AbstractState::VarToAbsValMap& lhs, const AbstractState::VarToAbsValMap& rhs, Op op)
 {
-    // widen interval
-    AbstractState es = *this;
-    for (auto it = es._varToAbsVal.begin(); it != es._varToAbsVal.end(); ++it)
+    if (lhs.sharesAll(rhs))
+        return;
+    for (u32_t i = 0; i < AbstractState::VarToAbsValMap::NumOfChunks; ++i)
     {
-        auto key = it->first;
-        if (other._varToAbsVal.find(key) != other._varToAbsVal.end())
-            if (it->second.isInterval() && other._varToAbsVal.at(key).isInterval())
-                it->second.getInterval().widen_with(other._varToAbsVal.at(key).getInterval());
+        if (lhs.sharesChunk(rhs, i) || lhs.getChunk(i).empty() || rhs.getChunk(i).empty())
+            continue;
+        const AbstractState::VarToAbsValMap::Chunk& rhsChunk = rhs.getChunk(i);
+        for (auto& item : lhs.getMutableChunk(i))
+        {
+            auto it = rhsChunk.find(item.first);
+            if (it != rhsChunk.end())
+                op(item.second, it->second);
+        }
     }
-    for (auto it = es._addrToAbsVal.begin(); it != es._addrToAbsVal.end(); ++it)
+}
+
+/// Join rhs into lhs. A chunk of rhs is shared rather than copied when lhs has no entries in it.
+static void joinVals(AbstractState::VarToAbsValMap& lhs, const AbstractState::VarToAbsValMap& rhs)
+{
+    if (lhs.sharesAll(rhs))
+        return;
+    if (lhs.empty())
     {
-        auto key = it->first;
-        if (other._addrToAbsVal.find(key) != other._addrToAbsVal.end())
-            if (it->second.isInterval() && other._addrToAbsVal.at(key).isInterval())
-                it->second.getInterval().widen_with(other._addrToAbsVal.at(key).getInterval());
+        lhs = rhs;
+        return;
     }
+    for (u32_t i = 0; i < AbstractState::VarToAbsValMap::NumOfChunks; ++i)
+    {
+        const AbstractState::VarToAbsValMap::Chunk& rhsChunk = rhs.getChunk(i);
+        if (lhs.sharesChunk(rhs, i) || rhsChunk.empty())
+            continue;
+        if (lhs.getChunk(i).empty())
+        {
+            lhs.shareChunk(rhs, i);
+            continue;
+        }
+        AbstractState::VarToAbsValMap::Chunk& lhsChunk = lhs.getMutableChunk(i);
+        for (const auto& item : rhsChunk)
+        {
+            auto oit = lhsChunk.find(item.first);
+            if (oit != lhsChunk.end())
+            {
+                oit->second.join_with(item.second);
+            }
+            else
+            {
+                lhsChunk.emplace(item.first, item.second);
+            }
+        }
+    }
+}
+
+AbstractState AbstractState::widening(const AbstractState& other)
+{
+    // widen interval
+    AbstractState es = *this;
+    auto widen = [](AbstractValue& val, const AbstractValue& otherVal)
+    {
+        if (val.isInterval() && otherVal.isInterval())
+            val.getInterval().widen_with(otherVal.getInterval());
+    };
+    updateCommonVals(es._varToAbsVal, other._varToAbsVal, widen);
+    updateCommonVals(es._addrToAbsVal, other._addrToAbsVal, widen);
     return es;
 }
 
 AbstractState AbstractState::narrowing(const AbstractState& other)
 {
     AbstractState es = *this;
-    for (auto it = es._varToAbsVal.begin(); it != es._varToAbsVal.end(); ++it)
-    {
-        auto key = it->first;
-        if (other._varToAbsVal.find(key) != other._varToAbsVal.end())
-            if (it->second.isInterval() && other._varToAbsVal.at(key).isInterval())
-                it->second.getInterval().narrow_with(other._varToAbsVal.at(key).getInterval());
-    }
-    for (auto it = es._addrToAbsVal.begin(); it != es._addrToAbsVal.end(); ++it)
+    auto narrow = [](AbstractValue& val, const AbstractValue& otherVal)
     {
-        auto key = it->first;
-        if (other._addrToAbsVal.find(key) != other._addrToAbsVal.end())
-            if (it->second.isInterval() && other._addrToAbsVal.at(key).isInterval())
-                it->second.getInterval().narrow_with(other._addrToAbsVal.at(key).getInterval());
-    }
+        if (val.isInterval() && otherVal.isInterval())
+            val.getInterval().narrow_with(otherVal.getInterval());
+    };
+    updateCommonVals(es._varToAbsVal, other._varToAbsVal, narrow);
+    updateCommonVals(es._addrToAbsVal, other._addrToAbsVal, narrow);
     return es;
 
 }
@@ -101,55 +145,19 @@ AbstractState AbstractState::narrowing(const AbstractState& other)
 /// domain join with other, important! other widen this.
 void AbstractState::joinWith(const AbstractState& other)
 {
-    for (auto it = other._varToAbsVal.begin(); it != other._varToAbsVal.end(); ++it)
-    {
-        auto key = it->first;
-        auto oit = _varToAbsVal.find(key);
-        if (oit != _varToAbsVal.end())
-        {
-            oit->second.join_with(it->second);
-        }
-        else
-        {
-            _varToAbsVal.emplace(key, it->second);
-        }
-    }
-    for (auto it = other._addrToAbsVal.begin(); it != other._addrToAbsVal.end(); ++it)
-    {
-        auto key = it->first;
-        auto oit = _addrToAbsVal.find(key);
-        if (oit != _addrToAbsVal.end())
-        {
-            oit->second.join_with(it->second);
-        }
-        else
-        {
-            _addrToAbsVal.emplace(key, it->second);
-        }
-    }
+    joinVals(_varToAbsVal, other._varToAbsVal);
+    joinVals(_addrToAbsVal, other._addrToAbsVal);
 }
 
 /// domain meet with other, important! other widen this.
 void AbstractState::meetWith(const AbstractState& other)
 {
-    for (auto it = other._varToAbsVal.begin(); it != other._varToAbsVal.end(); ++it)
-    {
-        auto key = it->first;
-        auto oit = _varToAbsVal.find(key);
-        if (oit != _varToAbsVal.end())
-        {
-            oit->second.meet_with(it->second);
-        }
-    }
-    for (auto it = other._addrToAbsVal.begin(); it != other._addrToAbsVal.end(); ++it)
+    auto meet = [](AbstractValue& val, const AbstractValue& otherVal)
     {
-        auto key = it->first;
-        auto oit = _addrToAbsVal.find(key);
-        if (oit != _addrToAbsVal.end())
-        {
-            oit->second.meet_with(it->second);
-        }
-    }
+        val.meet_with(otherVal);
+    };
+    updateCommonVals(_varToAbsVal, other._varToAbsVal, meet);
+    updateCommonVals(_addrToAbsVal, other._addrToAbsVal, meet);
 }
 
 // getGepObjAddrs
@@ -103,6 +103,8 @@ void AbstractInterpretation::initWTO()
 void AbstractInterpretation::analyse()
 {
     initWTO();
+    // The ICFG is complete once the call graph is resolved, and is only traversed from now on
+    icfg->freeze();
     // handle Global ICFGNode of SVFModule
     handleGlobalNode();
     getAbsStateFromTrace(
@@ -112,6 +114,7 @@ void AbstractInterpretation::analyse()
         ICFGWTO* wto = funcToWTO[cgn];
         handleWTOComponents(wto->getWTOComponents());
     }
+    icfg->thaw();
 }
 
 /// handle global node
@@ -134,7 +137,7 @@ bool AbstractInterpretation::mergeStatesFromPredecessors(const ICFGNode * icfgNo
 {
     std::vector<AbstractState> workList;
     AbstractState preAs;
-    for (auto& edge: icfgNode->getInEdges())
+    for (const ICFGEdge* edge: icfgNode->getInEdgeRange())
     {
         if (abstractTrace.find(edge->getSrcNode()) != abstractTrace.end())
         {
@@ -787,9 +790,9 @@ void AbstractInterpretation::SkipRecursiveCall(const CallICFGNode *callNode)
                 as[retPE->getLHSVarID()] = IntervalValue::top();
         }
     }
-    if (!retNode->getOutEdges().empty())
+    if (!retNode->getOutEdgeRange().empty())
     {
-        if (retNode->getOutEdges().size() == 1)
+        if (retNode->getOutEdgeRange().size() == 1)
         {
 
         }
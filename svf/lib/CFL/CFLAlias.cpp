@@ -207,7 +207,10 @@ void CFLAlias::initialize()
 
 void CFLAlias::initializeSolver()
 {
-    solver = new CFLSolver(graph, grammar);
+    if (Options::CFLThreads() > 1)
+        solver = new CFLParallelSolver(graph, grammar, Options::CFLThreads());
+    else
+        solver = new CFLSolver(graph, grammar);
 }
 
 void CFLAlias::finalize()
@@ -253,3 +256,11 @@ void POCRHybrid::initializeSolver()
 {
     solver = new POCRHybridSolver(graph, grammar);
 }
+
+void CFLMatrixAlias::initializeSolver()
+{
+    if (Options::CFLThreads() > 1)
+        solver = new CFLParallelSolver(graph, grammar, Options::CFLThreads());
+    else
+        solver = new CFLMatrixSolver(graph, grammar);
+}
@@ -28,6 +28,7 @@
  */
 
 #include "CFL/CFLSolver.h"
+#include "Util/SVFStat.h"
 
 using namespace SVF;
 
@@ -378,4 +379,251 @@ void POCRHybridSolver::meld_h(NodeID x, TreeNode* uNode, TreeNode* vNode)
     {
         meld_h(x, newVNode, vChild);
     }
-}
\ No newline at end of file
+}
+u32_t CFLMatrixSolver::getSymbolIdx(Symbol sym)
+{
+    Map<u32_t, u32_t>::const_iterator it = symToIdx.find(sym);
+    if (it != symToIdx.end())
+        return it->second;
+
+    u32_t idx = symbols.size();
+    symToIdx[sym] = idx;
+    symbols.push_back(sym);
+    symProds.emplace_back();
+    succMatrices.emplace_back();
+    predMatrices.emplace_back();
+
+    /// the symbols of the productions may be new as well, so collect them before storing
+    SymbolProds prods;
+    if (grammar->hasProdsFromSingleRHS(sym))
+        for (const Production& prod : grammar->getProdsFromSingleRHS(sym))
+            prods.single.push_back(getSymbolIdx(grammar->getLHSSymbol(prod)));
+    if (grammar->hasProdsFromFirstRHS(sym))
+        for (const Production& prod : grammar->getProdsFromFirstRHS(sym))
+            prods.first.emplace_back(getSymbolIdx(grammar->getLHSSymbol(prod)), getSymbolIdx(grammar->getSecondRHSSymbol(prod)));
+    if (grammar->hasProdsFromSecondRHS(sym))
+        for (const Production& prod : grammar->getProdsFromSecondRHS(sym))
+            prods.second.emplace_back(getSymbolIdx(grammar->getLHSSymbol(prod)), getSymbolIdx(grammar->getFirstRHSSymbol(prod)));
+    symProds[idx] = std::move(prods);
+    return idx;
+}
+
+bool CFLMatrixSolver::addGraphEdge(const CFLEdge* edge)
+{
+    u32_t Y = getSymbolIdx(edge->getEdgeKind());
+    NodeID src = edge->getSrcID();
+    NodeID dst = edge->getDstID();
+    if (!succMatrices[Y][src].test_and_set(dst))
+        return false;
+    predMatrices[Y][dst].set(src);
+
+    RowKey key(Y, src);
+    rowDeltas[key].set(dst);
+    rowWorklist.push(key);
+    return true;
+}
+
+u32_t CFLMatrixSolver::addDerivedEdges(u32_t X, NodeID src, const NodeBS& dsts)
+{
+    if (dsts.empty())
+        return 0;
+
+    NodeBS& row = succMatrices[X][src];
+    NodeBS newDsts = dsts;
+    newDsts.intersectWithComplement(row);
+    if (newDsts.empty())
+        return 0;
+    row |= newDsts;
+
+    Matrix& preds = predMatrices[X];
+    for (NodeID dst : newDsts)
+        preds[dst].set(src);
+
+    RowKey key(X, src);
+    rowDeltas[key] |= newDsts;
+    rowWorklist.push(key);
+    derivedEdges[key] |= newDsts;
+    return newDsts.count();
+}
+
+template<typename AddEdges>
+void CFLMatrixSolver::joinRow(u32_t Y, NodeID src, const NodeBS& dsts, double& checks, AddEdges addEdges)
+{
+    const SymbolProds& prods = symProds[Y];
+
+    /// For each production X -> Y
+    ///     add X(i,j) for every j in dsts
+    for (u32_t X : prods.single)
+    {
+        checks += dsts.count();
+        addEdges(X, src, dsts);
+    }
+
+    /// For each production X -> Y Z
+    ///     add X(i,k) for every k in the union of the Z rows of dsts
+    for (const std::pair<u32_t, u32_t>& prod : prods.first)
+    {
+        const Matrix& zSuccs = succMatrices[prod.second];
+        NodeBS newDsts;
+        for (NodeID j : dsts)
+        {
+            Matrix::const_iterator it = zSuccs.find(j);
+            if (it != zSuccs.end())
+            {
+                checks += it->second.count();
+                newDsts |= it->second;
+            }
+        }
+        if (!newDsts.empty())
+            addEdges(prod.first, src, newDsts);
+    }
+
+    /// For each production X -> Z Y
+    ///     add dsts to the X row of every Z predecessor k of i
+    for (const std::pair<u32_t, u32_t>& prod : prods.second)
+    {
+        Matrix::const_iterator it = predMatrices[prod.second].find(src);
+        if (it == predMatrices[prod.second].end())
+            continue;
+        /// copied since addEdges may change the Z matrix, which may be the X matrix
+        NodeBS zPreds = it->second;
+        for (NodeID k : zPreds)
+        {
+            checks += dsts.count();
+            addEdges(prod.first, k, dsts);
+        }
+    }
+}
+
+void CFLMatrixSolver::processRow(u32_t Y, NodeID src, const NodeBS& dsts)
+{
+    joinRow(Y, src, dsts, numOfChecks, [this](u32_t X, NodeID k, const NodeBS& newDsts)
+    {
+        addDerivedEdges(X, k, newDsts);
+    });
+}
+
+void CFLMatrixSolver::initialize()
+{
+    for (const CFLEdge* edge : graph->getCFLEdges())
+        addGraphEdge(edge);
+    addEpsilonEdges();
+}
+
+void CFLMatrixSolver::addEpsilonEdges()
+{
+    /// Foreach production X -> epsilon
+    ///     add X(i,i) for each node i not handled yet
+    for (auto it = graph->begin(); it != graph->end(); it++)
+    {
+        if (!epsilonNodes.test_and_set(it->first))
+            continue;
+        NodeBS self;
+        self.set(it->first);
+        for (const Production& prod : grammar->getEpsilonProds())
+            addDerivedEdges(getSymbolIdx(grammar->getLHSSymbol(prod)), it->first, self);
+    }
+}
+
+void CFLMatrixSolver::processCFLEdge(const CFLEdge* Y_edge)
+{
+    u32_t Y = getSymbolIdx(Y_edge->getEdgeKind());
+    NodeID src = Y_edge->getSrcID();
+    NodeID dst = Y_edge->getDstID();
+    if (succMatrices[Y][src].test_and_set(dst))
+        predMatrices[Y][dst].set(src);
+
+    NodeBS dsts;
+    dsts.set(dst);
+    processRow(Y, src, dsts);
+}
+
+void CFLMatrixSolver::solve()
+{
+    /// nodes may have been added since the last run, e.g., when the call graph is updated
+    addEpsilonEdges();
+
+    while (!rowWorklist.empty())
+    {
+        /// Select and remove a row delta Y(i, dsts) from worklist
+        RowKey key = rowWorklist.pop();
+        Map<RowKey, NodeBS>::iterator it = rowDeltas.find(key);
+        assert(it != rowDeltas.end() && "no delta for a queued row?");
+        NodeBS dsts = std::move(it->second);
+        rowDeltas.erase(it);
+        processRow(key.first, key.second, dsts);
+    }
+
+    flushDerivedEdges();
+}
+
+void CFLMatrixSolver::flushDerivedEdges()
+{
+    for (const auto& it : derivedEdges)
+    {
+        CFLNode* src = graph->getGNode(it.first.second);
+        Symbol X = symbols[it.first.first];
+        for (NodeID dst : it.second)
+            graph->addCFLEdge(src, graph->getGNode(dst), X);
+    }
+    derivedEdges.clear();
+}
+
+void CFLParallelSolver::solve()
+{
+    /// nodes may have been added since the last run, e.g., when the call graph is updated
+    addEpsilonEdges();
+
+    const u32_t numOfParts = threads * PartitionsPerThread;
+    std::vector<u32_t> parts(numOfParts);
+    for (u32_t p = 0; p < numOfParts; ++p)
+        parts[p] = p;
+
+    while (!rowWorklist.empty())
+    {
+        double start = SVFStat::getClk(true);
+        RoundStat stat = {0, 0, 0, 0};
+
+        /// Take the deltas of the last round, partitioned by source node
+        std::vector<RowDeltas> partDeltas(numOfParts);
+        while (!rowWorklist.empty())
+        {
+            RowKey key = rowWorklist.pop();
+            Map<RowKey, NodeBS>::iterator it = rowDeltas.find(key);
+            assert(it != rowDeltas.end() && "no delta for a queued row?");
+            stat.deltaRows++;
+            stat.deltaEdges += it->second.count();
+            partDeltas[key.second % numOfParts].emplace_back(key, std::move(it->second));
+            rowDeltas.erase(it);
+        }
+
+        /// Join the deltas with the matrices, which are read-only until all threads are done
+        std::vector<EdgeBuffer> buffers(threads);
+        std::vector<double> checks(threads, 0);
+        WorkStealingList<u32_t>::forEach(parts, threads, [&](u32_t part, u32_t tid)
+        {
+            EdgeBuffer& buffer = buffers[tid];
+            for (const std::pair<RowKey, NodeBS>& delta : partDeltas[part])
+            {
+                joinRow(delta.first.first, delta.first.second, delta.second, checks[tid],
+                        [&buffer](u32_t X, NodeID k, const NodeBS& newDsts)
+                {
+                    buffer[RowKey(X, k)] |= newDsts;
+                });
+            }
+        });
+
+        /// Merge the thread-local buffers, queueing the new edges for the next round
+        for (u32_t tid = 0; tid < threads; ++tid)
+        {
+            numOfChecks += checks[tid];
+            for (const auto& it : buffers[tid])
+                stat.newEdges += addDerivedEdges(it.first.first, it.first.second, it.second);
+        }
+
+        stat.time = (SVFStat::getClk(true) - start) / TIMEINTERVAL;
+        roundStats.push_back(stat);
+    }
+
+    flushDerivedEdges();
+}
@@ -74,6 +74,30 @@ void CFLStat::CFLSolverStat()
     PTAStat::printStat("CFL-reachability Solver Stats");
 }
 
+/*!
+ * Report the rounds of a round-based solver
+ */
+void CFLStat::CFLRoundStat()
+{
+    const CFLSolver::RoundStats& rounds = pta->getSolver()->getRoundStats();
+    if (rounds.empty())
+        return;
+
+    SVFUtil::outs() << "\n*********CFL-reachability Round Stats***************\n";
+    SVFUtil::outs().flags(std::ios::left);
+    unsigned field_width = 12;
+    SVFUtil::outs() << std::setw(field_width) << "Round" << std::setw(field_width) << "DeltaRows"
+                    << std::setw(field_width) << "DeltaEdges" << std::setw(field_width) << "NewEdges" << "Time\n";
+    for (u32_t i = 0; i < rounds.size(); ++i)
+    {
+        const CFLSolver::RoundStat& round = rounds[i];
+        SVFUtil::outs() << std::setw(field_width) << i << std::setw(field_width) << round.deltaRows
+                        << std::setw(field_width) << round.deltaEdges << std::setw(field_width) << round.newEdges
+                        << round.time << "\n";
+    }
+    SVFUtil::outs() << "#######################################################" << std::endl;
+}
+
 /*!
  * Start here
  */
@@ -90,6 +114,7 @@ void CFLStat::performStat()
 
     // Solver stat
     CFLSolverStat();
+    CFLRoundStat();
 
     // Stat about Call graph and General stat
     PTAStat::performStat();
@@ -66,7 +66,10 @@ void CFLVF::initialize()
     normalizeCFLGrammar();
 
     // Initialize solver
-    solver = new CFLSolver(graph, grammar);
+    if (Options::CFLThreads() > 1)
+        solver = new CFLParallelSolver(graph, grammar, Options::CFLThreads());
+    else
+        solver = new CFLSolver(graph, grammar);
 }
 
 void CFLVF::checkParameter()
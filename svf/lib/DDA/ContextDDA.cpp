@@ -41,7 +41,7 @@ using namespace SVFUtil;
  */
 ContextDDA::ContextDDA(SVFIR* _pag,  DDAClient* client)
     : CondPTAImpl<ContextCond>(_pag, PointerAnalysis::Cxt_DDA),DDAVFSolver<CxtVar,CxtPtSet,CxtLocDPItem>(),
-      _client(client)
+      _client(client), queryBudget(Options::CxtBudget())
 {
     flowDDA = new FlowDDA(_pag, client);
 }
@@ -75,12 +75,28 @@ void ContextDDA::initialize()
 const CxtPtSet& ContextDDA::computeDDAPts(const CxtVar& var)
 {
 
-    resetQuery();
-    LocDPItem::setMaxBudget(Options::CxtBudget());
-
     NodeID id = var.get_id();
     PAGNode* node = getPAG()->getGNode(id);
-    CxtLocDPItem dpm = getDPIm(var, getDefSVFGNode(node));
+    const SVFGNode* defNode = getDefSVFGNode(node);
+
+    /// Reuse the result of an earlier query, unless it ran out of a smaller budget
+    QueryKey key(defNode->getId(), var.get_cond());
+    if (Options::DDAQueryCache())
+    {
+        ddaStat->_NumOfQueryCacheLookups++;
+        QueryCache::const_iterator it = queryCache.find(key);
+        if (it != queryCache.end() && (it->second.oobBudget == 0 || it->second.oobBudget >= queryBudget))
+        {
+            ddaStat->_NumOfQueryCacheHits++;
+            unionPts(var, it->second.pts);
+            return this->getPts(var);
+        }
+    }
+
+    resetQuery();
+    LocDPItem::setMaxBudget(queryBudget);
+
+    CxtLocDPItem dpm = getDPIm(var, defNode);
 
     // start DDA analysis
     DOTIMESTAT(double start = DDAStat::getClk(true));
@@ -88,11 +104,19 @@ const CxtPtSet& ContextDDA::computeDDAPts(const CxtVar& var)
     DOTIMESTAT(ddaStat->_AnaTimePerQuery = DDAStat::getClk(true) - start);
     DOTIMESTAT(ddaStat->_TotalTimeOfQueries += ddaStat->_AnaTimePerQuery);
 
-    if(isOutOfBudgetQuery() == false)
+    bool outOfBudget = isOutOfBudgetQuery();
+    if(outOfBudget == false)
         unionPts(var,cpts);
     else
         handleOutOfBudgetDpm(dpm);
 
+    if (Options::DDAQueryCache())
+    {
+        QueryResult& result = queryCache[key];
+        result.pts = this->getPts(var);
+        result.oobBudget = outOfBudget ? queryBudget : 0;
+    }
+
     if (this->printStat())
         DOSTAT(stat->performStatPerQuery(id));
     DBOUT(DGENERAL, stat->printStatPerQuery(id,getBVPointsTo(getPts(var))));
@@ -109,6 +133,59 @@ void ContextDDA::computeDDAPts(NodeID id)
     computeDDAPts(var);
 }
 
+/*!
+ * Compute points-to sets for a batch of unconditional pointers.
+ * The queries are answered in post-order of a backward traversal of the SVFG
+ * from their definitions, i.e., definitions before uses, so the value-flows a
+ * query traverses have mostly been resolved and cached by earlier queries.
+ *
+ * Each query still has its own budget, but what a query finds in the caches
+ * depends on the queries answered before it: the dpms which ran out of budget
+ * cache the (flow-sensitive) result they were downgraded to. The results of
+ * queries which run out of budget, and of the queries reaching their dpms,
+ * may thus differ from those of the default order. If no query runs out of
+ * budget, both orders give the same results.
+ */
+void ContextDDA::computeDDAPtsInBatch(const OrderedNodeSet& ids)
+{
+    typedef std::pair<const SVFGNode*, SVFGNode::const_iterator> DFSFrame;
+    Map<NodeID, u32_t> postOrder;
+    Set<NodeID> visited;
+    std::vector<DFSFrame> stack;
+    for (NodeID id : ids)
+    {
+        const SVFGNode* def = getDefSVFGNode(getPAG()->getGNode(id));
+        if (!visited.insert(def->getId()).second)
+            continue;
+        stack.emplace_back(def, def->InEdgeBegin());
+        while (!stack.empty())
+        {
+            DFSFrame& frame = stack.back();
+            if (frame.second == frame.first->InEdgeEnd())
+            {
+                postOrder.emplace(frame.first->getId(), postOrder.size());
+                stack.pop_back();
+                continue;
+            }
+            const SVFGNode* src = (*frame.second)->getSrcNode();
+            ++frame.second;
+            if (visited.insert(src->getId()).second)
+                stack.emplace_back(src, src->InEdgeBegin());
+        }
+    }
+
+    std::vector<std::pair<u32_t, NodeID>> schedule;
+    for (NodeID id : ids)
+        schedule.emplace_back(postOrder[getDefSVFGNode(getPAG()->getGNode(id))->getId()], id);
+    std::sort(schedule.begin(), schedule.end());
+
+    for (const std::pair<u32_t, NodeID>& query : schedule)
+    {
+        _client->setCurrentQueryPtr(query.second);
+        computeDDAPts(query.second);
+    }
+}
+
 /*!
  * Handle out-of-budget dpm
  */
@@ -138,11 +215,14 @@ bool ContextDDA::isCondCompatible(const ContextCond& cxt1, const ContextCond& cx
     if(singleton)
         return true;
 
-    int i = cxt1.cxtSize() - 1;
-    int j = cxt2.cxtSize() - 1;
-    for(; i >= 0 && j>=0; i--, j--)
+    /// compare the call sites from the most recent one, popping interned contexts is O(1)
+    CallStrCxt c1 = cxt1.getContexts();
+    CallStrCxt c2 = cxt2.getContexts();
+    for(; !c1.empty() && !c2.empty(); c1.pop_back(), c2.pop_back())
     {
-        if(cxt1[i] != cxt2[j])
+        if(c1 == c2)
+            return true;
+        if(c1.back() != c2.back())
             return false;
     }
     return true;
@@ -54,19 +54,32 @@ void DDAClient::answerQueries(PointerAnalysis* pta)
 
     collectCandidateQueries(pta->getPAG());
 
-    u32_t count = 0;
-    for (OrderedNodeSet::iterator nIter = candidateQueries.begin();
-            nIter != candidateQueries.end(); ++nIter,++count)
+    if (Options::DDABatch())
     {
-        PAGNode* node = pta->getPAG()->getGNode(*nIter);
-        if(pta->getPAG()->isValidTopLevelPtr(node))
+        OrderedNodeSet queries;
+        for (NodeID id : candidateQueries)
         {
-            DBOUT(DGENERAL,outs() << "\n@@Computing PointsTo for :" << node->getId() <<
-                  " [" << count + 1<< "/" << candidateQueries.size() << "]" << " \n");
-            DBOUT(DDDA,outs() << "\n@@Computing PointsTo for :" << node->getId() <<
-                  " [" << count + 1<< "/" << candidateQueries.size() << "]" << " \n");
-            setCurrentQueryPtr(node->getId());
-            pta->computeDDAPts(node->getId());
+            if (pta->getPAG()->isValidTopLevelPtr(pta->getPAG()->getGNode(id)))
+                queries.insert(id);
+        }
+        pta->computeDDAPtsInBatch(queries);
+    }
+    else
+    {
+        u32_t count = 0;
+        for (OrderedNodeSet::iterator nIter = candidateQueries.begin();
+                nIter != candidateQueries.end(); ++nIter,++count)
+        {
+            PAGNode* node = pta->getPAG()->getGNode(*nIter);
+            if(pta->getPAG()->isValidTopLevelPtr(node))
+            {
+                DBOUT(DGENERAL,outs() << "\n@@Computing PointsTo for :" << node->getId() <<
+                      " [" << count + 1<< "/" << candidateQueries.size() << "]" << " \n");
+                DBOUT(DDDA,outs() << "\n@@Computing PointsTo for :" << node->getId() <<
+                      " [" << count + 1<< "/" << candidateQueries.size() << "]" << " \n");
+                setCurrentQueryPtr(node->getId());
+                pta->computeDDAPts(node->getId());
+            }
         }
     }
 
@@ -70,6 +70,8 @@ void DDAStat::initDefault()
     _TotalTimeOfQueries = 0;
     _AnaTimePerQuery = 0;
     _AnaTimeCyclePerQuery = 0;
+    _NumOfQueryCacheLookups = 0;
+    _NumOfQueryCacheHits = 0;
 
 
     _NumOfDPM = 0;
@@ -252,6 +254,7 @@ void DDAStat::performStat()
     PTNumStatMap["MaxDPMAtLoc"] = _MaxNumOfDPMAtSVFGNode;
     PTNumStatMap["MaxPathPerQuery"] = ContextCond::maximumPath;
     PTNumStatMap["MaxCxtPerQuery"] = ContextCond::maximumCxt;
+    PTNumStatMap["NumOfCallStrCxt"] = CallStrCxt::getNumOfCxts();
     PTNumStatMap["MaxCPtsSize"] = _MaxCPtsSize;
     PTNumStatMap["MaxPtsSize"] = _MaxPtsSize;
     timeStatMap["AvgCPtsSize"] = (double)_TotalCPtsSize/_TotalNumOfQuery;
@@ -263,6 +266,12 @@ void DDAStat::performStat()
     PTNumStatMap["NumOfMustAA"] = _TotalNumOfMustAliases;
     PTNumStatMap["NumOfInfePath"] = _TotalNumOfInfeasiblePath;
     PTNumStatMap["NumOfStore"] = SVFIR::getPAG()->getPTASVFStmtSet(SVFStmt::Store).size();
+    if (_NumOfQueryCacheLookups > 0)
+    {
+        PTNumStatMap["QueryCacheLookups"] = _NumOfQueryCacheLookups;
+        PTNumStatMap["QueryCacheHits"] = _NumOfQueryCacheHits;
+        timeStatMap["QueryCacheHitRatio"] = (double)_NumOfQueryCacheHits/_NumOfQueryCacheLookups;
+    }
     timeStatMap["MemoryUsageVmrss"] = _vmrssUsageAfter - _vmrssUsageBefore;
     timeStatMap["MemoryUsageVmsize"] = _vmsizeUsageAfter - _vmsizeUsageBefore;
 
@@ -305,8 +305,8 @@ ICFGEdge* ICFG::getICFGEdge(const ICFGNode* src, const ICFGNode* dst, ICFGEdge::
 
     ICFGEdge * edge = nullptr;
     u32_t counter = 0;
-    for (ICFGEdge::ICFGEdgeSetTy::iterator iter = src->OutEdgeBegin();
-            iter != src->OutEdgeEnd(); ++iter)
+    for (ICFGNode::GEdgeRangeTy::const_iterator iter = src->getOutEdgeRange().begin();
+            iter != src->getOutEdgeRange().end(); ++iter)
     {
         if ((*iter)->getDstID() == dst->getId() && (*iter)->getEdgeKind() == kind)
         {
@@ -510,7 +510,7 @@ struct DOTGraphTraits<ICFG*> : public DOTGraphTraits<SVFIR*>
         if (Options::ShowHiddenNode())
             return false;
         else
-            return node->getInEdges().empty() && node->getOutEdges().empty();
+            return node->getInEdgeRange().empty() && node->getOutEdgeRange().empty();
     }
 
     static std::string getNodeAttributes(NodeType *node, ICFG*)
@@ -94,7 +94,7 @@ bool PTACallGraphNode::isReachableFromProgEntry() const
         if (SVFUtil::isProgEntryFunction(node->getFunction()))
             return true;
 
-        for (const_iterator it = node->InEdgeBegin(), eit = node->InEdgeEnd(); it != eit; ++it)
+        for (GEdgeRangeTy::const_iterator it = node->getInEdgeRange().begin(), eit = node->getInEdgeRange().end(); it != eit; ++it)
         {
             PTACallGraphEdge* edge = *it;
             if (visitedNodes.test_and_set(edge->getSrcID()))
@@ -181,8 +181,8 @@ PTACallGraphEdge* PTACallGraph::getGraphEdge(PTACallGraphNode* src,
         PTACallGraphNode* dst,
         PTACallGraphEdge::CEDGEK kind, CallSiteID)
 {
-    for (PTACallGraphEdge::CallGraphEdgeSet::iterator iter = src->OutEdgeBegin();
-            iter != src->OutEdgeEnd(); ++iter)
+    for (PTACallGraphNode::GEdgeRangeTy::const_iterator iter = src->getOutEdgeRange().begin();
+            iter != src->getOutEdgeRange().end(); ++iter)
     {
         PTACallGraphEdge* edge = (*iter);
         if (edge->getEdgeKind() == kind && edge->getDstID() == dst->getId())
@@ -220,7 +220,7 @@ void PTACallGraph::addIndirectCallGraphEdge(const CallICFGNode* cs,const SVFFunc
 void PTACallGraph::getAllCallSitesInvokingCallee(const SVFFunction* callee, PTACallGraphEdge::CallInstSet& csSet)
 {
     PTACallGraphNode* callGraphNode = getCallGraphNode(callee);
-    for(PTACallGraphNode::iterator it = callGraphNode->InEdgeBegin(), eit = callGraphNode->InEdgeEnd();
+    for(PTACallGraphNode::GEdgeRangeTy::const_iterator it = callGraphNode->getInEdgeRange().begin(), eit = callGraphNode->getInEdgeRange().end();
             it!=eit; ++it)
     {
         for(PTACallGraphEdge::CallInstSet::const_iterator cit = (*it)->directCallsBegin(),
@@ -242,7 +242,7 @@ void PTACallGraph::getAllCallSitesInvokingCallee(const SVFFunction* callee, PTAC
 void PTACallGraph::getDirCallSitesInvokingCallee(const SVFFunction* callee, PTACallGraphEdge::CallInstSet& csSet)
 {
     PTACallGraphNode* callGraphNode = getCallGraphNode(callee);
-    for(PTACallGraphNode::iterator it = callGraphNode->InEdgeBegin(), eit = callGraphNode->InEdgeEnd();
+    for(PTACallGraphNode::GEdgeRangeTy::const_iterator it = callGraphNode->getInEdgeRange().begin(), eit = callGraphNode->getInEdgeRange().end();
             it!=eit; ++it)
     {
         for(PTACallGraphEdge::CallInstSet::const_iterator cit = (*it)->directCallsBegin(),
@@ -259,7 +259,7 @@ void PTACallGraph::getDirCallSitesInvokingCallee(const SVFFunction* callee, PTAC
 void PTACallGraph::getIndCallSitesInvokingCallee(const SVFFunction* callee, PTACallGraphEdge::CallInstSet& csSet)
 {
     PTACallGraphNode* callGraphNode = getCallGraphNode(callee);
-    for(PTACallGraphNode::iterator it = callGraphNode->InEdgeBegin(), eit = callGraphNode->InEdgeEnd();
+    for(PTACallGraphNode::GEdgeRangeTy::const_iterator it = callGraphNode->getInEdgeRange().begin(), eit = callGraphNode->getInEdgeRange().end();
             it!=eit; ++it)
     {
         for(PTACallGraphEdge::CallInstSet::const_iterator cit = (*it)->indirectCallsBegin(),
@@ -310,7 +310,7 @@ bool PTACallGraph::isReachableBetweenFunctions(const SVFFunction* srcFn, const S
         if (node->getFunction() == srcFn)
             return true;
 
-        for (CallGraphEdgeConstIter it = node->InEdgeBegin(), eit = node->InEdgeEnd(); it != eit; ++it)
+        for (PTACallGraphNode::GEdgeRangeTy::const_iterator it = node->getInEdgeRange().begin(), eit = node->getInEdgeRange().end(); it != eit; ++it)
         {
             PTACallGraphEdge* edge = *it;
             if (visitedNodes.test_and_set(edge->getSrcID()))
@@ -786,7 +786,7 @@ struct DOTGraphTraits<SVFG*> : public DOTGraphTraits<SVFIR*>
     static bool isNodeHidden(SVFGNode *node, SVFG *)
     {
         if (Options::ShowHiddenNode()) return false;
-        else return node->getInEdges().empty() && node->getOutEdges().empty();
+        else return node->getInEdgeRange().empty() && node->getOutEdgeRange().empty();
     }
 
     std::string getNodeLabel(NodeType *node, SVFG *graph)
@@ -39,6 +39,7 @@ const char* MemSSAStat::TimeOfGeneratingMemRegions  = "GenRegionTime";	///< Time
 const char* MemSSAStat::TimeOfCreateMUCHI  = "GenMUCHITime";	///< Time for generating mu/chi for load/store/calls
 const char* MemSSAStat::TimeOfInsertingPHI = "InsertPHITime";	///< Time for inserting phis
 const char* MemSSAStat::TimeOfSSARenaming = "SSARenameTime";	///< Time for SSA rename
+const char* MemSSAStat::TimeOfModRefAnalysis = "ModRefTime";	///< Time for mod-ref analysis of callsites
 
 const char* MemSSAStat::NumOfMaxRegion = "MaxRegSize";	///< Number of max points-to set in region.
 const char* MemSSAStat::NumOfAveragePtsInRegion = "AverageRegSize";	///< Number of average points-to set in region.
@@ -59,6 +60,10 @@ const char* MemSSAStat::NumOfLoadHasMu = "LoadHasMu";	///< Number of loads which
 const char* MemSSAStat::NumOfStoreHasChi = "StoreHasChi";	///< Number of stores which have chi
 const char* MemSSAStat::NumOfBBHasMSSAPhi = "BBHasMSSAPhi";	///< Number of basic blocks which have mssa phi
 
+const char* MemSSAStat::NumOfModRefSets = "ModRefSets";	///< Number of mod-ref sets of functions and callsites
+const char* MemSSAStat::NumOfUniqueModRefSets = "UniqueModRefSets";	///< Number of distinct sets storing the mod-ref sets
+const char* MemSSAStat::NumOfModRefBytesSaved = "ModRefBytesSaved";	///< Bytes saved by storing identical mod-ref sets once
+
 /*!
  * Constructor
  */
@@ -98,6 +103,7 @@ void MemSSAStat::performStat()
     timeStatMap[TimeOfCreateMUCHI] =  MemSSA::timeOfCreateMUCHI;
     timeStatMap[TimeOfInsertingPHI] =  MemSSA::timeOfInsertingPHI;
     timeStatMap[TimeOfSSARenaming] =  MemSSA::timeOfSSARenaming;
+    timeStatMap[TimeOfModRefAnalysis] = mrGenerator->getModRefTime();
 
     PTNumStatMap[NumOfMaxRegion] = maxRegionSize;
     timeStatMap[NumOfAveragePtsInRegion] = (regionNumber == 0) ? 0 : ((double)totalRegionPtsNum / regionNumber);
@@ -118,6 +124,10 @@ void MemSSAStat::performStat()
     PTNumStatMap[NumOfStoreHasChi] = mssa->getStoreToChiSetMap().size();
     PTNumStatMap[NumOfBBHasMSSAPhi] = mssa->getBBToPhiSetMap().size();
 
+    PTNumStatMap[NumOfModRefSets] = mrGenerator->getModRefSetNum();
+    PTNumStatMap[NumOfUniqueModRefSets] = mrGenerator->getUniqueModRefSetNum();
+    PTNumStatMap[NumOfModRefBytesSaved] = mrGenerator->getModRefBytesSaved();
+
     printStat();
 
 }
@@ -73,7 +73,7 @@ const std::string LoadVFGNode::toString() const
 const NodeBS StoreVFGNode::getDefSVFVars() const
 {
     NodeBS nb;
-    for (auto edge: getOutEdges())
+    for (auto edge: getOutEdgeRange())
     {
         if (IndirectSVFGEdge *iedge = SVFUtil::dyn_cast<IndirectSVFGEdge>(edge))
         {
@@ -32,6 +32,7 @@
 #include "MSSA/MemRegion.h"
 #include "MSSA/MSSAMuChi.h"
 #include "Graphs/CallGraph.h"
+#include "Util/SVFStat.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -40,7 +41,7 @@ u32_t MemRegion::totalMRNum = 0;
 u32_t MRVer::totalVERNum = 0;
 
 MRGenerator::MRGenerator(BVDataPTAImpl* p, bool ptrOnly) :
-    pta(p), ptrOnlyMSSA(ptrOnly)
+    pta(p), ptrOnlyMSSA(ptrOnly), modRefTime(0), modRefBytes(0), modRefCompactBytes(0)
 {
     callGraph = pta->getCallGraph();
     callGraphSCC = new SCC(callGraph);
@@ -129,6 +130,9 @@ void MRGenerator::generateMRs()
 
     collectGlobals();
 
+    /// the call graph is only traversed while the regions are generated
+    callGraph->freeze();
+
     callGraphSCC->find();
 
     DBOUT(DGENERAL, outs() << pasMsg("\tCollect ModRef For Load/Store \n"));
@@ -146,6 +150,8 @@ void MRGenerator::generateMRs()
     partitionMRs();
     /// attach memory regions for loads/stores/calls
     updateAliasMRs();
+
+    callGraph->thaw();
 }
 
 bool MRGenerator::hasSVFStmtList(const ICFGNode* node)
@@ -238,21 +244,32 @@ void MRGenerator::collectModRefForCall()
 
     DBOUT(DGENERAL, outs() << pasMsg("\t\tPerform Callsite Mod-Ref \n"));
 
-    WorkList worklist;
-    getCallGraphSCCRevTopoOrder(worklist);
-
-    while(!worklist.empty())
+    double modRefStart = SVFStat::getClk(true);
+    if (Options::MSSAThreads() > 1)
     {
-        NodeID callGraphNodeID = worklist.pop();
-        /// handle all sub scc nodes of this rep node
-        const NodeBS& subNodes = callGraphSCC->subNodes(callGraphNodeID);
-        for(NodeBS::iterator it = subNodes.begin(), eit = subNodes.end(); it!=eit; ++it)
+        parallelModRefAnalysis(Options::MSSAThreads());
+    }
+    else
+    {
+        WorkList worklist;
+        getCallGraphSCCRevTopoOrder(worklist);
+
+        while(!worklist.empty())
         {
-            PTACallGraphNode* subCallGraphNode = callGraph->getCallGraphNode(*it);
-            /// Get mod-ref of all callsites calling callGraphNode
-            modRefAnalysis(subCallGraphNode,worklist);
+            NodeID callGraphNodeID = worklist.pop();
+            /// handle all sub scc nodes of this rep node
+            const NodeBS& subNodes = callGraphSCC->subNodes(callGraphNodeID);
+            for(NodeBS::iterator it = subNodes.begin(), eit = subNodes.end(); it!=eit; ++it)
+            {
+                PTACallGraphNode* subCallGraphNode = callGraph->getCallGraphNode(*it);
+                /// Get mod-ref of all callsites calling callGraphNode
+                modRefAnalysis(subCallGraphNode,worklist);
+            }
         }
     }
+    compactModRefs();
+    double modRefEnd = SVFStat::getClk(true);
+    modRefTime = (modRefEnd - modRefStart)/TIMEINTERVAL;
 
     DBOUT(DGENERAL, outs() << pasMsg("\t\tAdd PointsTo to Callsites \n"));
 
@@ -619,8 +636,8 @@ bool MRGenerator::handleCallsiteModRef(NodeBS& mod, NodeBS& ref, const CallICFGN
     /// otherwise, we find the mod/ref sets from the callee function, who has definition and been processed
     else
     {
-        mod = getModSideEffectOfFunction(callee);
-        ref = getRefSideEffectOfFunction(callee);
+        mod = funToModsMap[callee];
+        ref = funToRefsMap[callee];
     }
     // add ref set
     bool refchanged = addRefSideEffectOfCallSite(cs, ref);
@@ -638,7 +655,7 @@ void MRGenerator::modRefAnalysis(PTACallGraphNode* callGraphNode, WorkList& work
 {
 
     /// add ref/mod set of callee to its invocation callsites at caller
-    for(PTACallGraphNode::iterator it = callGraphNode->InEdgeBegin(), eit = callGraphNode->InEdgeEnd();
+    for(PTACallGraphNode::GEdgeRangeTy::const_iterator it = callGraphNode->getInEdgeRange().begin(), eit = callGraphNode->getInEdgeRange().end();
             it!=eit; ++it)
     {
         PTACallGraphEdge* edge = *it;
@@ -650,8 +667,9 @@ void MRGenerator::modRefAnalysis(PTACallGraphNode* callGraphNode, WorkList& work
             NodeBS mod, ref;
             const CallICFGNode* cs = (*cit);
             bool modrefchanged = handleCallsiteModRef(mod, ref, cs, callGraphNode->getFunction());
+            /// only SCC representatives have their sub nodes, push the one of the caller
             if(modrefchanged)
-                worklist.push(edge->getSrcID());
+                worklist.push(callGraphSCC->repNode(edge->getSrcID()));
         }
         /// handle indirect callsites
         for(PTACallGraphEdge::CallInstSet::iterator cit = edge->getIndirectCalls().begin(),
@@ -660,10 +678,210 @@ void MRGenerator::modRefAnalysis(PTACallGraphNode* callGraphNode, WorkList& work
             NodeBS mod, ref;
             const CallICFGNode* cs = (*cit);
             bool modrefchanged = handleCallsiteModRef(mod, ref, cs, callGraphNode->getFunction());
+            /// only SCC representatives have their sub nodes, push the one of the caller
             if(modrefchanged)
-                worklist.push(edge->getSrcID());
+                worklist.push(callGraphSCC->repNode(edge->getSrcID()));
+        }
+    }
+}
+
+/*!
+ * Call site mod-ref analysis with several threads.
+ * The call graph SCCs are grouped by their longest distance from an SCC which
+ * calls no other SCC. An SCC only calls SCCs of earlier levels, whose mod-ref
+ * is final, so the SCCs of a level are analysed at the same time.
+ */
+void MRGenerator::parallelModRefAnalysis(u32_t threads)
+{
+    /// Callers come before their callees in topoOrder
+    NodeStack& topoStack = callGraphSCC->topoNodeStack();
+    NodeVector topoOrder;
+    while (!topoStack.empty())
+    {
+        topoOrder.push_back(topoStack.top());
+        topoStack.pop();
+    }
+
+    /// Create every map entry read or updated by the workers here, so that
+    /// the workers never insert into a shared map
+    for (PTACallGraph::iterator it = callGraph->begin(), eit = callGraph->end(); it != eit; ++it)
+    {
+        const SVFFunction* fun = it->second->getFunction();
+        funToRefsMap[fun];
+        funToModsMap[fun];
+        for (const PTACallGraphEdge* edge : it->second->getOutEdgeRange())
+        {
+            for (const PTACallGraphEdge::CallInstSet* calls : {&edge->getDirectCalls(), &edge->getIndirectCalls()})
+            {
+                for (const CallICFGNode* cs : *calls)
+                {
+                    csToRefsMap[cs];
+                    csToModsMap[cs];
+                    getCallSiteArgsPts(cs);
+                    getCallSiteRetPts(cs);
+                    if (isHeapAllocExtCall(cs))
+                        getPAGEdgesFromInst(cs);
+                }
+            }
+        }
+    }
+
+    std::vector<NodeVector> levels;
+    Map<NodeID, u32_t> sccLevels;
+    for (NodeVector::reverse_iterator rit = topoOrder.rbegin(), reit = topoOrder.rend(); rit != reit; ++rit)
+    {
+        NodeID rep = *rit;
+        u32_t level = 0;
+        for (NodeID sub : callGraphSCC->subNodes(rep))
+        {
+            for (const PTACallGraphEdge* edge : callGraph->getCallGraphNode(sub)->getOutEdgeRange())
+            {
+                NodeID calleeRep = callGraphSCC->repNode(edge->getDstID());
+                if (calleeRep != rep)
+                {
+                    assert(sccLevels.count(calleeRep) && "callee SCC not ordered before its caller?");
+                    level = std::max(level, sccLevels[calleeRep] + 1);
+                }
+            }
+        }
+
+        sccLevels[rep] = level;
+        if (levels.size() <= level)
+            levels.resize(level + 1);
+        levels[level].push_back(rep);
+    }
+
+    std::vector<std::vector<const CallICFGNode*>> refCallSites(threads), modCallSites(threads);
+    for (const NodeVector& level : levels)
+    {
+        WorkStealingList<NodeID>::forEach(level, threads, [&](NodeID rep, u32_t tid)
+        {
+            modRefAnalysisOfSCC(rep, refCallSites[tid], modCallSites[tid]);
+        });
+    }
+
+    /// Only keep the callsites which the sequential analysis would have added
+    Set<const CallICFGNode*> refs, mods;
+    for (u32_t tid = 0; tid < threads; ++tid)
+    {
+        refs.insert(refCallSites[tid].begin(), refCallSites[tid].end());
+        mods.insert(modCallSites[tid].begin(), modCallSites[tid].end());
+    }
+    for (CallSiteToPointsToMap::iterator it = csToRefsMap.begin(); it != csToRefsMap.end();)
+    {
+        if (refs.count(it->first))
+            ++it;
+        else
+            it = csToRefsMap.erase(it);
+    }
+    for (CallSiteToPointsToMap::iterator it = csToModsMap.begin(); it != csToModsMap.end();)
+    {
+        if (mods.count(it->first))
+            ++it;
+        else
+            it = csToModsMap.erase(it);
+    }
+}
+
+/*!
+ * Compute mod-ref of the callsites in the SCC of rep, whose callee SCCs are
+ * all done, iterating until its summaries do not change if it is recursive.
+ * Callsites which get a non-empty ref/mod set from a callee are added to
+ * refCallSites/modCallSites.
+ */
+void MRGenerator::modRefAnalysisOfSCC(NodeID rep, std::vector<const CallICFGNode*>& refCallSites,
+                                      std::vector<const CallICFGNode*>& modCallSites)
+{
+    bool inCycle = callGraphSCC->isInCycle(rep);
+    bool changed;
+    do
+    {
+        changed = false;
+        for (NodeID sub : callGraphSCC->subNodes(rep))
+        {
+            for (const PTACallGraphEdge* edge : callGraph->getCallGraphNode(sub)->getOutEdgeRange())
+            {
+                const SVFFunction* callee = edge->getDstNode()->getFunction();
+                for (const PTACallGraphEdge::CallInstSet* calls : {&edge->getDirectCalls(), &edge->getIndirectCalls()})
+                {
+                    for (const CallICFGNode* cs : *calls)
+                    {
+                        NodeBS mod, ref;
+                        if (handleCallsiteModRef(mod, ref, cs, callee))
+                            changed = true;
+                        if (!ref.empty())
+                            refCallSites.push_back(cs);
+                        if (!mod.empty())
+                            modCallSites.push_back(cs);
+                    }
+                }
+            }
         }
     }
+    while (changed && inCycle);
+}
+
+/*!
+ * Move the mod-ref sets of functions and callsites into modRefCache, where
+ * identical sets share their storage, and release the sets of the analysis
+ */
+void MRGenerator::compactModRefs()
+{
+    /// Bytes of a set: the set itself and the list nodes of its elements
+    auto bytesOf = [](const NodeBS& bs) -> u64_t
+    {
+        u64_t elements = 0;
+        u32_t lastElement = 0;
+        for (NodeID id : bs)
+        {
+            u32_t element = id / SparseBitVectorElement<>::BITS_PER_ELEMENT;
+            if (elements == 0 || element != lastElement)
+            {
+                ++elements;
+                lastElement = element;
+            }
+        }
+        return sizeof(NodeBS) + elements * (sizeof(SparseBitVectorElement<>) + 2 * sizeof(void*));
+    };
+    for (const FunToPointsToMap* funSets : {&funToRefsMap, &funToModsMap})
+    {
+        for (const auto& it : *funSets)
+        {
+            if (!it.second.empty())
+                modRefBytes += bytesOf(it.second);
+        }
+    }
+    for (const CallSiteToPointsToMap* csSets : {&csToRefsMap, &csToModsMap})
+    {
+        for (const auto& it : *csSets)
+            modRefBytes += bytesOf(it.second);
+    }
+
+    /// An empty set of a function is the same as no set, but a callsite with
+    /// an empty set still has an (empty) region
+    for (const auto& it : funToRefsMap)
+    {
+        if (!it.second.empty())
+            funToRefSummaryMap[it.first] = modRefCache.emplacePts(it.second);
+    }
+    for (const auto& it : funToModsMap)
+    {
+        if (!it.second.empty())
+            funToModSummaryMap[it.first] = modRefCache.emplacePts(it.second);
+    }
+    for (const auto& it : csToRefsMap)
+        csToRefSummaryMap[it.first] = modRefCache.emplacePts(it.second);
+    for (const auto& it : csToModsMap)
+        csToModSummaryMap[it.first] = modRefCache.emplacePts(it.second);
+
+    funToRefsMap.clear();
+    funToModsMap.clear();
+    csToRefsMap.clear();
+    csToModsMap.clear();
+
+    modRefCompactBytes = getModRefSetNum() * sizeof(PointsToID);
+    for (PointsToID id = 0; id < modRefCache.numOfPts(); ++id)
+        modRefCompactBytes += bytesOf(modRefCache.getActualPts(id));
 }
 
 /*!
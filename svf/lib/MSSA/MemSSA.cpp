@@ -32,6 +32,7 @@
 #include "MSSA/MemSSA.h"
 #include "Graphs/SVFGStat.h"
 #include "Graphs/CallGraph.h"
+#include "Util/WorkList.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -44,7 +45,7 @@ double MemSSA::timeOfSSARenaming  = 0;	///< Time for SSA rename
 /*!
  * Constructor
  */
-MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA)
+MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA) : worker(false)
 {
     pta = p;
     assert((pta->getAnalysisTy()!=PointerAnalysis::Default_PTA)
@@ -69,6 +70,14 @@ MemSSA::MemSSA(BVDataPTAImpl* p, bool ptrOnlyMSSA)
     timeOfGeneratingMemRegions = (mrEnd - mrStart)/TIMEINTERVAL;
 }
 
+/*!
+ * Constructor of a worker, which builds the memory SSA of some functions with
+ * the regions of owner before they are merged into owner
+ */
+MemSSA::MemSSA(MemSSA* owner) : pta(owner->pta), mrGen(owner->mrGen), stat(owner->stat), worker(true)
+{
+}
+
 SVFIR* MemSSA::getPAG()
 {
     return pta->getPAG();
@@ -78,6 +87,105 @@ SVFIR* MemSSA::getPAG()
  * Start building memory SSA
  */
 void MemSSA::buildMemSSA(const SVFFunction& fun)
+{
+    buildFunMemSSA(fun, timeOfCreateMUCHI, timeOfInsertingPHI, timeOfSSARenaming);
+}
+
+/*!
+ * Build memory SSA for all functions in funs.
+ * Once the regions are generated, the memory SSA of a function only depends on
+ * the function itself, so the functions are built by one worker per thread and
+ * then merged in the order of funs. MRVer IDs are the same as building the
+ * functions one after another; the phase times are summed over the threads.
+ */
+void MemSSA::buildMemSSA(const std::vector<const SVFFunction*>& funs)
+{
+    u32_t threads = std::min<u32_t>(Options::MSSAThreads(), funs.size());
+    if (threads <= 1)
+    {
+        for (const SVFFunction* fun : funs)
+            buildMemSSA(*fun);
+        return;
+    }
+
+    /// Create the (possibly empty) region sets of loads and stores here, so
+    /// that workers only read mrGen
+    for (const SVFFunction* fun : funs)
+    {
+        for (const SVFBasicBlock* bb : fun->getReachableBBs())
+        {
+            for (const ICFGNode* inst : bb->getICFGNodeList())
+            {
+                if (!mrGen->hasSVFStmtList(inst))
+                    continue;
+                for (const SVFStmt* stmt : mrGen->getPAGEdgesFromInst(inst))
+                {
+                    if (const LoadStmt* load = SVFUtil::dyn_cast<LoadStmt>(stmt))
+                        mrGen->getLoadMRSet(load);
+                    else if (const StoreStmt* store = SVFUtil::dyn_cast<StoreStmt>(stmt))
+                        mrGen->getStoreMRSet(store);
+                }
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<MemSSA>> workers;
+    for (u32_t i = 0; i < threads; ++i)
+        workers.push_back(std::unique_ptr<MemSSA>(new MemSSA(this)));
+    std::vector<double> muchiTimes(threads, 0), phiTimes(threads, 0), renameTimes(threads, 0);
+
+    /// The worker of each function, and the range of its versions in usedMRVers of the worker
+    std::vector<u32_t> funWorkers(funs.size()), verBegins(funs.size()), verEnds(funs.size());
+    std::vector<u32_t> indices(funs.size());
+    for (u32_t i = 0; i < funs.size(); ++i)
+        indices[i] = i;
+    WorkStealingList<u32_t>::forEach(indices, threads, [&](u32_t i, u32_t tid)
+    {
+        MemSSA* w = workers[tid].get();
+        funWorkers[i] = tid;
+        verBegins[i] = w->usedMRVers.size();
+        w->buildFunMemSSA(*funs[i], muchiTimes[tid], phiTimes[tid], renameTimes[tid]);
+        verEnds[i] = w->usedMRVers.size();
+    });
+
+    for (u32_t i = 0; i < funs.size(); ++i)
+    {
+        std::vector<std::unique_ptr<MRVer>>& vers = workers[funWorkers[i]]->usedMRVers;
+        for (u32_t v = verBegins[i]; v < verEnds[i]; ++v)
+        {
+            vers[v]->setID();
+            usedMRVers.push_back(std::move(vers[v]));
+        }
+    }
+    for (u32_t tid = 0; tid < threads; ++tid)
+    {
+        MemSSA* w = workers[tid].get();
+        load2MuSetMap.insert(w->load2MuSetMap.begin(), w->load2MuSetMap.end());
+        store2ChiSetMap.insert(w->store2ChiSetMap.begin(), w->store2ChiSetMap.end());
+        callsiteToMuSetMap.insert(w->callsiteToMuSetMap.begin(), w->callsiteToMuSetMap.end());
+        callsiteToChiSetMap.insert(w->callsiteToChiSetMap.begin(), w->callsiteToChiSetMap.end());
+        bb2PhiSetMap.insert(w->bb2PhiSetMap.begin(), w->bb2PhiSetMap.end());
+        funToEntryChiSetMap.insert(w->funToEntryChiSetMap.begin(), w->funToEntryChiSetMap.end());
+        funToReturnMuSetMap.insert(w->funToReturnMuSetMap.begin(), w->funToReturnMuSetMap.end());
+        /// the mus, chis and phis now belong to this
+        w->load2MuSetMap.clear();
+        w->store2ChiSetMap.clear();
+        w->callsiteToMuSetMap.clear();
+        w->callsiteToChiSetMap.clear();
+        w->bb2PhiSetMap.clear();
+        w->funToEntryChiSetMap.clear();
+        w->funToReturnMuSetMap.clear();
+
+        timeOfCreateMUCHI += muchiTimes[tid];
+        timeOfInsertingPHI += phiTimes[tid];
+        timeOfSSARenaming += renameTimes[tid];
+    }
+}
+
+/*!
+ * Build memory SSA for a function
+ */
+void MemSSA::buildFunMemSSA(const SVFFunction& fun, double& muchiTime, double& phiTime, double& renameTime)
 {
 
     assert(!isExtCall(&fun) && "we do not build memory ssa for external functions");
@@ -92,19 +200,19 @@ void MemSSA::buildMemSSA(const SVFFunction& fun)
     double muchiStart = stat->getClk(true);
     createMUCHI(fun);
     double muchiEnd = stat->getClk(true);
-    timeOfCreateMUCHI += (muchiEnd - muchiStart)/TIMEINTERVAL;
+    muchiTime += (muchiEnd - muchiStart)/TIMEINTERVAL;
 
     /// Insert PHI for memory regions
     double phiStart = stat->getClk(true);
     insertPHI(fun);
     double phiEnd = stat->getClk(true);
-    timeOfInsertingPHI += (phiEnd - phiStart)/TIMEINTERVAL;
+    phiTime += (phiEnd - phiStart)/TIMEINTERVAL;
 
     /// SSA rename for memory regions
     double renameStart = stat->getClk(true);
     SSARename(fun);
     double renameEnd = stat->getClk(true);
-    timeOfSSARenaming += (renameEnd - renameStart)/TIMEINTERVAL;
+    renameTime += (renameEnd - renameStart)/TIMEINTERVAL;
 
 }
 
@@ -353,7 +461,7 @@ MRVer* MemSSA::newSSAName(const MemRegion* mr, MSSADEF* def)
 
     MRVERSION version = mr2CounterMap[mr];
     mr2CounterMap[mr] = version + 1;
-    auto mrVer = std::make_unique<MRVer>(mr, version, def);
+    std::unique_ptr<MRVer> mrVer(worker ? new MRVer(mr, version, def, MRVer::Unnumbered()) : new MRVer(mr, version, def));
     auto mrVerPtr = mrVer.get();
     mr2VerStackMap[mr].push_back(mrVerPtr);
     usedMRVers.push_back(std::move(mrVer));
@@ -436,9 +544,12 @@ void MemSSA::destroy()
         }
     }
 
-    delete mrGen;
+    if (!worker)
+    {
+        delete mrGen;
+        delete stat;
+    }
     mrGen = nullptr;
-    delete stat;
     stat = nullptr;
     pta = nullptr;
 }
@@ -564,17 +564,34 @@ bool LockAnalysis::matchCxt(CallStrCxt& cxt, const CallICFGNode* call, const SVF
 bool LockAnalysis::isProtectedByCommonLock(const ICFGNode *i1, const ICFGNode *i2)
 {
     numOfTotalQueries++;
-    bool commonlock = false;
     DOTIMESTAT(double queryStart = PTAStat::getClk(true));
-    if (isInsideIntraLock(i1) && isInsideIntraLock(i2))
-        commonlock = isProtectedByCommonCILock(i1,i2) ;
-    else
-        commonlock = isProtectedByCommonCxtLock(i1,i2);
+    bool commonlock = hasCommonLock(i1,i2);
     DOTIMESTAT(double queryEnd = PTAStat::getClk(true));
     DOTIMESTAT(lockQueriesTime += (queryEnd - queryStart) / TIMEINTERVAL);
     return commonlock;
 }
 
+bool LockAnalysis::hasCommonLock(const ICFGNode *i1, const ICFGNode *i2)
+{
+    if (isInsideIntraLock(i1) && isInsideIntraLock(i2))
+        return isProtectedByCommonCILock(i1,i2);
+    else
+        return isProtectedByCommonCxtLock(i1,i2);
+}
+
+/*!
+ * Alias queries of lock values fill the points-to and field maps of the
+ * pointer analysis on demand, so do that once for every lock site here
+ */
+void LockAnalysis::prepareConcurrentQueries()
+{
+    for (const ICFGNode* lock : locksites)
+    {
+        NodeID lockVal = getLockVal(lock)->getId();
+        tct->getPTA()->alias(lockVal, lockVal);
+    }
+}
+
 /*!
  * Protected by at least one common context-insensitive lock
  */
@@ -36,6 +36,7 @@
 #include "MTA/MTAStat.h"
 #include "WPA/Andersen.h"
 #include "Util/SVFUtil.h"
+#include "Util/WorkList.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -118,12 +119,55 @@ MHP* MTA::computeMHP(SVFModule* module)
     return mhp;
 }
 
+namespace
+{
+/// The thread statements of a memory access, gathered before querying MHP
+/// from several threads
+struct AccessThreads
+{
+    std::vector<std::pair<NodeID, NodeBS>> interleavings;  ///< (thread, threads interleaved with it) per thread statement
+    NodeBS tids;            ///< threads executing the access
+    NodeBS interleaved;     ///< threads interleaved with any of them
+};
+
+/// Same as MHP::mayHappenInParallelInst, over the gathered thread statements
+bool mayHappenInParallel(const AccessThreads* t1, const AccessThreads* t2, const NodeBS& multiForked)
+{
+    if (t1 == nullptr || t2 == nullptr)
+        return false;
+    NodeBS sameTids = t1->tids;
+    sameTids &= t2->tids;
+    bool sameThread = sameTids.intersects(multiForked);
+    if (!sameThread && !(t1->interleaved.intersects(t2->tids) && t2->interleaved.intersects(t1->tids)))
+        return false;
+    for (const std::pair<NodeID, NodeBS>& ts1 : t1->interleavings)
+    {
+        for (const std::pair<NodeID, NodeBS>& ts2 : t2->interleavings)
+        {
+            if (ts1.first != ts2.first)
+            {
+                if (ts1.second.test(ts2.first) && ts2.second.test(ts1.first))
+                    return true;
+            }
+            else if (multiForked.test(ts1.first))
+                return true;
+        }
+    }
+    return false;
+}
+} // End anonymous namespace
+
 ///*!
 // * Check   (1) write-read race
 // * 		 (2) write-write race (optional)
 // * 		 (3) read-read race (optional)
 // * when two memory access may-happen in parallel and are not protected by the same lock
 // * (excluding global constraints because they are initialized before running the main function)
+// *
+// * Instead of querying every load and store pair, stores are bucketed by the
+// * objects they may write, so that each load is only paired with the stores
+// * it may alias. The candidate pairs of each load are checked in parallel
+// * (-mta-threads) and the race pairs printed in the order of the pairwise scan.
 // */
 void MTA::detect(SVFModule* module)
 {
@@ -133,7 +177,7 @@ void MTA::detect(SVFModule* module)
     Set<const LoadStmt*> loads;
     Set<const StoreStmt*> stores;
     SVFIR* pag = SVFIR::getPAG();
-    PointerAnalysis* pta = AndersenWaveDiff::createAndersenWaveDiff(pag);
+    AndersenWaveDiff* pta = AndersenWaveDiff::createAndersenWaveDiff(pag);
 
     // Add symbols for all of the functions and the instructions in them.
     for (const SVFFunction* F : module->getFunctionSet())
@@ -159,18 +203,131 @@ void MTA::detect(SVFModule* module)
         }
     }
 
-    for (Set<const LoadStmt*>::const_iterator lit = loads.begin(), elit = loads.end(); lit != elit; ++lit)
+    std::vector<const LoadStmt*> loadVec;
+    for (const LoadStmt* load : loads)
+    {
+        if (!SVFUtil::isa<GlobalICFGNode>(load->getICFGNode()))
+            loadVec.push_back(load);
+    }
+    std::vector<const StoreStmt*> storeVec;
+    for (const StoreStmt* store : stores)
+    {
+        if (!SVFUtil::isa<GlobalICFGNode>(store->getICFGNode()))
+            storeVec.push_back(store);
+    }
+
+    /// Thread statements of every access, shared by the accesses of an ICFG node
+    Map<const ICFGNode*, std::unique_ptr<AccessThreads>> nodeThreads;
+    NodeBS multiForked;
+    auto getAccessThreads = [&](const ICFGNode* node) -> const AccessThreads*
+    {
+        if (!mhp->hasThreadStmtSet(node))
+            return nullptr;
+        std::unique_ptr<AccessThreads>& threads = nodeThreads[node];
+        if (threads == nullptr)
+        {
+            threads = std::make_unique<AccessThreads>();
+            for (const CxtThreadStmt& ts : mhp->getThreadStmtSet(node))
+            {
+                const NodeBS& interleaved = mhp->getInterleavingThreads(ts);
+                threads->interleavings.push_back(std::make_pair(ts.getTid(), interleaved));
+                threads->tids.set(ts.getTid());
+                threads->interleaved |= interleaved;
+                if (tct->getTCTNode(ts.getTid())->isMultiforked())
+                    multiForked.set(ts.getTid());
+            }
+        }
+        return threads.get();
+    };
+
+    /// Stores by the objects they may write; a store through a pointer to the
+    /// black hole may alias any load, as may such a load with any store
+    Map<NodeID, std::vector<u32_t>> objToStores;
+    std::vector<u32_t> anyObjStores;
+    std::vector<const AccessThreads*> storeThreads(storeVec.size());
+    for (u32_t i = 0; i < storeVec.size(); ++i)
     {
-        const LoadStmt* load = *lit;
-        for (Set<const StoreStmt*>::const_iterator sit = stores.begin(), esit = stores.end(); sit != esit; ++sit)
+        const StoreStmt* store = storeVec[i];
+        storeThreads[i] = getAccessThreads(store->getICFGNode());
+        PointsTo pts;
+        pta->expandFIObjs(pta->getPts(store->getLHSVarID()), pts);
+        if (pta->containBlackHoleNode(pts))
+            anyObjStores.push_back(i);
+        else
         {
-            const StoreStmt* store = *sit;
-            if(SVFUtil::isa<GlobalICFGNode>(load->getICFGNode()) || SVFUtil::isa<GlobalICFGNode>(store->getICFGNode()))
+            for (NodeID o : pts)
+                objToStores[o].push_back(i);
+        }
+    }
+    std::vector<PointsTo> loadPts(loadVec.size());
+    std::vector<const AccessThreads*> loadThreads(loadVec.size());
+    std::vector<u32_t> loadIds(loadVec.size());
+    for (u32_t i = 0; i < loadVec.size(); ++i)
+    {
+        loadThreads[i] = getAccessThreads(loadVec[i]->getICFGNode());
+        pta->expandFIObjs(pta->getPts(loadVec[i]->getRHSVarID()), loadPts[i]);
+        loadIds[i] = i;
+    }
+
+    /// Check the candidate pairs of each load
+    lsa->prepareConcurrentQueries();
+    u32_t numOfThreads = std::max(Options::MTAThreads(), 1u);
+    std::vector<std::vector<u32_t>> racingStores(loadVec.size());
+    std::vector<u32_t> numOfMHPPairs(numOfThreads, 0);
+    std::vector<std::vector<u32_t>> lastLoadOfStore(numOfThreads);
+    WorkStealingList<u32_t>::forEach(loadIds, numOfThreads, [&](u32_t l, u32_t tid)
+    {
+        std::vector<u32_t>& seen = lastLoadOfStore[tid];
+        if (seen.empty())
+            seen.resize(storeVec.size(), UINT_MAX);
+        std::vector<u32_t> candidates;
+        auto addCandidates = [&](const std::vector<u32_t>& storeIds)
+        {
+            for (u32_t s : storeIds)
+            {
+                if (seen[s] != l)
+                {
+                    seen[s] = l;
+                    candidates.push_back(s);
+                }
+            }
+        };
+        if (pta->containBlackHoleNode(loadPts[l]))
+        {
+            for (u32_t s = 0; s < storeVec.size(); ++s)
+                candidates.push_back(s);
+        }
+        else
+        {
+            addCandidates(anyObjStores);
+            for (NodeID o : loadPts[l])
+            {
+                Map<NodeID, std::vector<u32_t>>::const_iterator it = objToStores.find(o);
+                if (it != objToStores.end())
+                    addCandidates(it->second);
+            }
+            std::sort(candidates.begin(), candidates.end());
+        }
+
+        const ICFGNode* loadNode = loadVec[l]->getICFGNode();
+        for (u32_t s : candidates)
+        {
+            if (!mayHappenInParallel(loadThreads[l], storeThreads[s], multiForked))
                 continue;
-            if(mhp->mayHappenInParallelInst(load->getICFGNode(),store->getICFGNode()) && pta->alias(load->getRHSVarID(),store->getLHSVarID()))
-                if(lsa->isProtectedByCommonLock(load->getICFGNode(),store->getICFGNode()) == false)
-                    outs() << SVFUtil::bugMsg1("race pair(") << " store: " << store->toString() << ", load: " << load->toString() << SVFUtil::bugMsg1(")") << "\n";
+            numOfMHPPairs[tid]++;
+            if (lsa->hasCommonLock(loadNode, storeVec[s]->getICFGNode()) == false)
+                racingStores[l].push_back(s);
         }
+    });
+
+    for (u32_t n : numOfMHPPairs)
+    {
+        mhp->numOfMHPQueries += n;
+        lsa->numOfTotalQueries += n;
+    }
+    for (u32_t l = 0; l < loadVec.size(); ++l)
+    {
+        for (u32_t s : racingStores[l])
+            outs() << SVFUtil::bugMsg1("race pair(") << " store: " << storeVec[s]->toString() << ", load: " << loadVec[l]->toString() << SVFUtil::bugMsg1(")") << "\n";
     }
 }
-
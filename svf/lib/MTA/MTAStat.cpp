@@ -99,6 +99,7 @@ void MTAStat::performTCTStat(TCT* tct)
     PTNumStatMap["NumOfTCTNode"] = tct->getTCTNodeNum();
     PTNumStatMap["NumOfTCTEdge"] = tct->getTCTEdgeNum();
     PTNumStatMap["MaxCxtSize"] = tct->getMaxCxtSize();
+    PTNumStatMap["NumOfCallStrCxt"] = CallStrCxt::getNumOfCxts();
     timeStatMap["BuildingTCTTime"] = TCTTime;
     SVFUtil::outs() << "\n****Thread Creation Tree Statistics****\n";
     PTAStat::printStat();
@@ -67,9 +67,12 @@ const std::string PointerAnalysis::aliasTestFailNoAliasMangled  = "_Z20EXPECTEDF
  * Constructor
  */
 PointerAnalysis::PointerAnalysis(SVFIR* p, PTATY ty, bool alias_check) :
-    svfMod(nullptr),ptaTy(ty),stat(nullptr),callgraph(nullptr),callGraphSCC(nullptr),icfg(nullptr),chgraph(nullptr)
+    svfMod(nullptr),ptaTy(ty),stat(nullptr),callgraph(nullptr),callGraphSCC(nullptr),icfg(nullptr),chgraph(nullptr),sbvArena(nullptr)
 {
     pag = p;
+    /// members of derived analyses are constructed after this, so they already use the arena
+    if (Options::SBVArena())
+        sbvArena = SparseBitVectorArena::push();
     OnTheFlyIterBudgetForStat = Options::StatBudget();
     print_stat = Options::PStat();
     ptaImplTy = BaseImpl;
@@ -84,6 +87,11 @@ PointerAnalysis::~PointerAnalysis()
     destroy();
     // do not delete the SVFIR for now
     //delete pag;
+
+    /// the blocks of the arena are freed once the elements still allocated from
+    /// them (e.g., in points-to sets kept by clients) are freed too
+    if (sbvArena)
+        sbvArena->release();
 }
 
 
@@ -31,8 +31,6 @@
 
 #include "MemoryModel/PointerAnalysisImpl.h"
 #include "Util/Options.h"
-#include <fstream>
-#include <sstream>
 
 #include "Graphs/CallGraph.h"
 
@@ -162,15 +160,26 @@ void BVDataPTAImpl::remapPointsToSets(void)
 void BVDataPTAImpl::writeObjVarToFile(const string& filename)
 {
     outs() << "Storing ObjVar to '" << filename << "'...";
-    error_code err;
-    std::fstream f(filename.c_str(), std::ios_base::out);
+    PointsToFileWriter f(filename, false);
     if (!f.good())
     {
         outs() << "  error opening file for writing!\n";
         return;
     }
 
+    writeObjFieldSensitivityToFile(f);
+
+    if (f.good())
+    {
+        outs() << "\n";
+        return;
+    }
+}
+
+void BVDataPTAImpl::writeObjFieldSensitivityToFile(PointsToFileWriter& f)
+{
     // Write BaseNodes insensitivity to file
+    f.beginSection(PointsToFile::ObjFieldSensitivity);
     NodeBS NodeIDs;
     for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
     {
@@ -178,64 +187,42 @@ void BVDataPTAImpl::writeObjVarToFile(const string& filename)
         if (!isa<ObjVar>(pagNode)) continue;
         NodeID n = pag->getBaseObjVar(it->first);
         if (NodeIDs.test(n)) continue;
-        f << n << " ";
-        f << isFieldInsensitive(n) << "\n";
+        f.writeVarint(n);
+        f.writeVarint(isFieldInsensitive(n));
         NodeIDs.set(n);
     }
-
-    f << "------\n";
-
-    f.close();
-    if (f.good())
-    {
-        outs() << "\n";
-        return;
-    }
-
-
+    f.endSection();
 }
 
-void BVDataPTAImpl::writePtsResultToFile(std::fstream& f)
+void BVDataPTAImpl::writePtsResultToFile(PointsToFileWriter& f)
 {
-    // Write analysis results to file
+    // Write analysis results to file, each distinct points-to set is stored once
+    f.beginSection(PointsToFile::PtsResult);
     for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
     {
         NodeID var = it->first;
         const PointsTo &pts = getPts(var);
+        if (pts.empty()) continue;
 
-        stringstream ss;
-        f << var << " -> { ";
-        if (pts.empty())
-        {
-            f << " ";
-        }
-        else
-        {
-            for (NodeID n: pts)
-            {
-                f << n << " ";
-            }
-        }
-        f << "}\n";
+        f.writeVarint(var);
+        f.writePts(pts);
     }
-
+    f.endSection();
 }
 
-void BVDataPTAImpl::writeGepObjVarMapToFile(std::fstream& f)
+void BVDataPTAImpl::writeGepObjVarMapToFile(PointsToFileWriter& f)
 {
     //write gepObjVarMap to file(in form of: baseID offset gepObjNodeId)
+    f.beginSection(PointsToFile::GepObjVarMap);
     SVFIR::NodeOffsetMap &gepObjVarMap = pag->getGepObjNodeMap();
     for(SVFIR::NodeOffsetMap::const_iterator it = gepObjVarMap.begin(), eit = gepObjVarMap.end(); it != eit; it++)
     {
         const SVFIR::NodeOffset offsetPair = it -> first;
-        //write the base id to file
-        f << offsetPair.first << " ";
-        //write the offset to file
-        f << offsetPair.second << " ";
-        //write the gepObjNodeId to file
-        f << it->second << "\n";
+        f.writeVarint(offsetPair.first);
+        f.writeSignedVarint(offsetPair.second);
+        f.writeVarint(it->second);
     }
-
+    f.endSection();
 }
 
 /*!
@@ -248,8 +235,7 @@ void BVDataPTAImpl::writeToFile(const string& filename)
 
     outs() << "Storing pointer analysis results to '" << filename << "'...";
 
-    error_code err;
-    std::fstream f(filename.c_str(), std::ios_base::app);
+    PointsToFileWriter f(filename, true);
     if (!f.good())
     {
         outs() << "  error opening file for writing!\n";
@@ -258,27 +244,11 @@ void BVDataPTAImpl::writeToFile(const string& filename)
 
     writePtsResultToFile(f);
 
-    f << "------\n";
-
     writeGepObjVarMapToFile(f);
 
-    f << "------\n";
-
-    // Write BaseNodes insensitivity to file
-    NodeBS NodeIDs;
-    for (auto it = pag->begin(), ie = pag->end(); it != ie; ++it)
-    {
-        PAGNode* pagNode = it->second;
-        if (!isa<ObjVar>(pagNode)) continue;
-        NodeID n = pag->getBaseObjVar(it->first);
-        if (NodeIDs.test(n)) continue;
-        f << n << " ";
-        f << isFieldInsensitive(n) << "\n";
-        NodeIDs.set(n);
-    }
+    writeObjFieldSensitivityToFile(f);
 
-    // Job finish and close file
-    f.close();
+    // Job finish
     if (f.good())
     {
         outs() << "\n";
@@ -286,75 +256,32 @@ void BVDataPTAImpl::writeToFile(const string& filename)
     }
 }
 
-void BVDataPTAImpl::readPtsResultFromFile(std::ifstream& F)
+void BVDataPTAImpl::readPtsResultFromFile(PointsToFileReader& F)
 {
-    string line;
     // Read analysis results from file
     PTDataTy *ptD = getPTDataTy();
 
-    // Read points-to sets
-    string delimiter1 = " -> { ";
-    string delimiter2 = " }";
-    map<NodeID, string> nodePtsMap;
-    map<string, PointsTo> strPtsMap;
-
-    while (F.good())
+    // Points-to sets shared by several variables are decoded only once by the reader.
+    if (!F.seekSection(PointsToFile::PtsResult))
+        return;
+    while (!F.atSectionEnd())
     {
-        // Parse a single line in the form of "var -> { obj1 obj2 obj3 }"
-        getline(F, line);
-        if (line.at(0) == '[' || line == "---VERSIONED---") continue;
-        if (line == "------")     break;
-        size_t pos = line.find(delimiter1);
-        if (pos == string::npos)    break;
-        if (line.back() != '}')     break;
-
-        // var
-        NodeID var = atoi(line.substr(0, pos).c_str());
-
-        // objs
-        pos = pos + delimiter1.length();
-        size_t len = line.length() - pos - delimiter2.length();
-        string objs = line.substr(pos, len);
-        PointsTo dstPts;
-
-        if (!objs.empty())
-        {
-            // map the variable ID to its unique string pointer set
-            nodePtsMap[var] = objs;
-            if (strPtsMap.count(objs)) continue;
-
-            istringstream ss(objs);
-            NodeID obj;
-            while (ss.good())
-            {
-                ss >> obj;
-                dstPts.set(obj);
-            }
-            // map the string pointer set to the parsed PointsTo set
-            strPtsMap[objs] = dstPts;
-        }
+        NodeID var = F.readVarint();
+        ptD->unionPts(var, F.readPts());
     }
-
-    // map the variable ID to its pointer set
-    for (auto t: nodePtsMap)
-        ptD->unionPts(t.first, strPtsMap[t.second]);
 }
 
-void BVDataPTAImpl::readGepObjVarMapFromFile(std::ifstream& F)
+void BVDataPTAImpl::readGepObjVarMapFromFile(PointsToFileReader& F)
 {
-    string line;
     //read GepObjVarMap from file
     SVFIR::NodeOffsetMap gepObjVarMap = pag->getGepObjNodeMap();
-    while (F.good())
+    if (!F.seekSection(PointsToFile::GepObjVarMap))
+        return;
+    while (!F.atSectionEnd())
     {
-        getline(F, line);
-        if (line == "------")     break;
-        // Parse a single line in the form of "ID baseNodeID offset"
-        istringstream ss(line);
-        NodeID base;
-        size_t offset;
-        NodeID id;
-        ss >> base >> offset >>id;
+        NodeID base = F.readVarint();
+        APOffset offset = F.readSignedVarint();
+        NodeID id = F.readVarint();
         SVFIR::NodeOffsetMap::const_iterator iter = gepObjVarMap.find(std::make_pair(base, offset));
         if (iter == gepObjVarMap.end())
         {
@@ -382,20 +309,15 @@ void BVDataPTAImpl::readGepObjVarMapFromFile(std::ifstream& F)
     }
 }
 
-void BVDataPTAImpl::readAndSetObjFieldSensitivity(std::ifstream& F, const std::string& delimiterStr)
+void BVDataPTAImpl::readAndSetObjFieldSensitivity(PointsToFileReader& F)
 {
-    string line;
     // //update ObjVar status
-    while (F.good())
+    if (!F.seekSection(PointsToFile::ObjFieldSensitivity))
+        return;
+    while (!F.atSectionEnd())
     {
-        getline(F, line);
-        if (line.empty() || line == delimiterStr)
-            break;
-        // Parse a single line in the form of "baseNodeID insensitive"
-        istringstream ss(line);
-        NodeID base;
-        bool insensitive;
-        ss >> base >> insensitive;
+        NodeID base = F.readVarint();
+        bool insensitive = F.readVarint();
 
         if (insensitive)
             setObjFieldInsensitive(base);
@@ -413,25 +335,24 @@ bool BVDataPTAImpl::readFromFile(const string& filename)
 
     outs() << "Loading pointer analysis results from '" << filename << "'...";
 
-    ifstream F(filename.c_str());
-    if (!F.is_open())
+    PointsToFileReader F(filename);
+    if (!F.good())
     {
         outs() << "  error opening file for reading!\n";
         return false;
     }
 
-    readAndSetObjFieldSensitivity(F,"------");
+    readAndSetObjFieldSensitivity(F);
 
     readPtsResultFromFile(F);
 
     readGepObjVarMapFromFile(F);
 
-    readAndSetObjFieldSensitivity(F,"");
+    readAndSetObjFieldSensitivity(F);
 
     // Update callgraph
     updateCallGraph(pag->getIndirectCallsites());
 
-    F.close();
     outs() << "\n";
 
     return true;
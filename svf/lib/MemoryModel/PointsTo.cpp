@@ -29,6 +29,7 @@ PointsTo::PointsTo()
     if (type == SBV) new (&sbv) SparseBitVector<>();
     else if (type == CBV) new (&cbv) CoreBitVector();
     else if (type == BV) new (&bv) BitVector();
+    else if (type == RBV) new (&rbv) RoaringBitVector();
     else assert(false && "PointsTo::PointsTo: unknown type");
 }
 
@@ -39,6 +40,7 @@ PointsTo::PointsTo(const PointsTo &pt)
     if (type == SBV) new (&sbv) SparseBitVector<>(pt.sbv);
     else if (type == CBV) new (&cbv) CoreBitVector(pt.cbv);
     else if (type == BV) new (&bv) BitVector(pt.bv);
+    else if (type == RBV) new (&rbv) RoaringBitVector(pt.rbv);
     else assert(false && "PointsTo::PointsTo&: unknown type");
 }
 
@@ -49,32 +51,41 @@ noexcept     : type(pt.type), nodeMapping(std::move(pt.nodeMapping)),
     if (type == SBV) new (&sbv) SparseBitVector<>(std::move(pt.sbv));
     else if (type == CBV) new (&cbv) CoreBitVector(std::move(pt.cbv));
     else if (type == BV) new (&bv) BitVector(std::move(pt.bv));
+    else if (type == RBV) new (&rbv) RoaringBitVector(std::move(pt.rbv));
     else assert(false && "PointsTo::PointsTo&&: unknown type");
 }
 
 PointsTo::~PointsTo()
 {
-    if (type == SBV) sbv.~SparseBitVector<>();
-    else if (type == CBV) cbv.~CoreBitVector();
-    else if (type == BV) bv.~BitVector();
-    else assert(false && "PointsTo::~PointsTo: unknown type");
+    destroyBacking();
 
     nodeMapping = nullptr;
     reverseNodeMapping = nullptr;
 }
 
+void PointsTo::destroyBacking()
+{
+    if (type == SBV) sbv.~SparseBitVector<>();
+    else if (type == CBV) cbv.~CoreBitVector();
+    else if (type == BV) bv.~BitVector();
+    else if (type == RBV) rbv.~RoaringBitVector();
+    else assert(false && "PointsTo::destroyBacking: unknown type");
+}
+
 PointsTo &PointsTo::operator=(const PointsTo &rhs)
 {
     if (this == &rhs)
         return *this;
+    destroyBacking();
     this->type = rhs.type;
     this->nodeMapping = rhs.nodeMapping;
     this->reverseNodeMapping = rhs.reverseNodeMapping;
     // Placement new because if type has changed, we have
-    // not constructed the new type yet.
+    // not constructed the new type yet (the old one is destroyed above).
     if (type == SBV) new (&sbv) SparseBitVector<>(rhs.sbv);
     else if (type == CBV) new (&cbv) CoreBitVector(rhs.cbv);
     else if (type == BV) new (&bv) BitVector(rhs.bv);
+    else if (type == RBV) new (&rbv) RoaringBitVector(rhs.rbv);
     else assert(false && "PointsTo::PointsTo=&: unknown type");
 
     return *this;
@@ -83,6 +94,9 @@ PointsTo &PointsTo::operator=(const PointsTo &rhs)
 PointsTo &PointsTo::operator=(PointsTo &&rhs)
 noexcept
 {
+    if (this == &rhs)
+        return *this;
+    destroyBacking();
     this->type = rhs.type;
     this->nodeMapping = rhs.nodeMapping;
     this->reverseNodeMapping = rhs.reverseNodeMapping;
@@ -90,6 +104,7 @@ noexcept
     if (type == SBV) new (&sbv) SparseBitVector<>(std::move(rhs.sbv));
     else if (type == CBV) new (&cbv) CoreBitVector(std::move(rhs.cbv));
     else if (type == BV) new (&bv) BitVector(std::move(rhs.bv));
+    else if (type == RBV) new (&rbv) RoaringBitVector(std::move(rhs.rbv));
     else assert(false && "PointsTo::PointsTo=&&: unknown type");
 
     return *this;
@@ -100,6 +115,7 @@ bool PointsTo::empty() const
     if (type == CBV) return cbv.empty();
     else if (type == SBV) return sbv.empty();
     else if (type == BV) return bv.empty();
+    else if (type == RBV) return rbv.empty();
     else
     {
         assert(false && "PointsTo::empty: unknown type");
@@ -113,6 +129,7 @@ u32_t PointsTo::count(void) const
     if (type == CBV) return cbv.count();
     else if (type == SBV) return sbv.count();
     else if (type == BV) return bv.count();
+    else if (type == RBV) return rbv.count();
     else
     {
         assert(false && "PointsTo::count: unknown type");
@@ -125,6 +142,7 @@ void PointsTo::clear()
     if (type == CBV) cbv.clear();
     else if (type == SBV) sbv.clear();
     else if (type == BV) bv.clear();
+    else if (type == RBV) rbv.clear();
     else assert(false && "PointsTo::clear: unknown type");
 }
 
@@ -134,6 +152,7 @@ bool PointsTo::test(u32_t n) const
     if (type == CBV) return cbv.test(n);
     else if (type == SBV) return sbv.test(n);
     else if (type == BV) return bv.test(n);
+    else if (type == RBV) return rbv.test(n);
     else
     {
         assert(false && "PointsTo::test: unknown type");
@@ -147,6 +166,7 @@ bool PointsTo::test_and_set(u32_t n)
     if (type == CBV) return cbv.test_and_set(n);
     else if (type == SBV) return sbv.test_and_set(n);
     else if (type == BV) return bv.test_and_set(n);
+    else if (type == RBV) return rbv.test_and_set(n);
     else
     {
         assert(false && "PointsTo::test_and_set: unknown type");
@@ -160,6 +180,7 @@ void PointsTo::set(u32_t n)
     if (type == CBV) cbv.set(n);
     else if (type == SBV) sbv.set(n);
     else if (type == BV) bv.set(n);
+    else if (type == RBV) rbv.set(n);
     else assert(false && "PointsTo::set: unknown type");
 }
 
@@ -169,6 +190,7 @@ void PointsTo::reset(u32_t n)
     if (type == CBV) cbv.reset(n);
     else if (type == SBV) sbv.reset(n);
     else if (type == BV) bv.reset(n);
+    else if (type == RBV) rbv.reset(n);
     else assert(false && "PointsTo::reset: unknown type");
 }
 
@@ -179,6 +201,7 @@ bool PointsTo::contains(const PointsTo &rhs) const
     if (type == CBV) return cbv.contains(rhs.cbv);
     else if (type == SBV) return sbv.contains(rhs.sbv);
     else if (type == BV) return bv.contains(rhs.bv);
+    else if (type == RBV) return rbv.contains(rhs.rbv);
     else
     {
         assert(false && "PointsTo::contains: unknown type");
@@ -193,6 +216,7 @@ bool PointsTo::intersects(const PointsTo &rhs) const
     if (type == CBV) return cbv.intersects(rhs.cbv);
     else if (type == SBV) return sbv.intersects(rhs.sbv);
     else if (type == BV) return bv.intersects(rhs.bv);
+    else if (type == RBV) return rbv.intersects(rhs.rbv);
     else
     {
         assert(false && "PointsTo::intersects: unknown type");
@@ -213,6 +237,7 @@ bool PointsTo::operator==(const PointsTo &rhs) const
     if (type == CBV) return cbv == rhs.cbv;
     else if (type == SBV) return sbv == rhs.sbv;
     else if (type == BV) return bv == rhs.bv;
+    else if (type == RBV) return rbv == rhs.rbv;
     else
     {
         assert(false && "PointsTo::==: unknown type");
@@ -235,6 +260,7 @@ bool PointsTo::operator|=(const PointsTo &rhs)
     if (type == CBV) return cbv |= rhs.cbv;
     else if (type == SBV) return sbv |= rhs.sbv;
     else if (type == BV) return bv |= rhs.bv;
+    else if (type == RBV) return rbv |= rhs.rbv;
     else
     {
         assert(false && "PointsTo::|=: unknown type");
@@ -262,6 +288,7 @@ bool PointsTo::operator&=(const PointsTo &rhs)
     if (type == CBV) return cbv &= rhs.cbv;
     else if (type == SBV) return sbv &= rhs.sbv;
     else if (type == BV) return bv &= rhs.bv;
+    else if (type == RBV) return rbv &= rhs.rbv;
     else
     {
         assert(false && "PointsTo::&=: unknown type");
@@ -276,6 +303,7 @@ bool PointsTo::operator-=(const PointsTo &rhs)
     if (type == CBV) return cbv.intersectWithComplement(rhs.cbv);
     else if (type == SBV) return sbv.intersectWithComplement(rhs.sbv);
     else if (type == BV) return bv.intersectWithComplement(rhs.bv);
+    else if (type == RBV) return rbv.intersectWithComplement(rhs.rbv);
     else
     {
         assert(false && "PointsTo::-=: unknown type");
@@ -290,6 +318,7 @@ bool PointsTo::intersectWithComplement(const PointsTo &rhs)
     if (type == CBV) return cbv.intersectWithComplement(rhs.cbv);
     else if (type == SBV) return sbv.intersectWithComplement(rhs.sbv);
     else if (type == BV) return bv.intersectWithComplement(rhs.bv);
+    else if (type == RBV) return rbv.intersectWithComplement(rhs.rbv);
 
     assert(false && "PointsTo::intersectWithComplement(PT): unknown type");
     abort();
@@ -303,6 +332,7 @@ void PointsTo::intersectWithComplement(const PointsTo &lhs, const PointsTo &rhs)
     if (type == CBV) cbv.intersectWithComplement(lhs.cbv, rhs.cbv);
     else if (type == SBV) sbv.intersectWithComplement(lhs.sbv, rhs.sbv);
     else if (type == BV) bv.intersectWithComplement(lhs.bv, rhs.bv);
+    else if (type == RBV) rbv.intersectWithComplement(lhs.rbv, rhs.rbv);
     else
     {
         assert(false && "PointsTo::intersectWithComplement(PT, PT): unknown type");
@@ -326,6 +356,7 @@ size_t PointsTo::hash() const
         return h(sbv);
     }
     else if (type == BV) return bv.hash();
+    else if (type == RBV) return rbv.hash();
 
     else
     {
@@ -401,6 +432,10 @@ PointsTo::PointsToIterator::PointsToIterator(const PointsTo *pt, bool end)
     {
         new (&bvIt) BitVector::iterator(end ? pt->bv.end() : pt->bv.begin());
     }
+    else if (pt->type == Type::RBV)
+    {
+        new (&rbvIt) RoaringBitVector::iterator(end ? pt->rbv.end() : pt->rbv.begin());
+    }
     else
     {
         assert(false && "PointsToIterator::PointsToIterator: unknown type");
@@ -423,6 +458,10 @@ PointsTo::PointsToIterator::PointsToIterator(const PointsToIterator &pt)
     {
         new (&bvIt) BitVector::iterator(pt.bvIt);
     }
+    else if (this->pt->type == PointsTo::Type::RBV)
+    {
+        new (&rbvIt) RoaringBitVector::iterator(pt.rbvIt);
+    }
     else
     {
         assert(false && "PointsToIterator::PointsToIterator&: unknown type");
@@ -445,6 +484,10 @@ noexcept     : pt(pt.pt)
     {
         new (&bvIt) BitVector::iterator(std::move(pt.bvIt));
     }
+    else if (this->pt->type == PointsTo::Type::RBV)
+    {
+        new (&rbvIt) RoaringBitVector::iterator(std::move(pt.rbvIt));
+    }
     else
     {
         assert(false && "PointsToIterator::PointsToIterator&&: unknown type");
@@ -468,6 +511,10 @@ PointsTo::PointsToIterator &PointsTo::PointsToIterator::operator=(const PointsTo
     {
         new (&bvIt) BitVector::iterator(rhs.bvIt);
     }
+    else if (this->pt->type == PointsTo::Type::RBV)
+    {
+        new (&rbvIt) RoaringBitVector::iterator(rhs.rbvIt);
+    }
     else assert(false && "PointsToIterator::PointsToIterator&: unknown type");
 
     return *this;
@@ -489,6 +536,10 @@ PointsTo::PointsToIterator &PointsTo::PointsToIterator::operator=(PointsToIterat
     {
         new (&bvIt) BitVector::iterator(std::move(rhs.bvIt));
     }
+    else if (this->pt->type == PointsTo::Type::RBV)
+    {
+        new (&rbvIt) RoaringBitVector::iterator(std::move(rhs.rbvIt));
+    }
     else assert(false && "PointsToIterator::PointsToIterator&&: unknown type");
 
     return *this;
@@ -500,6 +551,7 @@ const PointsTo::PointsToIterator &PointsTo::PointsToIterator::operator++()
     if (pt->type == Type::CBV) ++cbvIt;
     else if (pt->type == Type::SBV) ++sbvIt;
     else if (pt->type == Type::BV) ++bvIt;
+    else if (pt->type == Type::RBV) ++rbvIt;
     else assert(false && "PointsToIterator::++(void): unknown type");
 
     return *this;
@@ -519,6 +571,7 @@ NodeID PointsTo::PointsToIterator::operator*() const
     if (pt->type == Type::CBV) return pt->getExternalNode(*cbvIt);
     else if (pt->type == Type::SBV) return pt->getExternalNode(*sbvIt);
     else if (pt->type == Type::BV) return pt->getExternalNode(*bvIt);
+    else if (pt->type == Type::RBV) return pt->getExternalNode(*rbvIt);
     else
     {
         assert(false && "PointsToIterator::*: unknown type");
@@ -535,6 +588,7 @@ bool PointsTo::PointsToIterator::operator==(const PointsToIterator &rhs) const
     if (pt->type == Type::CBV) return cbvIt == rhs.cbvIt;
     else if (pt->type == Type::SBV) return sbvIt == rhs.sbvIt;
     else if (pt->type == Type::BV) return bvIt == rhs.bvIt;
+    else if (pt->type == Type::RBV) return rbvIt == rhs.rbvIt;
     else
     {
         assert(false && "PointsToIterator::==: unknown type");
@@ -555,6 +609,7 @@ bool PointsTo::PointsToIterator::atEnd() const
     if (pt->type == Type::CBV) return cbvIt == pt->cbv.end();
     else if (pt->type == Type::SBV) return sbvIt == pt->sbv.end();
     else if (pt->type == Type::BV) return bvIt == pt->bv.end();
+    else if (pt->type == Type::RBV) return rbvIt == pt->rbv.end();
     else
     {
         assert(false && "PointsToIterator::atEnd: unknown type");
@@ -0,0 +1,289 @@
+//===- PointsToFile.cpp -- Binary store of points-to results ------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * PointsToFile.cpp
+ */
+
+#include "MemoryModel/PointsToFile.h"
+#include "Util/SVFUtil.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SVF;
+using namespace SVFUtil;
+
+const char PointsToFile::Magic[8] = {'S', 'V', 'F', 'P', 'T', 'S', 'E', 'T'};
+const u32_t PointsToFile::Version = 1;
+
+/// A section header is its kind followed by the (fixed width) length of its body.
+static const size_t SectionHeaderSize = sizeof(u8_t) + sizeof(u64_t);
+
+PointsToFileWriter::PointsToFileWriter(const std::string& filename, bool append)
+    : curKind(ObjFieldSensitivity), numOfPts(0)
+{
+    bool writeHeader = true;
+    if (append)
+    {
+        std::ifstream existing(filename, std::ios::binary | std::ios::ate);
+        writeHeader = !existing.is_open() || existing.tellg() == 0;
+        if (!writeHeader)
+        {
+            // Only append to a points-to file of this version.
+            char header[sizeof(Magic) + sizeof(Version)];
+            u32_t version = 0;
+            existing.seekg(0);
+            existing.read(header, sizeof(header));
+            if (existing.gcount() == static_cast<std::streamsize>(sizeof(header)))
+                std::memcpy(&version, header + sizeof(Magic), sizeof(version));
+            if (existing.gcount() != static_cast<std::streamsize>(sizeof(header)) ||
+                    std::memcmp(header, Magic, sizeof(Magic)) != 0 || version != Version)
+            {
+                SVFUtil::errs() << "\n'" << filename << "' is not a points-to file of this version of SVF, not appending to it";
+                os.setstate(std::ios::failbit);
+                return;
+            }
+        }
+    }
+
+    os.open(filename, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+    if (os.good() && writeHeader)
+    {
+        os.write(Magic, sizeof(Magic));
+        os.write(reinterpret_cast<const char*>(&Version), sizeof(Version));
+    }
+}
+
+void PointsToFileWriter::appendVarint(std::string& buf, u64_t v)
+{
+    while (v >= 0x80)
+    {
+        buf.push_back(static_cast<char>((v & 0x7f) | 0x80));
+        v >>= 7;
+    }
+    buf.push_back(static_cast<char>(v));
+}
+
+void PointsToFileWriter::beginSection(SectionKind kind)
+{
+    curKind = kind;
+    records.clear();
+    ptsCache.reset();
+    numOfPts = 0;
+}
+
+void PointsToFileWriter::writeVarint(u64_t v)
+{
+    appendVarint(records, v);
+}
+
+void PointsToFileWriter::writeSignedVarint(s64_t v)
+{
+    // zigzag encoding keeps small negative numbers short
+    appendVarint(records, (static_cast<u64_t>(v) << 1) ^ static_cast<u64_t>(v >> 63));
+}
+
+void PointsToFileWriter::writePts(const PointsTo& pts)
+{
+    PointsToID id = pts.empty() ? PersistentPointsToCache<PointsTo>::emptyPointsToId() : ptsCache.emplacePts(pts);
+    numOfPts = std::max(numOfPts, id);
+    writeVarint(id);
+}
+
+/*!
+ * Emit the current section: the header, the points-to sets interned so far
+ * (IDs are handed out consecutively from 1) and the records.
+ */
+void PointsToFileWriter::endSection()
+{
+    std::string body;
+    appendVarint(body, numOfPts);
+    std::vector<NodeID> elems;
+    for (PointsToID id = 1; id <= numOfPts; ++id)
+    {
+        // With a node mapping, PointsTo is not iterated in ascending order.
+        const PointsTo& pts = ptsCache.getActualPts(id);
+        elems.assign(pts.begin(), pts.end());
+        std::sort(elems.begin(), elems.end());
+
+        appendVarint(body, elems.size());
+        NodeID prev = 0;
+        for (NodeID n : elems)
+        {
+            appendVarint(body, n - prev);
+            prev = n;
+        }
+    }
+    body += records;
+
+    u8_t kind = curKind;
+    u64_t length = body.size();
+    os.write(reinterpret_cast<const char*>(&kind), sizeof(kind));
+    os.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    os.write(body.data(), body.size());
+
+    records.clear();
+    ptsCache.reset();
+    numOfPts = 0;
+}
+
+PointsToFileReader::PointsToFileReader(const std::string& filename)
+    : begin(nullptr), end(nullptr), cur(nullptr), sectionEnd(nullptr), size(0)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return;
+    }
+    void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        return;
+
+    size = st.st_size;
+    const char* data = static_cast<const char*>(addr);
+    u32_t version = 0;
+    if (size >= sizeof(Magic) + sizeof(Version))
+        std::memcpy(&version, data + sizeof(Magic), sizeof(version));
+    if (size < sizeof(Magic) + sizeof(Version) || std::memcmp(data, Magic, sizeof(Magic)) != 0 ||
+            version != Version)
+    {
+        SVFUtil::errs() << "\n'" << filename << "' is not a points-to file of this version of SVF";
+        munmap(addr, size);
+        return;
+    }
+
+    begin = data;
+    end = data + size;
+    cur = sectionEnd = begin + sizeof(Magic) + sizeof(Version);
+}
+
+PointsToFileReader::~PointsToFileReader()
+{
+    if (begin)
+        munmap(const_cast<char*>(begin), size);
+}
+
+/// Report a truncated or corrupt points-to file and abort
+[[noreturn]] static void malformed(const char* what)
+{
+    SVFUtil::errs() << "\nPoints-to file is truncated or corrupt: " << what << "\n";
+    abort();
+}
+
+/// Decode a varint at p and advance p
+static inline u64_t decodeVarint(const char*& p, const char* e)
+{
+    u64_t v = 0;
+    for (u32_t shift = 0;; shift += 7)
+    {
+        if (p >= e || shift >= 64)
+            malformed("bad varint");
+        u8_t byte = static_cast<u8_t>(*p++);
+        v |= static_cast<u64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return v;
+    }
+}
+
+bool PointsToFileReader::seekSection(SectionKind kind)
+{
+    assert(good() && "points-to file is not open!");
+    const char* p = sectionEnd;
+    while (p + SectionHeaderSize <= end)
+    {
+        u8_t k = static_cast<u8_t>(*p);
+        u64_t length;
+        std::memcpy(&length, p + sizeof(u8_t), sizeof(length));
+        const char* body = p + SectionHeaderSize;
+        if (length > static_cast<u64_t>(end - body))
+            malformed("section longer than the file");
+        p = body + length;
+        if (k != kind)
+            continue;
+
+        sectionEnd = p;
+        cur = body;
+        // Only remember where each points-to set starts; sets are decoded on first use.
+        u64_t numOfPts = decodeVarint(cur, sectionEnd);
+        // Every set takes at least one byte (its size).
+        if (numOfPts > static_cast<u64_t>(sectionEnd - cur))
+            malformed("more points-to sets than the section can hold");
+        ptsPos.resize(numOfPts);
+        pts.clear();
+        pts.resize(numOfPts);
+        for (u64_t i = 0; i < numOfPts; ++i)
+        {
+            ptsPos[i] = cur;
+            for (u64_t n = decodeVarint(cur, sectionEnd); n > 0; --n)
+                decodeVarint(cur, sectionEnd);
+        }
+        return true;
+    }
+    cur = sectionEnd;
+    return false;
+}
+
+u64_t PointsToFileReader::readVarint()
+{
+    return decodeVarint(cur, sectionEnd);
+}
+
+s64_t PointsToFileReader::readSignedVarint()
+{
+    u64_t v = readVarint();
+    return static_cast<s64_t>((v >> 1) ^ (~(v & 1) + 1));
+}
+
+const PointsTo& PointsToFileReader::readPts()
+{
+    static const PointsTo emptyPts;
+    u64_t id = readVarint();
+    if (id == PersistentPointsToCache<PointsTo>::emptyPointsToId())
+        return emptyPts;
+
+    // IDs are 1-based (0 is the empty set, handled above).
+    if (id > ptsPos.size())
+        malformed("unknown points-to set");
+    std::unique_ptr<PointsTo>& decoded = pts[id - 1];
+    if (!decoded)
+    {
+        decoded = std::make_unique<PointsTo>();
+        const char* p = ptsPos[id - 1];
+        NodeID n = 0;
+        for (u64_t count = decodeVarint(p, sectionEnd); count > 0; --count)
+        {
+            n += decodeVarint(p, sectionEnd);
+            decoded->set(n);
+        }
+    }
+    return *decoded;
+}
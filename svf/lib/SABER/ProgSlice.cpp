@@ -55,9 +55,8 @@ bool ProgSlice::AllPathReachableSolve()
 
         Condition invalidCond = computeInvalidCondFromRemovedSUVFEdge(node);
         Condition cond = getVFCond(node);
-        for(SVFGNode::const_iterator it = node->OutEdgeBegin(), eit = node->OutEdgeEnd(); it!=eit; ++it)
+        for(const SVFGEdge* edge : node->getOutEdgeRange())
         {
-            const SVFGEdge* edge = (*it);
             const SVFGNode* succ = edge->getDstNode();
             if(inBackwardSlice(succ))
             {
@@ -108,9 +107,8 @@ bool ProgSlice::AllPathReachableSolve()
 ProgSlice::Condition ProgSlice::computeInvalidCondFromRemovedSUVFEdge(const SVFGNode * cur)
 {
     Set<const SVFBasicBlock*> validOutBBs; // the BBs of valid successors
-    for(SVFGNode::const_iterator it = cur->OutEdgeBegin(), eit = cur->OutEdgeEnd(); it!=eit; ++it)
+    for(const SVFGEdge* edge : cur->getOutEdgeRange())
     {
-        const SVFGEdge* edge = (*it);
         const SVFGNode* succ = edge->getDstNode();
         if(inBackwardSlice(succ))
         {
@@ -42,13 +42,13 @@ using namespace SVFUtil;
 
 u64_t DPItem::maximumBudget = ULONG_MAX - 1;
 u32_t ContextCond::maximumCxtLen = 0;
-u32_t ContextCond::maximumCxt = 0;
+std::atomic<u32_t> ContextCond::maximumCxt(0);
 u32_t ContextCond::maximumPathLen = 0;
 u32_t ContextCond::maximumPath = 0;
 u32_t SaberCondAllocator::totalCondNum = 0;
 
 
-SaberCondAllocator::SaberCondAllocator()
+SaberCondAllocator::SaberCondAllocator() : useBDD(Options::SaberBDD())
 {
 
 }
@@ -406,7 +406,7 @@ bool SaberCondAllocator::isTestContainsNullAndTheValue(const CmpStmt *cmp) const
     {
         Set<const SVFVar* > inDirVal;
         inDirVal.insert(getCurEvalSVFGNode()->getValue());
-        for (const auto &it: getCurEvalSVFGNode()->getOutEdges())
+        for (const auto &it: getCurEvalSVFGNode()->getOutEdgeRange())
         {
             inDirVal.insert(it->getDstNode()->getValue());
         }
@@ -416,7 +416,7 @@ bool SaberCondAllocator::isTestContainsNullAndTheValue(const CmpStmt *cmp) const
     {
         Set<const SVFVar* > inDirVal;
         inDirVal.insert(getCurEvalSVFGNode()->getValue());
-        for (const auto &it: getCurEvalSVFGNode()->getOutEdges())
+        for (const auto &it: getCurEvalSVFGNode()->getOutEdgeRange())
         {
             inDirVal.insert(it->getDstNode()->getValue());
         }
@@ -602,8 +602,12 @@ void SaberCondAllocator::printPathCond()
 SaberCondAllocator::Condition SaberCondAllocator::newCond(const ICFGNode* inst)
 {
     u32_t condCountIdx = totalCondNum++;
-    Condition expr = Condition::getContext().bool_const(("c" + std::to_string(condCountIdx)).c_str());
-    Condition negCond = Condition::NEG(expr);
+    Condition expr;
+    if (useBDD)
+        expr = BDDExpr::getVarCond(condCountIdx);
+    else
+        expr = Z3Expr(Z3Expr::getContext().bool_const(("c" + std::to_string(condCountIdx)).c_str()));
+    Condition negCond = condNeg(expr);
     setCondInst(expr, inst);
     setNegCondInst(negCond, inst);
     conditionVec.push_back(expr);
@@ -615,19 +619,26 @@ SaberCondAllocator::Condition SaberCondAllocator::newCond(const ICFGNode* inst)
 bool SaberCondAllocator::isEquivalentBranchCond(const Condition &lhs,
         const Condition &rhs) const
 {
-    Condition::getSolver().push();
-    Condition::getSolver().add(lhs.getExpr() != rhs.getExpr()); /// check equal using z3 solver
-    z3::check_result res = Condition::getSolver().check();
-    Condition::getSolver().pop();
+    /// BDDs are canonical, so equivalent conditions are the same node
+    if (useBDD)
+        return lhs.getBDDExpr() == rhs.getBDDExpr();
+
+    Z3Expr::getSolver().push();
+    Z3Expr::getSolver().add(lhs.getZ3Expr().getExpr() != rhs.getZ3Expr().getExpr()); /// check equal using z3 solver
+    z3::check_result res = Z3Expr::getSolver().check();
+    Z3Expr::getSolver().pop();
     return res == z3::unsat;
 }
 
 /// whether condition is satisfiable
 bool SaberCondAllocator::isSatisfiable(const Condition &condition)
 {
-    Condition::getSolver().add(condition.getExpr());
-    z3::check_result result = Condition::getSolver().check();
-    Condition::getSolver().pop();
+    if (useBDD)
+        return !condition.getBDDExpr().isFalse();
+
+    Z3Expr::getSolver().add(condition.getZ3Expr().getExpr());
+    z3::check_result result = Z3Expr::getSolver().check();
+    Z3Expr::getSolver().pop();
     if (result == z3::sat || result == z3::unknown)
         return true;
     else
@@ -637,18 +648,32 @@ bool SaberCondAllocator::isSatisfiable(const Condition &condition)
 /// extract subexpression from a Z3 expression
 void SaberCondAllocator::extractSubConds(const Condition &condition, NodeBS &support) const
 {
-    if (condition.getExpr().num_args() == 1 && isNegCond(condition.id()))
+    const z3::expr& e = condition.getZ3Expr().getExpr();
+    if (e.num_args() == 1 && isNegCond(condition.id()))
     {
-        support.set(condition.getExpr().id());
+        support.set(e.id());
         return;
     }
-    if (condition.getExpr().num_args() == 0)
-        if (!condition.getExpr().is_true() && !condition.getExpr().is_false())
-            support.set(condition.getExpr().id());
-    for (u32_t i = 0; i < condition.getExpr().num_args(); ++i)
+    if (e.num_args() == 0)
+        if (!e.is_true() && !e.is_false())
+            support.set(e.id());
+    for (u32_t i = 0; i < e.num_args(); ++i)
     {
-        Condition expr = condition.getExpr().arg(i);
+        Condition expr = Z3Expr(e.arg(i));
         extractSubConds(expr, support);
     }
 
 }
+
+/// extract the literals of a BDD, as the ids of the allocated conditions or their negations
+void SaberCondAllocator::extractBDDSubConds(const Condition &condition, NodeBS &support) const
+{
+    Set<std::pair<u32_t, bool>> literals;
+    BDDExpr::getLiterals(condition.getBDDExpr(), literals);
+    for (const std::pair<u32_t, bool>& literal : literals)
+    {
+        /// nodes are unique, so these are the nodes of newCond, kept alive by conditionVec
+        BDDExpr var = BDDExpr::getVarCond(literal.first);
+        support.set(literal.second ? var.id() : BDDExpr::NEG(var).id());
+    }
+}
@@ -33,6 +33,7 @@
 #include "Graphs/SVFGStat.h"
 #include "Util/Options.h"
 #include "WPA/Andersen.h"
+#include "Util/WorkList.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -65,47 +66,60 @@ void SrcSnkDDA::analyze(SVFModule* module)
 
     ContextCond::setMaxCxtLen(Options::CxtLimit());
 
-    for (SVFGNodeSetIter iter = sourcesBegin(), eiter = sourcesEnd();
-            iter != eiter; ++iter)
-    {
-        setCurSlice(*iter);
-
-        DBOUT(DGENERAL, outs() << "Analysing slice:" << (*iter)->getId() << ")\n");
-        ContextCond cxt;
-        DPIm item((*iter)->getId(),cxt);
-        forwardTraverse(item);
+    /// Slices are computed by parallel slicers a batch at a time, then their guards are
+    /// solved and bugs reported on this thread in the order of the sources
+    u32_t threads = std::max<u32_t>(1, Options::SaberThreads());
+    std::vector<std::unique_ptr<SrcSnkSlicer>> slicers;
+    for (u32_t tid = 0; tid < threads; ++tid)
+        slicers.push_back(std::make_unique<SrcSnkSlicer>(this, svfg));
 
-        /// do not consider there is bug when reaching a global SVFGNode
-        /// if we touch a global, then we assume the client uses this memory until the program exits.
-        if (getCurSlice()->isReachGlobal())
+    /// visit sources by ID, so that bugs are reported in the same order whatever the thread count
+    std::vector<const SVFGNode*> srcs(sourcesBegin(), sourcesEnd());
+    std::sort(srcs.begin(), srcs.end(), [](const SVFGNode* lhs, const SVFGNode* rhs)
+    {
+        return lhs->getId() < rhs->getId();
+    });
+    const u32_t batchSize = threads * 16;
+    /// the SVFG is only traversed while slicing
+    svfg->freeze();
+    for (u32_t begin = 0; begin < srcs.size(); begin += batchSize)
+    {
+        u32_t end = std::min<u32_t>(begin + batchSize, srcs.size());
+        /// slices copy guards from the condition allocator, so create them on this thread
+        std::vector<ProgSlice*> slices;
+        std::vector<u32_t> indices;
+        for (u32_t i = begin; i < end; ++i)
         {
-            DBOUT(DSaber, outs() << "Forward analysis reaches globals for slice:" << (*iter)->getId() << ")\n");
+            indices.push_back(slices.size());
+            slices.push_back(new ProgSlice(srcs[i], getSaberCondAllocator(), getSVFG()));
         }
-        else
+
+        WorkStealingList<u32_t>::forEach(indices, threads, [&](u32_t i, u32_t tid)
         {
-            DBOUT(DSaber, outs() << "Forward process for slice:" << (*iter)->getId() << " (size = " << getCurSlice()->getForwardSliceSize() << ")\n");
+            slicers[tid]->computeSlice(slices[i]);
+        });
 
-            for (SVFGNodeSetIter sit = getCurSlice()->sinksBegin(), esit =
-                        getCurSlice()->sinksEnd(); sit != esit; ++sit)
-            {
-                ContextCond cxt;
-                DPIm item((*sit)->getId(),cxt);
-                backwardTraverse(item);
-            }
+        for (ProgSlice* slice : slices)
+        {
+            setCurSlice(slice);
 
-            DBOUT(DSaber, outs() << "Backward process for slice:" << (*iter)->getId() << " (size = " << getCurSlice()->getBackwardSliceSize() << ")\n");
+            /// do not consider there is bug when reaching a global SVFGNode
+            /// if we touch a global, then we assume the client uses this memory until the program exits.
+            if (!slice->isReachGlobal())
+            {
+                if(Options::DumpSlice())
+                    annotateSlice(slice);
 
-            if(Options::DumpSlice())
-                annotateSlice(_curSlice);
+                if(slice->AllPathReachableSolve())
+                    slice->setAllReachable();
 
-            if(_curSlice->AllPathReachableSolve())
-                _curSlice->setAllReachable();
+                DBOUT(DSaber, outs() << "Guard computation for slice:" << slice->getSource()->getId() << ")\n");
+            }
 
-            DBOUT(DSaber, outs() << "Guard computation for slice:" << (*iter)->getId() << ")\n");
+            reportBug(slice);
         }
-
-        reportBug(getCurSlice());
     }
+    svfg->thaw();
     finalize();
 
 }
@@ -136,10 +150,8 @@ bool SrcSnkDDA::isInAWrapper(const SVFGNode* src, CallSiteSet& csIdSet)
         if (step++ > Options::MaxStepInWrapper())
             return false;
 
-        for (SVFGNode::const_iterator it = node->OutEdgeBegin(), eit =
-                    node->OutEdgeEnd(); it != eit; ++it)
+        for (const SVFGEdge* edge : node->getOutEdgeRange())
         {
-            const SVFGEdge* edge = (*it);
             //assert(edge->isDirectVFGEdge() && "the edge should always be direct VF");
             // if this is a call edge
             if(edge->isCallDirectVFGEdge())
@@ -186,12 +198,63 @@ bool SrcSnkDDA::isInAWrapper(const SVFGNode* src, CallSiteSet& csIdSet)
 }
 
 
+/*!
+ * Compute the slice of a source
+ */
+void SrcSnkSlicer::computeSlice(ProgSlice* slice)
+{
+    _curSlice = slice;
+    clearVisitedMap();
+
+    const SVFGNode* src = slice->getSource();
+    DBOUT(DGENERAL, outs() << "Analysing slice:" << src->getId() << ")\n");
+    ContextCond cxt;
+    DPIm item(src->getId(),cxt);
+    forwardTraverse(item);
+
+    if (slice->isReachGlobal())
+    {
+        DBOUT(DSaber, outs() << "Forward analysis reaches globals for slice:" << src->getId() << ")\n");
+    }
+    else
+    {
+        DBOUT(DSaber, outs() << "Forward process for slice:" << src->getId() << " (size = " << slice->getForwardSliceSize() << ")\n");
+
+        for (SrcSnkDDA::SVFGNodeSetIter sit = slice->sinksBegin(), esit =
+                    slice->sinksEnd(); sit != esit; ++sit)
+        {
+            ContextCond cxt;
+            DPIm item((*sit)->getId(),cxt);
+            backwardTraverse(item);
+        }
+
+        DBOUT(DSaber, outs() << "Backward process for slice:" << src->getId() << " (size = " << slice->getBackwardSliceSize() << ")\n");
+    }
+    _curSlice = nullptr;
+}
+
+/*!
+ * Add a node to the forward slice, or to the sinks if it is one
+ */
+void SrcSnkSlicer::FWProcessCurNode(const DPIm& item)
+{
+    const SVFGNode* node = getNode(item.getCurNodeID());
+    if(checker->isSink(node))
+    {
+        _curSlice->addToSinks(node);
+        _curSlice->addToForwardSlice(node);
+        _curSlice->setPartialReachable();
+    }
+    else
+        _curSlice->addToForwardSlice(node);
+}
+
 /*!
  * Propagate information forward by matching context
  */
-void SrcSnkDDA::FWProcessOutgoingEdge(const DPIm& item, SVFGEdge* edge)
+void SrcSnkSlicer::FWProcessOutgoingEdge(const DPIm& item, SVFGEdge* edge)
 {
-    DBOUT(DSaber,outs() << "\n##processing source: " << getCurSlice()->getSource()->getId() <<" forward propagate from (" << edge->getSrcID());
+    DBOUT(DSaber,outs() << "\n##processing source: " << _curSlice->getSource()->getId() <<" forward propagate from (" << edge->getSrcID());
 
     // for indirect SVFGEdge, the propagation should follow the def-use chains
     // points-to on the edge indicate whether the object of source node can be propagated
@@ -200,9 +263,9 @@ void SrcSnkDDA::FWProcessOutgoingEdge(const DPIm& item, SVFGEdge* edge)
     DPIm newItem(dstNode->getId(),item.getContexts());
 
     /// handle globals here
-    if(isGlobalSVFGNode(dstNode) || getCurSlice()->isReachGlobal())
+    if(checker->isGlobalSVFGNode(dstNode) || _curSlice->isReachGlobal())
     {
-        getCurSlice()->setReachGlobal();
+        _curSlice->setReachGlobal();
         return;
     }
 
@@ -254,7 +317,7 @@ void SrcSnkDDA::FWProcessOutgoingEdge(const DPIm& item, SVFGEdge* edge)
 /*!
  * Propagate information backward without matching context, as forward analysis already did it
  */
-void SrcSnkDDA::BWProcessIncomingEdge(const DPIm&, SVFGEdge* edge)
+void SrcSnkSlicer::BWProcessIncomingEdge(const DPIm&, SVFGEdge* edge)
 {
     DBOUT(DSaber,outs() << "backward propagate from (" << edge->getDstID() << " --> " << edge->getSrcID() << ")\n");
     const SVFGNode* srcNode = edge->getSrcNode();
@@ -269,16 +332,10 @@ void SrcSnkDDA::BWProcessIncomingEdge(const DPIm&, SVFGEdge* edge)
 }
 
 /// Set current slice
-void SrcSnkDDA::setCurSlice(const SVFGNode* src)
+void SrcSnkDDA::setCurSlice(ProgSlice* slice)
 {
-    if(_curSlice!=nullptr)
-    {
-        delete _curSlice;
-        _curSlice = nullptr;
-        clearVisitedMap();
-    }
-
-    _curSlice = new ProgSlice(src,getSaberCondAllocator(), getSVFG());
+    delete _curSlice;
+    _curSlice = slice;
 }
 
 void SrcSnkDDA::annotateSlice(ProgSlice* slice)
@@ -302,6 +359,16 @@ void SrcSnkDDA::dumpSlices()
 void SrcSnkDDA::printZ3Stat()
 {
 
+    if (getSaberCondAllocator()->isBDDBackend())
+    {
+        const BDDManager& mgr = BDDManager::getManager();
+        outs() << "BDD Mem usage: " << getSaberCondAllocator()->getMemUsage() << "\n";
+        outs() << "BDD Number: " << getSaberCondAllocator()->getCondNum() << "\n";
+        outs() << "BDD Nodes: " << mgr.getNodeNum() << " (peak " << mgr.getPeakNodeNum() << ")\n";
+        outs() << "BDD GC Number: " << mgr.getGCNum() << "\n";
+        outs() << "BDD Cache Hits: " << mgr.getCacheHits() << "/" << mgr.getCacheLookups() << "\n";
+        return;
+    }
     outs() << "Z3 Mem usage: " << getSaberCondAllocator()->getMemUsage() << "\n";
     outs() << "Z3 Number: " << getSaberCondAllocator()->getCondNum() << "\n";
 }
@@ -0,0 +1,1465 @@
+//===- SVFFileSystem.cpp -- Binary snapshot of SVFIR -------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * SVFFileSystem.cpp
+ *
+ * Writer and (mmap based) reader of SVFIR snapshots.
+ */
+
+#include "SVFIR/SVFFileSystem.h"
+#include "Util/ExtAPI.h"
+#include "Util/NodeIDAllocator.h"
+#include "Util/SVFUtil.h"
+
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SVF;
+using namespace SVFUtil;
+
+/// Magic number and format version of a snapshot.
+/// Bump SnapshotVersion whenever the layout of any object changes.
+static const char SnapshotMagic[8] = {'S', 'V', 'F', 'I', 'R', 'B', 'I', 'N'};
+static const u32_t SnapshotVersion = 1;
+
+/*!
+ * Write the SVFIR into the snapshot file at path
+ */
+void SVFIRWriter::writeToPath(const SVFIR* svfir, const std::string& path)
+{
+    SVFIRWriter writer(svfir);
+    writer.collectPtrs();
+
+    writer.buf.append(SnapshotMagic, sizeof(SnapshotMagic));
+    writer.write(SnapshotVersion);
+    writer.writeDecls();
+    writer.writeContents();
+
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    if (!os.is_open())
+    {
+        SVFUtil::errs() << "Can't open file `" << path << "` to write the SVFIR\n";
+        abort();
+    }
+    os.write(writer.buf.data(), writer.buf.size());
+    os.close();
+}
+
+SVFIRWriter::SVFIRWriter(const SVFIR* svfir) : svfIR(svfir), chg(nullptr)
+{
+    if (svfir->chgraph)
+        chg = SVFUtil::dyn_cast<CHGraph>(svfir->chgraph);
+}
+
+/*!
+ * Number all the objects owned by the SVFIR, its SVFModule, ICFG, CallGraph and CHGraph.
+ * Values which are not owned by the SVFModule (e.g., instructions) are not part of a snapshot.
+ */
+void SVFIRWriter::collectPtrs()
+{
+    for (const SVFType* type : svfIR->svfTypes)
+        typePool.add(type);
+    for (const StInfo* stInfo : svfIR->stInfos)
+        stInfoPool.add(stInfo);
+
+    const SVFModule* svfModule = svfIR->svfModule;
+    for (const SVFFunction* fun : svfModule->getFunctionSet())
+    {
+        valuePool.add(fun);
+        for (const SVFArgument* arg : fun->allArgs)
+            valuePool.add(arg);
+        for (const auto& it : *fun->bbGraph)
+            bbPool.add(it.second);
+    }
+    for (const SVFConstant* constant : svfModule->getConstantSet())
+        valuePool.add(constant);
+    for (const SVFOtherValue* otherValue : svfModule->getOtherValueSet())
+        valuePool.add(otherValue);
+
+    for (const auto& it : *svfIR->icfg)
+    {
+        icfgNodePool.add(it.second);
+        for (const ICFGEdge* edge : it.second->getOutEdges())
+            icfgEdgePool.add(edge);
+    }
+    for (const auto& it : svfIR->icfg->icfgNodeToSVFLoopVec)
+    {
+        for (const SVFLoop* loop : it.second)
+            loopPool.add(loop);
+    }
+
+    for (const auto& it : *svfIR->callGraph)
+        callGraphNodePool.add(it.second);
+
+    for (const auto& it : svfIR->objTypeInfoMap)
+        objTypeInfoPool.add(it.second);
+    for (const auto& it : *svfIR)
+    {
+        varPool.add(it.second);
+        if (const BaseObjVar* baseObj = SVFUtil::dyn_cast<BaseObjVar>(it.second))
+        {
+            if (baseObj->typeInfo)
+                objTypeInfoPool.add(baseObj->typeInfo);
+        }
+        for (const SVFStmt* stmt : it.second->getOutEdges())
+            stmtPool.add(stmt);
+    }
+
+    if (chg)
+    {
+        for (const auto& it : *chg)
+            chNodePool.add(it.second);
+    }
+}
+
+/*!
+ * Write what the reader needs to allocate each object
+ */
+void SVFIRWriter::writeDecls()
+{
+    write(typePool.size());
+    for (const SVFType* type : typePool.getPtrs())
+        write(type->getKind());
+
+    write(stInfoPool.size());
+    for (const StInfo* stInfo : stInfoPool.getPtrs())
+        write(stInfo->getStride());
+
+    write(valuePool.size());
+    for (const SVFValue* value : valuePool.getPtrs())
+        write(value->getKind());
+
+    write(bbPool.size());
+    for (const SVFBasicBlock* bb : bbPool.getPtrs())
+    {
+        write(bb->getId());
+        write(static_cast<const SVFValue*>(bb->getParent()));
+    }
+
+    write(icfgNodePool.size());
+    for (const ICFGNode* node : icfgNodePool.getPtrs())
+    {
+        write(node->getId());
+        write(node->getNodeKind());
+    }
+
+    write(callGraphNodePool.size());
+    for (const CallGraphNode* node : callGraphNodePool.getPtrs())
+    {
+        write(node->getId());
+        write(static_cast<const SVFValue*>(node->getFunction()));
+    }
+
+    write(objTypeInfoPool.size());
+    for (const ObjTypeInfo* objTypeInfo : objTypeInfoPool.getPtrs())
+        write(objTypeInfo->getType());
+
+    write(varPool.size());
+    for (const SVFVar* var : varPool.getPtrs())
+    {
+        write(var->getId());
+        write(var->getNodeKind());
+    }
+
+    write(stmtPool.size());
+    for (const SVFStmt* stmt : stmtPool.getPtrs())
+        write(stmt->getEdgeKind());
+
+    write(chg != nullptr);
+    write(chNodePool.size());
+    for (const CHNode* node : chNodePool.getPtrs())
+    {
+        write(node->getId());
+        write(node->getName());
+    }
+}
+
+/*!
+ * Write the fields of each object. The order must match SVFIRReader::readContents.
+ */
+void SVFIRWriter::writeContents()
+{
+    for (const SVFType* type : typePool.getPtrs())
+        writeType(type);
+    write(SVFType::svfPtrTy);
+    write(SVFType::svfI8Ty);
+    for (const StInfo* stInfo : stInfoPool.getPtrs())
+        writeStInfo(stInfo);
+    for (const SVFValue* value : valuePool.getPtrs())
+        writeValue(value);
+    for (const SVFBasicBlock* bb : bbPool.getPtrs())
+        writeBasicBlock(bb);
+
+    /// ICFG
+    const ICFG* icfg = svfIR->icfg;
+    for (const ICFGNode* node : icfgNodePool.getPtrs())
+        writeICFGNode(node);
+    write(icfgEdgePool.size());
+    for (const ICFGEdge* edge : icfgEdgePool.getPtrs())
+        writeICFGEdge(edge);
+    write(loopPool.size());
+    for (const SVFLoop* loop : loopPool.getPtrs())
+        writeLoop(loop);
+    write(icfg->totalICFGNode);
+    write(icfg->FunToFunEntryNodeMap);
+    write(icfg->FunToFunExitNodeMap);
+    write(icfg->globalBlockNode);
+    write(icfg->icfgNodeToSVFLoopVec);
+    write(icfg->_subNodes);
+    write(icfg->_repNode);
+    write(icfg->edgeNum);
+    write(icfg->nodeNum);
+
+    /// CallGraph
+    const CallGraph* callGraph = svfIR->callGraph;
+    u32_t numOfCallGraphEdges = 0;
+    for (const auto& it : *callGraph)
+        numOfCallGraphEdges += it.second->getOutEdges().size();
+    write(numOfCallGraphEdges);
+    for (const auto& it : *callGraph)
+    {
+        for (const CallGraphEdge* edge : it.second->getOutEdges())
+            writeCallGraphEdge(edge);
+    }
+    write(callGraph->callGraphNodeNum);
+    write(callGraph->edgeNum);
+    write(callGraph->nodeNum);
+
+    /// SVFIR
+    for (const ObjTypeInfo* objTypeInfo : objTypeInfoPool.getPtrs())
+        writeObjTypeInfo(objTypeInfo);
+    for (const SVFVar* var : varPool.getPtrs())
+        writeVar(var);
+    for (const SVFStmt* stmt : stmtPool.getPtrs())
+        writeStmt(stmt);
+
+    /// Only values owned by the SVFModule are kept in the symbol tables
+    auto writeSymMap = [this](const IRGraph::ValueToIDMapTy& symMap)
+    {
+        u32_t size = 0;
+        for (const auto& it : symMap)
+            size += valuePool.has(it.first);
+        write(size);
+        for (const auto& it : symMap)
+        {
+            if (valuePool.has(it.first))
+                write(it);
+        }
+    };
+    writeSymMap(svfIR->valSymMap);
+    writeSymMap(svfIR->objSymMap);
+    write(svfIR->returnSymMap);
+    write(svfIR->varargSymMap);
+    write(svfIR->objTypeInfoMap);
+    write(svfIR->totalSymNum);
+    write(svfIR->KindToSVFStmtSetMap);
+    write(svfIR->KindToPTASVFStmtSetMap);
+    write(svfIR->fromFile);
+    write(svfIR->nodeNumAfterPAGBuild);
+    write(svfIR->totalPTAPAGEdge);
+    write(svfIR->maxStruct);
+    write(svfIR->maxStSize);
+    write(svfIR->edgeNum);
+    write(svfIR->nodeNum);
+
+    write(svfIR->icfgNode2SVFStmtsMap);
+    write(svfIR->icfgNode2PTASVFStmtsMap);
+    write(svfIR->GepValObjMap);
+    write(svfIR->typeLocSetsMap);
+    write(svfIR->GepObjVarMap);
+    write(svfIR->memToFieldsMap);
+    write(svfIR->globSVFStmtSet);
+    write(svfIR->phiNodeMap);
+    write(svfIR->funArgsListMap);
+    write(svfIR->callSiteArgsListMap);
+    write(svfIR->callSiteRetMap);
+    write(svfIR->funRetMap);
+    write(svfIR->indCallSiteToFunPtrMap);
+    write(svfIR->funPtrToCallSitesMap);
+    write(svfIR->candidatePointers);
+    write(svfIR->callSiteSet);
+
+    write(SVFStmt::inst2LabelMap);
+    write(SVFStmt::var2LabelMap);
+    write(SVFStmt::callEdgeLabelCounter);
+    write(SVFStmt::storeEdgeLabelCounter);
+    write(SVFStmt::multiOpndLabelCounter);
+
+    const NodeIDAllocator* allocator = NodeIDAllocator::get();
+    write(allocator->numObjects);
+    write(allocator->numValues);
+    write(allocator->numSymbols);
+    write(allocator->numNodes);
+
+    /// SVFModule
+    const SVFModule* svfModule = svfIR->svfModule;
+    write(svfModule->moduleIdentifier);
+    write(svfModule->FunctionSet);
+    write(svfModule->GlobalSet);
+    write(svfModule->AliasSet);
+    write(svfModule->ConstantSet);
+    write(svfModule->OtherValueSet);
+
+    /// CHGraph
+    if (chg)
+    {
+        for (const CHNode* node : chNodePool.getPtrs())
+            writeCHNode(node);
+        write(chg->classNum);
+        write(chg->vfID);
+        write(chg->buildingCHGTime);
+        write(chg->classNameToNodeMap);
+        write(chg->classNameToDescendantsMap);
+        write(chg->classNameToAncestorsMap);
+        write(chg->classNameToInstAndDescsMap);
+        write(chg->templateNameToInstancesMap);
+        write(chg->callNodeToClassesMap);
+        write(chg->virtualFunctionToIDMap);
+        write(chg->callNodeToCHAVtblsMap);
+        write(chg->callNodeToCHAVFnsMap);
+        write(chg->edgeNum);
+        write(chg->nodeNum);
+    }
+}
+
+void SVFIRWriter::write(const AccessPath& ap)
+{
+    write(ap.fldIdx);
+    write(ap.idxOperandPairs);
+    write(ap.gepPointeeType);
+}
+
+void SVFIRWriter::write(const NodeBS& bs)
+{
+    write(bs.count());
+    for (NodeID id : bs)
+        write(id);
+}
+
+void SVFIRWriter::writeBaseNode(const SVFBaseNode* node)
+{
+    write(node->type);
+    write(node->name);
+    write(node->sourceLoc);
+}
+
+void SVFIRWriter::writeType(const SVFType* type)
+{
+    write(type->typeinfo);
+    write(type->isSingleValTy);
+    write(type->byteSize);
+
+    if (const SVFIntegerType* intType = SVFUtil::dyn_cast<SVFIntegerType>(type))
+        write(intType->signAndWidth);
+    else if (const SVFFunctionType* funType = SVFUtil::dyn_cast<SVFFunctionType>(type))
+        write(funType->retTy);
+    else if (const SVFStructType* structType = SVFUtil::dyn_cast<SVFStructType>(type))
+        write(structType->name);
+    else if (const SVFArrayType* arrayType = SVFUtil::dyn_cast<SVFArrayType>(type))
+    {
+        write(arrayType->numOfElement);
+        write(arrayType->typeOfElement);
+    }
+    else if (const SVFOtherType* otherType = SVFUtil::dyn_cast<SVFOtherType>(type))
+        write(otherType->repr);
+}
+
+void SVFIRWriter::writeStInfo(const StInfo* stInfo)
+{
+    write(stInfo->fldIdxVec);
+    write(stInfo->elemIdxVec);
+    write(stInfo->fldIdx2TypeMap);
+    write(stInfo->finfo);
+    write(stInfo->numOfFlattenElements);
+    write(stInfo->numOfFlattenFields);
+    write(stInfo->flattenElementTypes);
+}
+
+void SVFIRWriter::writeValue(const SVFValue* value)
+{
+    write(value->type);
+    write(value->name);
+    write(value->sourceLoc);
+    write(value->ptrInUncalledFun);
+    write(value->constDataOrAggData);
+
+    if (const SVFFunction* fun = SVFUtil::dyn_cast<SVFFunction>(value))
+    {
+        write(fun->isDecl);
+        write(fun->intrinsic);
+        write(fun->addrTaken);
+        write(fun->isUncalled);
+        write(fun->isNotRet);
+        write(fun->varArg);
+        write(fun->funcType);
+        write(fun->realDefFun);
+        write(fun->allArgs);
+        write(fun->exitBlock);
+        write(fun->callGraphNode);
+        write(fun->bbGraph->id);
+
+        const SVFLoopAndDomInfo* ld = fun->loopAndDom;
+        write(ld->reachableBBs);
+        write(ld->dtBBsMap);
+        write(ld->pdtBBsMap);
+        write(ld->dfBBsMap);
+        write(ld->bb2LoopMap);
+        write(ld->bb2PdomLevel);
+        write(ld->bb2PIdom);
+
+        const ExtAPI* extAPI = ExtAPI::getExtAPI();
+        auto it = extAPI->func2Annotations.find(fun);
+        write(it != extAPI->func2Annotations.end() ? it->second : std::vector<std::string>());
+    }
+    else if (const SVFArgument* arg = SVFUtil::dyn_cast<SVFArgument>(value))
+    {
+        write(arg->fun);
+        write(arg->argNo);
+        write(arg->uncalled);
+    }
+    else if (const SVFGlobalValue* glob = SVFUtil::dyn_cast<SVFGlobalValue>(value))
+    {
+        // the definition may live in a value which is not part of the snapshot
+        write(valuePool.has(glob->realDefGlobal) ? glob->realDefGlobal : nullptr);
+    }
+    else if (const SVFConstantInt* constInt = SVFUtil::dyn_cast<SVFConstantInt>(value))
+    {
+        write(constInt->zval);
+        write(constInt->sval);
+    }
+    else if (const SVFConstantFP* constFP = SVFUtil::dyn_cast<SVFConstantFP>(value))
+        write(constFP->dval);
+}
+
+void SVFIRWriter::writeBasicBlock(const SVFBasicBlock* bb)
+{
+    writeBaseNode(bb);
+    write(bb->succBBs);
+    write(bb->predBBs);
+    write(bb->allICFGNodes);
+}
+
+void SVFIRWriter::writeICFGNode(const ICFGNode* node)
+{
+    writeBaseNode(node);
+    write(node->fun);
+    write(node->bb);
+    write(node->pagEdges);
+
+    if (const IntraICFGNode* intra = SVFUtil::dyn_cast<IntraICFGNode>(node))
+        write(intra->isRet);
+    else if (const FunEntryICFGNode* entry = SVFUtil::dyn_cast<FunEntryICFGNode>(node))
+        write(entry->FPNodes);
+    else if (const FunExitICFGNode* exit = SVFUtil::dyn_cast<FunExitICFGNode>(node))
+        write(exit->formalRet);
+    else if (const CallICFGNode* call = SVFUtil::dyn_cast<CallICFGNode>(node))
+    {
+        write(call->ret);
+        write(call->APNodes);
+        write(call->calledFunc);
+        write(call->isvararg);
+        write(call->isVirCallInst);
+        write(call->vtabPtr);
+        write(call->virtualFunIdx);
+        write(call->funNameOfVcall);
+    }
+    else if (const RetICFGNode* ret = SVFUtil::dyn_cast<RetICFGNode>(node))
+    {
+        write(ret->actualRet);
+        write(ret->callBlockNode);
+    }
+}
+
+void SVFIRWriter::writeICFGEdge(const ICFGEdge* edge)
+{
+    write(edge->edgeFlag);
+    write(edge->src);
+    write(edge->dst);
+
+    if (const IntraCFGEdge* intraEdge = SVFUtil::dyn_cast<IntraCFGEdge>(edge))
+    {
+        write(intraEdge->conditionVar);
+        write(intraEdge->branchCondVal);
+    }
+    else if (const CallCFGEdge* callEdge = SVFUtil::dyn_cast<CallCFGEdge>(edge))
+        write(callEdge->callPEs);
+    else if (const RetCFGEdge* retEdge = SVFUtil::dyn_cast<RetCFGEdge>(edge))
+        write(retEdge->retPE);
+}
+
+void SVFIRWriter::writeLoop(const SVFLoop* loop)
+{
+    write(loop->icfgNodes);
+    write(loop->loopBound);
+    write(loop->entryICFGEdges);
+    write(loop->backICFGEdges);
+    write(loop->inICFGEdges);
+    write(loop->outICFGEdges);
+}
+
+void SVFIRWriter::writeCallGraphEdge(const CallGraphEdge* edge)
+{
+    write(edge->edgeFlag);
+    write(edge->src);
+    write(edge->dst);
+    write(edge->directCalls);
+}
+
+void SVFIRWriter::writeObjTypeInfo(const ObjTypeInfo* objTypeInfo)
+{
+    write(objTypeInfo->flags);
+    write(objTypeInfo->maxOffsetLimit);
+    write(objTypeInfo->elemNum);
+    write(objTypeInfo->byteSize);
+}
+
+void SVFIRWriter::writeVar(const SVFVar* var)
+{
+    writeBaseNode(var);
+
+    if (const ValVar* valVar = SVFUtil::dyn_cast<ValVar>(var))
+        write(valVar->icfgNode);
+
+    if (const ArgValVar* argVar = SVFUtil::dyn_cast<ArgValVar>(var))
+    {
+        write(argVar->cgNode);
+        write(argVar->argNo);
+        write(argVar->uncalled);
+    }
+    else if (const FunValVar* funVar = SVFUtil::dyn_cast<FunValVar>(var))
+        write(funVar->callGraphNode);
+    else if (const GepValVar* gepVar = SVFUtil::dyn_cast<GepValVar>(var))
+    {
+        write(gepVar->ap);
+        write(gepVar->base);
+        write(gepVar->gepValType);
+    }
+    else if (const RetValPN* retVar = SVFUtil::dyn_cast<RetValPN>(var))
+        write(retVar->callGraphNode);
+    else if (const VarArgValPN* varargVar = SVFUtil::dyn_cast<VarArgValPN>(var))
+        write(varargVar->callGraphNode);
+    else if (const ConstFPValVar* fpVar = SVFUtil::dyn_cast<ConstFPValVar>(var))
+        write(fpVar->dval);
+    else if (const ConstIntValVar* intVar = SVFUtil::dyn_cast<ConstIntValVar>(var))
+    {
+        write(intVar->zval);
+        write(intVar->sval);
+    }
+    else if (const GepObjVar* gepObj = SVFUtil::dyn_cast<GepObjVar>(var))
+    {
+        write(gepObj->apOffset);
+        write(gepObj->base);
+    }
+
+    if (const BaseObjVar* baseObj = SVFUtil::dyn_cast<BaseObjVar>(var))
+    {
+        write(baseObj->typeInfo);
+        write(baseObj->icfgNode);
+    }
+
+    if (const FunObjVar* funObj = SVFUtil::dyn_cast<FunObjVar>(var))
+        write(funObj->callGraphNode);
+    else if (const ConstFPObjVar* fpObj = SVFUtil::dyn_cast<ConstFPObjVar>(var))
+        write(fpObj->dval);
+    else if (const ConstIntObjVar* intObj = SVFUtil::dyn_cast<ConstIntObjVar>(var))
+    {
+        write(intObj->zval);
+        write(intObj->sval);
+    }
+}
+
+void SVFIRWriter::writeStmt(const SVFStmt* stmt)
+{
+    write(stmt->edgeFlag);
+    write(stmt->src);
+    write(stmt->dst);
+    write(stmt->value);
+    write(stmt->basicBlock);
+    write(stmt->icfgNode);
+    write(stmt->edgeId);
+
+    if (const AddrStmt* addr = SVFUtil::dyn_cast<AddrStmt>(stmt))
+        write(addr->arrSize);
+    else if (const CopyStmt* copy = SVFUtil::dyn_cast<CopyStmt>(stmt))
+        write(copy->copyKind);
+    else if (const GepStmt* gep = SVFUtil::dyn_cast<GepStmt>(stmt))
+    {
+        write(gep->ap);
+        write(gep->variantField);
+    }
+    else if (const CallPE* callPE = SVFUtil::dyn_cast<CallPE>(stmt))
+    {
+        write(callPE->call);
+        write(callPE->entry);
+    }
+    else if (const RetPE* retPE = SVFUtil::dyn_cast<RetPE>(stmt))
+    {
+        write(retPE->call);
+        write(retPE->exit);
+    }
+    else if (const MultiOpndStmt* multi = SVFUtil::dyn_cast<MultiOpndStmt>(stmt))
+    {
+        write(multi->opVars);
+        if (const PhiStmt* phi = SVFUtil::dyn_cast<PhiStmt>(stmt))
+            write(phi->opICFGNodes);
+        else if (const SelectStmt* select = SVFUtil::dyn_cast<SelectStmt>(stmt))
+            write(select->condition);
+        else if (const CmpStmt* cmp = SVFUtil::dyn_cast<CmpStmt>(stmt))
+            write(cmp->predicate);
+        else if (const BinaryOPStmt* binary = SVFUtil::dyn_cast<BinaryOPStmt>(stmt))
+            write(binary->opcode);
+    }
+    else if (const UnaryOPStmt* unary = SVFUtil::dyn_cast<UnaryOPStmt>(stmt))
+        write(unary->opcode);
+    else if (const BranchStmt* branch = SVFUtil::dyn_cast<BranchStmt>(stmt))
+    {
+        write(branch->successors);
+        write(branch->cond);
+        write(branch->brInst);
+    }
+}
+
+void SVFIRWriter::writeCHNode(const CHNode* node)
+{
+    write(node->vtable);
+    write(node->flags);
+    write(node->virtualFunctionVectors);
+    u32_t numOfEdges = node->getOutEdges().size();
+    write(numOfEdges);
+    for (const CHEdge* edge : node->getOutEdges())
+    {
+        write(edge->dst);
+        write(edge->edgeType);
+        write(edge->edgeFlag);
+    }
+}
+
+/*!
+ * Read the snapshot file at path into the (singleton) SVFIR and return it
+ */
+SVFIR* SVFIRReader::readFromPath(const std::string& path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0)
+    {
+        SVFUtil::errs() << "Can't open SVFIR snapshot `" << path << "`\n";
+        abort();
+    }
+    size_t size = st.st_size;
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+    {
+        SVFUtil::errs() << "Can't map SVFIR snapshot `" << path << "`\n";
+        abort();
+    }
+
+    const char* begin = static_cast<const char*>(addr);
+    if (size < sizeof(SnapshotMagic) + sizeof(u32_t) ||
+            std::memcmp(begin, SnapshotMagic, sizeof(SnapshotMagic)) != 0)
+    {
+        SVFUtil::errs() << "`" << path << "` is not a SVFIR snapshot\n";
+        abort();
+    }
+    SVFIRReader reader(begin + sizeof(SnapshotMagic), begin + size);
+    u32_t version = reader.read<u32_t>();
+    if (version != SnapshotVersion)
+    {
+        SVFUtil::errs() << "SVFIR snapshot `" << path << "` has version " << version
+                        << ", expected " << SnapshotVersion << "; please regenerate it\n";
+        abort();
+    }
+
+    reader.readDecls();
+    reader.readContents();
+    if (reader.cur != reader.end)
+        corrupt("trailing bytes");
+
+    munmap(addr, size);
+    return reader.svfIR;
+}
+
+void SVFIRReader::corrupt(const char* what)
+{
+    SVFUtil::errs() << "SVFIR snapshot is truncated or corrupt: " << what << "\n";
+    abort();
+}
+
+SVFIRReader::SVFIRReader(const char* begin, const char* end)
+    : cur(begin), end(end), svfIR(SVFIR::getPAG()), icfg(new ICFG()), callGraph(new CallGraph()), chg(nullptr)
+{
+    assert(svfIR->getTotalNodeNum() == 0 && "SVFIR has been built before reading the snapshot!");
+    svfIR->setModule(SVFModule::getSVFModule());
+    svfIR->setICFG(icfg);
+    svfIR->setCallGraph(callGraph);
+}
+
+void SVFIRReader::readDecls()
+{
+    types.resize(readSize());
+    for (SVFType*& type : types)
+        type = createType(read<SVFType::GNodeK>());
+
+    stInfos.resize(readSize());
+    for (StInfo*& stInfo : stInfos)
+        stInfo = new StInfo(read<u32_t>());
+
+    values.resize(readSize());
+    for (SVFValue*& value : values)
+        value = createValue(read<SVFValue::GNodeK>());
+
+    bbs.resize(readSize());
+    for (SVFBasicBlock*& bb : bbs)
+    {
+        NodeID id = read<NodeID>();
+        SVFFunction* fun;
+        read(fun);
+        bb = new SVFBasicBlock(id, fun);
+        fun->bbGraph->addGNode(id, bb);
+    }
+
+    icfgNodes.resize(readSize());
+    for (ICFGNode*& node : icfgNodes)
+    {
+        NodeID id = read<NodeID>();
+        node = createICFGNode(id, read<SVFBaseNode::GNodeK>());
+        icfg->addGNode(id, node);
+    }
+
+    callGraphNodes.resize(readSize());
+    for (CallGraphNode*& node : callGraphNodes)
+    {
+        NodeID id = read<NodeID>();
+        const SVFFunction* fun;
+        read(fun);
+        node = new CallGraphNode(id, fun);
+        callGraph->addGNode(id, node);
+        callGraph->funToCallGraphNodeMap[fun] = node;
+    }
+
+    objTypeInfos.resize(readSize());
+    for (ObjTypeInfo*& objTypeInfo : objTypeInfos)
+    {
+        const SVFType* type;
+        read(type);
+        objTypeInfo = new ObjTypeInfo(type, 0);
+    }
+
+    vars.resize(readSize());
+    for (SVFVar*& var : vars)
+    {
+        NodeID id = read<NodeID>();
+        var = createVar(id, read<SVFBaseNode::GNodeK>());
+        svfIR->addGNode(id, var);
+    }
+
+    stmts.resize(readSize());
+    for (SVFStmt*& stmt : stmts)
+        stmt = createStmt(read<SVFStmt::GEdgeKind>());
+
+    if (read<bool>())
+    {
+        chg = new CHGraph(SVFModule::getSVFModule());
+        svfIR->setCHG(chg);
+    }
+    chNodes.resize(readSize());
+    for (CHNode*& node : chNodes)
+    {
+        NodeID id = read<NodeID>();
+        std::string name;
+        read(name);
+        node = new CHNode(name, id);
+        chg->addGNode(id, node);
+    }
+}
+
+void SVFIRReader::readContents()
+{
+    for (SVFType* type : types)
+    {
+        readType(type);
+        svfIR->svfTypes.insert(type);
+    }
+    read(SVFType::svfPtrTy);
+    read(SVFType::svfI8Ty);
+    for (StInfo* stInfo : stInfos)
+    {
+        readStInfo(stInfo);
+        svfIR->stInfos.insert(stInfo);
+    }
+    for (SVFValue* value : values)
+        readValue(value);
+    for (SVFBasicBlock* bb : bbs)
+        readBasicBlock(bb);
+
+    /// ICFG
+    for (ICFGNode* node : icfgNodes)
+        readICFGNode(node);
+    icfgEdges.resize(readSize());
+    for (ICFGEdge*& edge : icfgEdges)
+        edge = readICFGEdge();
+    loops.resize(readSize());
+    for (SVFLoop*& loop : loops)
+        loop = readLoop();
+    read(icfg->totalICFGNode);
+    read(icfg->FunToFunEntryNodeMap);
+    read(icfg->FunToFunExitNodeMap);
+    read(icfg->globalBlockNode);
+    read(icfg->icfgNodeToSVFLoopVec);
+    read(icfg->_subNodes);
+    read(icfg->_repNode);
+    read(icfg->edgeNum);
+    read(icfg->nodeNum);
+
+    /// CallGraph
+    for (u32_t i = 0, size = read<u32_t>(); i < size; ++i)
+        readCallGraphEdge();
+    read(callGraph->callGraphNodeNum);
+    read(callGraph->edgeNum);
+    read(callGraph->nodeNum);
+
+    /// SVFIR
+    for (ObjTypeInfo* objTypeInfo : objTypeInfos)
+        readObjTypeInfo(objTypeInfo);
+    for (SVFVar* var : vars)
+        readVar(var);
+    for (SVFStmt* stmt : stmts)
+        readStmt(stmt);
+
+    read(svfIR->valSymMap);
+    read(svfIR->objSymMap);
+    read(svfIR->returnSymMap);
+    read(svfIR->varargSymMap);
+    read(svfIR->objTypeInfoMap);
+    read(svfIR->totalSymNum);
+    read(svfIR->KindToSVFStmtSetMap);
+    read(svfIR->KindToPTASVFStmtSetMap);
+    read(svfIR->fromFile);
+    read(svfIR->nodeNumAfterPAGBuild);
+    read(svfIR->totalPTAPAGEdge);
+    read(svfIR->maxStruct);
+    read(svfIR->maxStSize);
+    read(svfIR->edgeNum);
+    read(svfIR->nodeNum);
+
+    read(svfIR->icfgNode2SVFStmtsMap);
+    read(svfIR->icfgNode2PTASVFStmtsMap);
+    read(svfIR->GepValObjMap);
+    read(svfIR->typeLocSetsMap);
+    read(svfIR->GepObjVarMap);
+    read(svfIR->memToFieldsMap);
+    read(svfIR->globSVFStmtSet);
+    read(svfIR->phiNodeMap);
+    read(svfIR->funArgsListMap);
+    read(svfIR->callSiteArgsListMap);
+    read(svfIR->callSiteRetMap);
+    read(svfIR->funRetMap);
+    read(svfIR->indCallSiteToFunPtrMap);
+    read(svfIR->funPtrToCallSitesMap);
+    read(svfIR->candidatePointers);
+    read(svfIR->callSiteSet);
+
+    read(SVFStmt::inst2LabelMap);
+    read(SVFStmt::var2LabelMap);
+    read(SVFStmt::callEdgeLabelCounter);
+    read(SVFStmt::storeEdgeLabelCounter);
+    read(SVFStmt::multiOpndLabelCounter);
+
+    NodeIDAllocator* allocator = NodeIDAllocator::get();
+    read(allocator->numObjects);
+    read(allocator->numValues);
+    read(allocator->numSymbols);
+    read(allocator->numNodes);
+
+    /// SVFModule
+    SVFModule* svfModule = svfIR->svfModule;
+    read(svfModule->moduleIdentifier);
+    read(svfModule->FunctionSet);
+    read(svfModule->GlobalSet);
+    read(svfModule->AliasSet);
+    read(svfModule->ConstantSet);
+    read(svfModule->OtherValueSet);
+
+    /// CHGraph
+    if (chg)
+    {
+        for (CHNode* node : chNodes)
+            readCHNode(node);
+        read(chg->classNum);
+        read(chg->vfID);
+        read(chg->buildingCHGTime);
+        read(chg->classNameToNodeMap);
+        read(chg->classNameToDescendantsMap);
+        read(chg->classNameToAncestorsMap);
+        read(chg->classNameToInstAndDescsMap);
+        read(chg->templateNameToInstancesMap);
+        read(chg->callNodeToClassesMap);
+        read(chg->virtualFunctionToIDMap);
+        read(chg->callNodeToCHAVtblsMap);
+        read(chg->callNodeToCHAVFnsMap);
+        read(chg->edgeNum);
+        read(chg->nodeNum);
+    }
+}
+
+SVFType* SVFIRReader::createType(SVFType::GNodeK kind)
+{
+    switch (kind)
+    {
+    case SVFType::SVFPointerTy:
+        return new SVFPointerType();
+    case SVFType::SVFIntegerTy:
+        return new SVFIntegerType();
+    case SVFType::SVFFunctionTy:
+        return new SVFFunctionType(nullptr);
+    case SVFType::SVFStructTy:
+        return new SVFStructType();
+    case SVFType::SVFArrayTy:
+        return new SVFArrayType();
+    case SVFType::SVFOtherTy:
+        return new SVFOtherType(false);
+    default:
+        corrupt("unknown SVFType kind");
+    }
+}
+
+SVFValue* SVFIRReader::createValue(SVFValue::GNodeK kind)
+{
+    switch (kind)
+    {
+    case SVFValue::SVFFunc:
+    {
+        SVFFunction* fun = new SVFFunction(nullptr, nullptr, false, false, false, false, new SVFLoopAndDomInfo);
+        fun->setBasicBlockGraph(new BasicBlockGraph(fun));
+        return fun;
+    }
+    case SVFValue::SVFGlob:
+        return new SVFGlobalValue(nullptr);
+    case SVFValue::SVFArg:
+        return new SVFArgument(nullptr, nullptr, 0, false);
+    case SVFValue::SVFConst:
+        return new SVFConstant(nullptr);
+    case SVFValue::SVFConstData:
+        return new SVFConstantData(nullptr);
+    case SVFValue::SVFConstInt:
+        return new SVFConstantInt(nullptr, 0, 0);
+    case SVFValue::SVFConstFP:
+        return new SVFConstantFP(nullptr, 0);
+    case SVFValue::SVFNullPtr:
+        return new SVFConstantNullPtr(nullptr);
+    case SVFValue::SVFBlackHole:
+        return new SVFBlackHoleValue(nullptr);
+    case SVFValue::SVFMetaAsValue:
+        return new SVFMetadataAsValue(nullptr);
+    case SVFValue::SVFOther:
+        return new SVFOtherValue(nullptr);
+    default:
+        corrupt("unknown SVFValue kind");
+    }
+}
+
+ICFGNode* SVFIRReader::createICFGNode(NodeID id, SVFBaseNode::GNodeK kind)
+{
+    switch (kind)
+    {
+    case SVFBaseNode::IntraBlock:
+        return new IntraICFGNode(id);
+    case SVFBaseNode::GlobalBlock:
+        return new GlobalICFGNode(id);
+    case SVFBaseNode::FunEntryBlock:
+        return new FunEntryICFGNode(id);
+    case SVFBaseNode::FunExitBlock:
+        return new FunExitICFGNode(id);
+    case SVFBaseNode::FunCallBlock:
+        return new CallICFGNode(id);
+    case SVFBaseNode::FunRetBlock:
+        return new RetICFGNode(id);
+    default:
+        corrupt("unknown ICFGNode kind");
+    }
+}
+
+SVFVar* SVFIRReader::createVar(NodeID id, SVFBaseNode::GNodeK kind)
+{
+    switch (kind)
+    {
+    case SVFBaseNode::ValNode:
+        return new ValVar(id);
+    case SVFBaseNode::ArgValNode:
+        return new ArgValVar(id);
+    case SVFBaseNode::FunValNode:
+        return new FunValVar(id, nullptr, nullptr, nullptr);
+    case SVFBaseNode::GepValNode:
+        return new GepValVar(id);
+    case SVFBaseNode::RetValNode:
+        return new RetValPN(id);
+    case SVFBaseNode::VarargValNode:
+        return new VarArgValPN(id);
+    case SVFBaseNode::GlobalValNode:
+        return new GlobalValVar(id, nullptr, nullptr);
+    case SVFBaseNode::ConstAggValNode:
+        return new ConstAggValVar(id, nullptr, nullptr);
+    case SVFBaseNode::ConstDataValNode:
+        return new ConstDataValVar(id, nullptr, nullptr);
+    case SVFBaseNode::BlackHoleValNode:
+        return new BlackHoleValVar(id, nullptr);
+    case SVFBaseNode::ConstFPValNode:
+        return new ConstFPValVar(id, 0, nullptr, nullptr);
+    case SVFBaseNode::ConstIntValNode:
+        return new ConstIntValVar(id, 0, 0, nullptr, nullptr);
+    case SVFBaseNode::ConstNullptrValNode:
+        return new ConstNullPtrValVar(id, nullptr, nullptr);
+    case SVFBaseNode::DummyValNode:
+        return new DummyValVar(id, nullptr, nullptr);
+    case SVFBaseNode::ObjNode:
+        return new ObjVar(id);
+    case SVFBaseNode::GepObjNode:
+        return new GepObjVar(id);
+    case SVFBaseNode::BaseObjNode:
+        return new BaseObjVar(id, nullptr);
+    case SVFBaseNode::FunObjNode:
+        return new FunObjVar(id, nullptr);
+    case SVFBaseNode::HeapObjNode:
+        return new HeapObjVar(id, nullptr);
+    case SVFBaseNode::StackObjNode:
+        return new StackObjVar(id, nullptr);
+    case SVFBaseNode::GlobalObjNode:
+        return new GlobalObjVar(id, nullptr);
+    case SVFBaseNode::ConstAggObjNode:
+        return new ConstAggObjVar(id, nullptr, nullptr, nullptr);
+    case SVFBaseNode::ConstDataObjNode:
+        return new ConstDataObjVar(id, nullptr);
+    case SVFBaseNode::ConstFPObjNode:
+        return new ConstFPObjVar(id, nullptr);
+    case SVFBaseNode::ConstIntObjNode:
+        return new ConstIntObjVar(id, nullptr);
+    case SVFBaseNode::ConstNullptrObjNode:
+        return new ConstNullPtrObjVar(id, nullptr);
+    case SVFBaseNode::DummyObjNode:
+        return new DummyObjVar(id, nullptr);
+    default:
+        corrupt("unknown SVFVar kind");
+    }
+}
+
+SVFStmt* SVFIRReader::createStmt(SVFStmt::GEdgeKind kind)
+{
+    switch (kind)
+    {
+    case SVFStmt::Addr:
+        return new AddrStmt();
+    case SVFStmt::Copy:
+        return new CopyStmt();
+    case SVFStmt::Store:
+        return new StoreStmt();
+    case SVFStmt::Load:
+        return new LoadStmt();
+    case SVFStmt::Call:
+        return new CallPE();
+    case SVFStmt::Ret:
+        return new RetPE();
+    case SVFStmt::Gep:
+        return new GepStmt();
+    case SVFStmt::Phi:
+        return new PhiStmt();
+    case SVFStmt::Select:
+        return new SelectStmt();
+    case SVFStmt::Cmp:
+        return new CmpStmt();
+    case SVFStmt::BinaryOp:
+        return new BinaryOPStmt();
+    case SVFStmt::UnaryOp:
+        return new UnaryOPStmt();
+    case SVFStmt::Branch:
+        return new BranchStmt();
+    case SVFStmt::ThreadFork:
+        return new TDForkPE();
+    case SVFStmt::ThreadJoin:
+        return new TDJoinPE();
+    default:
+        corrupt("unknown SVFStmt kind");
+    }
+}
+
+void SVFIRReader::read(AccessPath& ap)
+{
+    read(ap.fldIdx);
+    read(ap.idxOperandPairs);
+    read(ap.gepPointeeType);
+}
+
+void SVFIRReader::read(NodeBS& bs)
+{
+    for (u32_t i = 0, size = read<u32_t>(); i < size; ++i)
+        bs.set(read<NodeID>());
+}
+
+void SVFIRReader::readBaseNode(SVFBaseNode* node)
+{
+    read(node->type);
+    read(node->name);
+    read(node->sourceLoc);
+}
+
+void SVFIRReader::readType(SVFType* type)
+{
+    read(type->typeinfo);
+    read(type->isSingleValTy);
+    read(type->byteSize);
+
+    if (SVFIntegerType* intType = SVFUtil::dyn_cast<SVFIntegerType>(type))
+        read(intType->signAndWidth);
+    else if (SVFFunctionType* funType = SVFUtil::dyn_cast<SVFFunctionType>(type))
+        read(funType->retTy);
+    else if (SVFStructType* structType = SVFUtil::dyn_cast<SVFStructType>(type))
+        read(structType->name);
+    else if (SVFArrayType* arrayType = SVFUtil::dyn_cast<SVFArrayType>(type))
+    {
+        read(arrayType->numOfElement);
+        read(arrayType->typeOfElement);
+    }
+    else if (SVFOtherType* otherType = SVFUtil::dyn_cast<SVFOtherType>(type))
+        read(otherType->repr);
+}
+
+void SVFIRReader::readStInfo(StInfo* stInfo)
+{
+    read(stInfo->fldIdxVec);
+    read(stInfo->elemIdxVec);
+    read(stInfo->fldIdx2TypeMap);
+    read(stInfo->finfo);
+    read(stInfo->numOfFlattenElements);
+    read(stInfo->numOfFlattenFields);
+    read(stInfo->flattenElementTypes);
+}
+
+void SVFIRReader::readValue(SVFValue* value)
+{
+    read(value->type);
+    read(value->name);
+    read(value->sourceLoc);
+    read(value->ptrInUncalledFun);
+    read(value->constDataOrAggData);
+
+    if (SVFFunction* fun = SVFUtil::dyn_cast<SVFFunction>(value))
+    {
+        read(fun->isDecl);
+        read(fun->intrinsic);
+        read(fun->addrTaken);
+        read(fun->isUncalled);
+        read(fun->isNotRet);
+        read(fun->varArg);
+        read(fun->funcType);
+        read(fun->realDefFun);
+        read(fun->allArgs);
+        read(fun->exitBlock);
+        read(fun->callGraphNode);
+        read(fun->bbGraph->id);
+
+        SVFLoopAndDomInfo* ld = fun->loopAndDom;
+        read(ld->reachableBBs);
+        read(ld->dtBBsMap);
+        read(ld->pdtBBsMap);
+        read(ld->dfBBsMap);
+        read(ld->bb2LoopMap);
+        read(ld->bb2PdomLevel);
+        read(ld->bb2PIdom);
+
+        std::vector<std::string> annotations;
+        read(annotations);
+        if (!annotations.empty())
+            ExtAPI::getExtAPI()->func2Annotations[fun] = annotations;
+    }
+    else if (SVFArgument* arg = SVFUtil::dyn_cast<SVFArgument>(value))
+    {
+        read(arg->fun);
+        read(arg->argNo);
+        read(arg->uncalled);
+    }
+    else if (SVFGlobalValue* glob = SVFUtil::dyn_cast<SVFGlobalValue>(value))
+        read(glob->realDefGlobal);
+    else if (SVFConstantInt* constInt = SVFUtil::dyn_cast<SVFConstantInt>(value))
+    {
+        read(constInt->zval);
+        read(constInt->sval);
+    }
+    else if (SVFConstantFP* constFP = SVFUtil::dyn_cast<SVFConstantFP>(value))
+        read(constFP->dval);
+}
+
+void SVFIRReader::readBasicBlock(SVFBasicBlock* bb)
+{
+    readBaseNode(bb);
+    read(bb->succBBs);
+    read(bb->predBBs);
+    read(bb->allICFGNodes);
+
+    for (const SVFBasicBlock* succ : bb->succBBs)
+    {
+        SVFBasicBlock* dst = const_cast<SVFBasicBlock*>(succ);
+        BasicBlockEdge* edge = new BasicBlockEdge(bb, dst);
+        bb->addOutgoingEdge(edge);
+        dst->addIncomingEdge(edge);
+    }
+}
+
+void SVFIRReader::readICFGNode(ICFGNode* node)
+{
+    readBaseNode(node);
+    read(node->fun);
+    read(node->bb);
+    read(node->pagEdges);
+
+    if (IntraICFGNode* intra = SVFUtil::dyn_cast<IntraICFGNode>(node))
+        read(intra->isRet);
+    else if (FunEntryICFGNode* entry = SVFUtil::dyn_cast<FunEntryICFGNode>(node))
+        read(entry->FPNodes);
+    else if (FunExitICFGNode* exit = SVFUtil::dyn_cast<FunExitICFGNode>(node))
+        read(exit->formalRet);
+    else if (CallICFGNode* call = SVFUtil::dyn_cast<CallICFGNode>(node))
+    {
+        read(call->ret);
+        read(call->APNodes);
+        read(call->calledFunc);
+        read(call->isvararg);
+        read(call->isVirCallInst);
+        read(call->vtabPtr);
+        read(call->virtualFunIdx);
+        read(call->funNameOfVcall);
+    }
+    else if (RetICFGNode* ret = SVFUtil::dyn_cast<RetICFGNode>(node))
+    {
+        read(ret->actualRet);
+        read(ret->callBlockNode);
+    }
+}
+
+ICFGEdge* SVFIRReader::readICFGEdge()
+{
+    ICFGEdge::GEdgeFlag flag = read<ICFGEdge::GEdgeFlag>();
+    ICFGNode* src;
+    ICFGNode* dst;
+    read(src);
+    read(dst);
+
+    ICFGEdge* edge = nullptr;
+    switch (flag & ICFGEdge::EdgeKindMask)
+    {
+    case ICFGEdge::IntraCF:
+    {
+        IntraCFGEdge* intraEdge = new IntraCFGEdge(src, dst);
+        read(intraEdge->conditionVar);
+        read(intraEdge->branchCondVal);
+        edge = intraEdge;
+        break;
+    }
+    case ICFGEdge::CallCF:
+    {
+        CallCFGEdge* callEdge = new CallCFGEdge(src, dst);
+        read(callEdge->callPEs);
+        edge = callEdge;
+        break;
+    }
+    case ICFGEdge::RetCF:
+    {
+        RetCFGEdge* retEdge = new RetCFGEdge(src, dst);
+        read(retEdge->retPE);
+        edge = retEdge;
+        break;
+    }
+    default:
+        corrupt("unknown ICFGEdge kind");
+    }
+    edge->edgeFlag = flag;
+    icfg->addICFGEdge(edge);
+    return edge;
+}
+
+SVFLoop* SVFIRReader::readLoop()
+{
+    SVFLoop::ICFGNodeSet nodes;
+    read(nodes);
+    SVFLoop* loop = new SVFLoop(nodes, read<u32_t>());
+    read(loop->entryICFGEdges);
+    read(loop->backICFGEdges);
+    read(loop->inICFGEdges);
+    read(loop->outICFGEdges);
+    return loop;
+}
+
+void SVFIRReader::readCallGraphEdge()
+{
+    CallGraphEdge::GEdgeFlag flag = read<CallGraphEdge::GEdgeFlag>();
+    CallGraphNode* src;
+    CallGraphNode* dst;
+    read(src);
+    read(dst);
+    CallGraphEdge::CallInstSet directCalls;
+    read(directCalls);
+
+    if (directCalls.empty())
+        corrupt("call graph edge without callsite");
+    CallGraphEdge* edge = new CallGraphEdge(src, dst, *directCalls.begin());
+    edge->edgeFlag = flag;
+    edge->directCalls = directCalls;
+    src->addOutgoingEdge(edge);
+    dst->addIncomingEdge(edge);
+    for (const CallICFGNode* cs : directCalls)
+        callGraph->callinstToCallGraphEdgesMap[cs].insert(edge);
+}
+
+void SVFIRReader::readObjTypeInfo(ObjTypeInfo* objTypeInfo)
+{
+    read(objTypeInfo->flags);
+    read(objTypeInfo->maxOffsetLimit);
+    read(objTypeInfo->elemNum);
+    read(objTypeInfo->byteSize);
+}
+
+void SVFIRReader::readVar(SVFVar* var)
+{
+    readBaseNode(var);
+
+    if (ValVar* valVar = SVFUtil::dyn_cast<ValVar>(var))
+        read(valVar->icfgNode);
+
+    if (ArgValVar* argVar = SVFUtil::dyn_cast<ArgValVar>(var))
+    {
+        read(argVar->cgNode);
+        read(argVar->argNo);
+        read(argVar->uncalled);
+    }
+    else if (FunValVar* funVar = SVFUtil::dyn_cast<FunValVar>(var))
+        read(funVar->callGraphNode);
+    else if (GepValVar* gepVar = SVFUtil::dyn_cast<GepValVar>(var))
+    {
+        read(gepVar->ap);
+        read(gepVar->base);
+        read(gepVar->gepValType);
+    }
+    else if (RetValPN* retVar = SVFUtil::dyn_cast<RetValPN>(var))
+        read(retVar->callGraphNode);
+    else if (VarArgValPN* varargVar = SVFUtil::dyn_cast<VarArgValPN>(var))
+        read(varargVar->callGraphNode);
+    else if (ConstFPValVar* fpVar = SVFUtil::dyn_cast<ConstFPValVar>(var))
+        read(fpVar->dval);
+    else if (ConstIntValVar* intVar = SVFUtil::dyn_cast<ConstIntValVar>(var))
+    {
+        read(intVar->zval);
+        read(intVar->sval);
+    }
+    else if (GepObjVar* gepObj = SVFUtil::dyn_cast<GepObjVar>(var))
+    {
+        read(gepObj->apOffset);
+        read(gepObj->base);
+    }
+
+    if (BaseObjVar* baseObj = SVFUtil::dyn_cast<BaseObjVar>(var))
+    {
+        read(baseObj->typeInfo);
+        read(baseObj->icfgNode);
+    }
+
+    if (FunObjVar* funObj = SVFUtil::dyn_cast<FunObjVar>(var))
+        read(funObj->callGraphNode);
+    else if (ConstFPObjVar* fpObj = SVFUtil::dyn_cast<ConstFPObjVar>(var))
+        read(fpObj->dval);
+    else if (ConstIntObjVar* intObj = SVFUtil::dyn_cast<ConstIntObjVar>(var))
+    {
+        read(intObj->zval);
+        read(intObj->sval);
+    }
+}
+
+void SVFIRReader::readStmt(SVFStmt* stmt)
+{
+    read(stmt->edgeFlag);
+    read(stmt->src);
+    read(stmt->dst);
+    read(stmt->value);
+    read(stmt->basicBlock);
+    read(stmt->icfgNode);
+    read(stmt->edgeId);
+
+    if (AddrStmt* addr = SVFUtil::dyn_cast<AddrStmt>(stmt))
+        read(addr->arrSize);
+    else if (CopyStmt* copy = SVFUtil::dyn_cast<CopyStmt>(stmt))
+        read(copy->copyKind);
+    else if (GepStmt* gep = SVFUtil::dyn_cast<GepStmt>(stmt))
+    {
+        read(gep->ap);
+        read(gep->variantField);
+    }
+    else if (CallPE* callPE = SVFUtil::dyn_cast<CallPE>(stmt))
+    {
+        read(callPE->call);
+        read(callPE->entry);
+    }
+    else if (RetPE* retPE = SVFUtil::dyn_cast<RetPE>(stmt))
+    {
+        read(retPE->call);
+        read(retPE->exit);
+    }
+    else if (MultiOpndStmt* multi = SVFUtil::dyn_cast<MultiOpndStmt>(stmt))
+    {
+        read(multi->opVars);
+        if (PhiStmt* phi = SVFUtil::dyn_cast<PhiStmt>(stmt))
+            read(phi->opICFGNodes);
+        else if (SelectStmt* select = SVFUtil::dyn_cast<SelectStmt>(stmt))
+            read(select->condition);
+        else if (CmpStmt* cmp = SVFUtil::dyn_cast<CmpStmt>(stmt))
+            read(cmp->predicate);
+        else if (BinaryOPStmt* binary = SVFUtil::dyn_cast<BinaryOPStmt>(stmt))
+            read(binary->opcode);
+    }
+    else if (UnaryOPStmt* unary = SVFUtil::dyn_cast<UnaryOPStmt>(stmt))
+        read(unary->opcode);
+    else if (BranchStmt* branch = SVFUtil::dyn_cast<BranchStmt>(stmt))
+    {
+        read(branch->successors);
+        read(branch->cond);
+        read(branch->brInst);
+    }
+
+    svfIR->addEdge(stmt->src, stmt->dst, stmt);
+}
+
+void SVFIRReader::readCHNode(CHNode* node)
+{
+    read(node->vtable);
+    read(node->flags);
+    read(node->virtualFunctionVectors);
+    for (u32_t i = 0, size = read<u32_t>(); i < size; ++i)
+    {
+        CHNode* dst;
+        read(dst);
+        CHEdge::CHEDGETYPE edgeType = read<CHEdge::CHEDGETYPE>();
+        CHEdge* edge = new CHEdge(node, dst, edgeType, read<CHEdge::GEdgeFlag>());
+        node->addOutgoingEdge(edge);
+        dst->addIncomingEdge(edge);
+    }
+}
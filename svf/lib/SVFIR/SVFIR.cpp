@@ -422,26 +422,63 @@ NodeID SVFIR::getGepObjVar(NodeID id, const APOffset& apOffset)
  */
 NodeID SVFIR::getGepObjVar(const BaseObjVar* baseObj, const APOffset& apOffset)
 {
-    NodeID base = baseObj->getId();
+    NodeID gep;
+    APOffset newLS;
+    if (lookupGepObjVar(baseObj, apOffset, gep, newLS))
+        return gep;
+
+    NodeID gepId = NodeIDAllocator::get()->allocateGepObjectId(baseObj->getId(), apOffset, Options::MaxFieldLimit());
+    return addGepObjNode(baseObj, newLS, gepId);
+}
 
+/*!
+ * Look up the field obj node of baseObj at apOffset, shared by getGepObjVar and findGepObjVar.
+ * Return false if the node has not been created yet; newLS is then the offset to create it at.
+ */
+bool SVFIR::lookupGepObjVar(const BaseObjVar* baseObj, const APOffset& apOffset, NodeID& gep, APOffset& newLS)
+{
     /// if this obj is field-insensitive, just return the field-insensitive node.
     if (baseObj->isFieldInsensitive())
-        return getFIObjVar(baseObj);
+    {
+        gep = getFIObjVar(baseObj);
+        return true;
+    }
 
-    APOffset newLS = pag->getModulusOffset(baseObj, apOffset);
+    newLS = getModulusOffset(baseObj, apOffset);
 
     // Base and first field are the same memory location.
-    if (Options::FirstFieldEqBase() && newLS == 0) return base;
-
-    NodeOffsetMap::iterator iter = GepObjVarMap.find(std::make_pair(base, newLS));
-    if (iter == GepObjVarMap.end())
+    if (Options::FirstFieldEqBase() && newLS == 0)
     {
-        NodeID gepId = NodeIDAllocator::get()->allocateGepObjectId(base, apOffset, Options::MaxFieldLimit());
-        return addGepObjNode(baseObj, newLS, gepId);
+        gep = baseObj->getId();
+        return true;
     }
-    else
-        return iter->second;
 
+    NodeOffsetMap::const_iterator iter = GepObjVarMap.find(std::make_pair(baseObj->getId(), newLS));
+    if (iter == GepObjVarMap.end())
+        return false;
+    gep = iter->second;
+    return true;
+}
+
+/*!
+ * Look up an existing field obj node of a mem obj without creating it.
+ * Return false if getGepObjVar would have to create the node (or warn about
+ * a negative offset), which lets callers query the SVFIR concurrently.
+ */
+bool SVFIR::findGepObjVar(NodeID id, const APOffset& apOffset, NodeID& gep)
+{
+    const BaseObjVar* baseObj = getBaseObject(id);
+    assert(baseObj && "not an object node?");
+    APOffset offset = apOffset;
+    if (const GepObjVar* gepNode = SVFUtil::dyn_cast<GepObjVar>(getGNode(id)))
+        offset += gepNode->getConstantFieldIdx();
+
+    // getModulusOffset warns about negative offsets, which must not happen concurrently.
+    if (offset < 0 && !baseObj->isFieldInsensitive())
+        return false;
+
+    APOffset newLS;
+    return lookupGepObjVar(baseObj, offset, gep, newLS);
 }
 
 /*!
@@ -0,0 +1,299 @@
+//===- BDDExpr.cpp -- BDD conditions----------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+/*
+ * BDDExpr.cpp
+ */
+
+#include "Util/BDDExpr.h"
+#include <functional>
+#include <sstream>
+
+namespace SVF
+{
+
+BDDManager::BDDManager()
+    : cache(1u << CacheBits, CacheEntry{OpNeg, FalseNode, FalseNode, FalseNode}),
+      gcThreshold(InitGCThreshold), peakNodeNum(2), gcNum(0), cacheLookups(0), cacheHits(0)
+{
+    nodes.push_back(BDDNode{TerminalVar, FalseNode, FalseNode, 0});
+    nodes.push_back(BDDNode{TerminalVar, TrueNode, TrueNode, 0});
+}
+
+/// Get the BDD manager, singleton design here to make sure we only have one node table
+BDDManager& BDDManager::getManager()
+{
+    static BDDManager manager;
+    return manager;
+}
+
+/// Return the node of (v ? hi : lo), creating it if it is not in the unique table
+u32_t BDDManager::makeNode(u32_t v, u32_t lo, u32_t hi)
+{
+    if (lo == hi)
+        return lo;
+
+    NodeKey key(v, ((u64_t)lo << 32) | hi);
+    UniqueTable::const_iterator it = uniqueTable.find(key);
+    if (it != uniqueTable.end())
+        return it->second;
+
+    u32_t n;
+    if (!freeNodes.empty())
+    {
+        n = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[n] = BDDNode{v, lo, hi, 0};
+    }
+    else
+    {
+        n = nodes.size();
+        nodes.push_back(BDDNode{v, lo, hi, 0});
+    }
+    uniqueTable.emplace(key, n);
+    peakNodeNum = std::max(peakNodeNum, getNodeNum());
+    return n;
+}
+
+bool BDDManager::lookupCache(u32_t op, u32_t lhs, u32_t rhs, u32_t& res)
+{
+    ++cacheLookups;
+    const CacheEntry& entry = getCacheEntry(op, lhs, rhs);
+    if (entry.op == op && entry.lhs == lhs && entry.rhs == rhs)
+    {
+        ++cacheHits;
+        res = entry.res;
+        return true;
+    }
+    return false;
+}
+
+void BDDManager::insertCache(u32_t op, u32_t lhs, u32_t rhs, u32_t res)
+{
+    getCacheEntry(op, lhs, rhs) = CacheEntry{op, lhs, rhs, res};
+}
+
+/*!
+ * Shannon expansion of lhs op rhs on the smaller of their top variables
+ */
+u32_t BDDManager::apply(OpCode op, u32_t lhs, u32_t rhs)
+{
+    if (op == OpAnd)
+    {
+        if (lhs == FalseNode || rhs == FalseNode)
+            return FalseNode;
+        if (lhs == TrueNode || lhs == rhs)
+            return rhs;
+        if (rhs == TrueNode)
+            return lhs;
+    }
+    else
+    {
+        if (lhs == TrueNode || rhs == TrueNode)
+            return TrueNode;
+        if (lhs == FalseNode || lhs == rhs)
+            return rhs;
+        if (rhs == FalseNode)
+            return lhs;
+    }
+    /// both operations are commutative
+    if (lhs > rhs)
+        std::swap(lhs, rhs);
+
+    u32_t res;
+    if (lookupCache(op, lhs, rhs, res))
+        return res;
+
+    u32_t v = std::min(var(lhs), var(rhs));
+    u32_t lhsLo = var(lhs) == v ? lo(lhs) : lhs;
+    u32_t lhsHi = var(lhs) == v ? hi(lhs) : lhs;
+    u32_t rhsLo = var(rhs) == v ? lo(rhs) : rhs;
+    u32_t rhsHi = var(rhs) == v ? hi(rhs) : rhs;
+    u32_t resLo = apply(op, lhsLo, rhsLo);
+    u32_t resHi = apply(op, lhsHi, rhsHi);
+    res = makeNode(v, resLo, resHi);
+
+    insertCache(op, lhs, rhs, res);
+    return res;
+}
+
+u32_t BDDManager::neg(u32_t n)
+{
+    if (n == FalseNode)
+        return TrueNode;
+    if (n == TrueNode)
+        return FalseNode;
+
+    u32_t res;
+    if (lookupCache(OpNeg, n, n, res))
+        return res;
+
+    u32_t resLo = neg(lo(n));
+    u32_t resHi = neg(hi(n));
+    res = makeNode(var(n), resLo, resHi);
+
+    insertCache(OpNeg, n, n, res);
+    return res;
+}
+
+u32_t BDDManager::getVarNode(u32_t v)
+{
+    assert(v != TerminalVar && "not a variable");
+    collectGarbage();
+    return makeNode(v, FalseNode, TrueNode);
+}
+
+u32_t BDDManager::AND(u32_t lhs, u32_t rhs)
+{
+    collectGarbage();
+    return apply(OpAnd, lhs, rhs);
+}
+
+u32_t BDDManager::OR(u32_t lhs, u32_t rhs)
+{
+    collectGarbage();
+    return apply(OpOr, lhs, rhs);
+}
+
+u32_t BDDManager::NEG(u32_t n)
+{
+    collectGarbage();
+    return neg(n);
+}
+
+/*!
+ * Mark the nodes reachable from a referenced node and free all others.
+ * Only called on entry to a top-level operation, when every node still
+ * needed is held by some BDDExpr.
+ */
+void BDDManager::collectGarbage()
+{
+    if (getNodeNum() < gcThreshold)
+        return;
+
+    std::vector<bool> marked(nodes.size(), false);
+    marked[FalseNode] = marked[TrueNode] = true;
+    std::vector<u32_t> worklist;
+    for (u32_t n = TrueNode + 1; n < nodes.size(); ++n)
+    {
+        if (nodes[n].ref > 0 && !marked[n])
+        {
+            marked[n] = true;
+            worklist.push_back(n);
+        }
+    }
+    while (!worklist.empty())
+    {
+        u32_t n = worklist.back();
+        worklist.pop_back();
+        for (u32_t succ : {lo(n), hi(n)})
+        {
+            if (!marked[succ])
+            {
+                marked[succ] = true;
+                worklist.push_back(succ);
+            }
+        }
+    }
+
+    /// free slots are already unmarked, so rebuild the free list from scratch
+    freeNodes.clear();
+    uniqueTable.clear();
+    for (u32_t n = nodes.size() - 1; n > TrueNode; --n)
+    {
+        if (marked[n])
+            uniqueTable.emplace(NodeKey(var(n), ((u64_t)lo(n) << 32) | hi(n)), n);
+        else
+            freeNodes.push_back(n);
+    }
+    std::fill(cache.begin(), cache.end(), CacheEntry{OpNeg, FalseNode, FalseNode, FalseNode});
+
+    ++gcNum;
+    /// do not collect again before the live nodes double
+    gcThreshold = std::max(gcThreshold, 2 * getNodeNum());
+}
+
+/// Collect the literals on the paths to true, as (variable, polarity) pairs
+void BDDExpr::getLiterals(const BDDExpr& expr, Set<std::pair<u32_t, bool>>& literals)
+{
+    assert(!expr.isNull() && "null condition");
+    const BDDManager& mgr = BDDManager::getManager();
+    /// every non-false node of a reduced BDD reaches true
+    Set<u32_t> visited;
+    std::vector<u32_t> worklist;
+    worklist.push_back(expr.node);
+    while (!worklist.empty())
+    {
+        u32_t n = worklist.back();
+        worklist.pop_back();
+        if (n <= BDDManager::TrueNode || !visited.insert(n).second)
+            continue;
+        if (mgr.lo(n) != BDDManager::FalseNode)
+        {
+            literals.insert(std::make_pair(mgr.var(n), false));
+            worklist.push_back(mgr.lo(n));
+        }
+        if (mgr.hi(n) != BDDManager::FalseNode)
+        {
+            literals.insert(std::make_pair(mgr.var(n), true));
+            worklist.push_back(mgr.hi(n));
+        }
+    }
+}
+
+/// output BDD as a disjunction of its paths to true
+std::string BDDExpr::dumpStr(const BDDExpr& expr)
+{
+    if (expr.isNull())
+        return "null";
+    if (expr.isTrue())
+        return "true";
+    if (expr.isFalse())
+        return "false";
+
+    const BDDManager& mgr = BDDManager::getManager();
+    std::ostringstream out;
+    bool first = true;
+    std::vector<std::string> path;
+    std::function<void(u32_t)> dumpPaths = [&](u32_t n)
+    {
+        if (n == BDDManager::FalseNode)
+            return;
+        if (n == BDDManager::TrueNode)
+        {
+            out << (first ? "" : " | ") << "(";
+            for (u32_t i = 0; i < path.size(); ++i)
+                out << (i == 0 ? "" : " & ") << path[i];
+            out << ")";
+            first = false;
+            return;
+        }
+        path.push_back("!c" + std::to_string(mgr.var(n)));
+        dumpPaths(mgr.lo(n));
+        path.back() = "c" + std::to_string(mgr.var(n));
+        dumpPaths(mgr.hi(n));
+        path.pop_back();
+    };
+    dumpPaths(expr.node);
+    return out.str();
+}
+
+} // End namespace SVF
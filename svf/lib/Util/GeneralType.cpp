@@ -0,0 +1,99 @@
+//===- GeneralType.cpp -- Primitive types used in SVF-----------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * GeneralType.cpp
+ */
+
+#include "Util/GeneralType.h"
+#include <mutex>
+
+using namespace SVF;
+
+CallStrCxt::CxtNode CallStrCxt::firstChunk[1u << CallStrCxt::ChunkBits];
+/// constant-initialised, so the empty context is readable before any static constructor runs
+CallStrCxt::CxtNode* CallStrCxt::chunks[CallStrCxt::MaxChunks] = {CallStrCxt::firstChunk};
+
+namespace
+{
+/// Guards the trie against concurrent insertions, e.g., from parallel SABER slicing
+std::mutex cxtTrieMutex;
+/// (parent, call site) -> child context
+Map<u64_t, u32_t> cxtTrieChildren;
+u32_t numOfCxtNodes = 1;
+
+/// Per-thread direct-mapped cache of trie edges, which never change once added,
+/// so most pushes do not take the lock. A zero child marks an empty slot.
+struct CxtTrieEdge
+{
+    u64_t key;
+    u32_t child;
+};
+constexpr u32_t CxtTrieCacheBits = 12;
+thread_local CxtTrieEdge cxtTrieCache[1u << CxtTrieCacheBits];
+}
+
+u32_t CallStrCxt::getChild(u32_t parent, u32_t callSite)
+{
+    u64_t key = ((u64_t)parent << 32) | callSite;
+    CxtTrieEdge& cached = cxtTrieCache[(key * 0x9E3779B97F4A7C15ULL) >> (64 - CxtTrieCacheBits)];
+    if (cached.child != EmptyCxt && cached.key == key)
+        return cached.child;
+
+    std::lock_guard<std::mutex> lock(cxtTrieMutex);
+    Map<u64_t, u32_t>::const_iterator it = cxtTrieChildren.find(key);
+    if (it != cxtTrieChildren.end())
+    {
+        cached = CxtTrieEdge{key, it->second};
+        return it->second;
+    }
+
+    u32_t child = numOfCxtNodes++;
+    assert(child != EmptyCxt && "too many calling contexts");
+    CxtNode*& chunk = chunks[child >> ChunkBits];
+    if (chunk == nullptr)
+        chunk = new CxtNode[1u << ChunkBits];
+    chunk[child & ((1u << ChunkBits) - 1)] = CxtNode{parent, callSite, getNode(parent).depth + 1};
+    cxtTrieChildren.emplace(key, child);
+    cached = CxtTrieEdge{key, child};
+    return child;
+}
+
+CallStrCxt::const_iterator CallStrCxt::erase(const_iterator pos)
+{
+    assert(pos.getIndex() < size() && "erase out of bound");
+    std::vector<u32_t> suffix;
+    for (u32_t n = id, i = size(); i > pos.getIndex() + 1; --i, n = getNode(n).parent)
+        suffix.push_back(getNode(n).callSite);
+    /// drop the call sites from pos on, then push back the ones after pos
+    for (u32_t i = size(); i > pos.getIndex(); --i)
+        pop_back();
+    for (std::vector<u32_t>::reverse_iterator it = suffix.rbegin(), eit = suffix.rend(); it != eit; ++it)
+        push_back(*it);
+    return const_iterator(this, pos.getIndex());
+}
+
+u32_t CallStrCxt::getNumOfCxts()
+{
+    std::lock_guard<std::mutex> lock(cxtTrieMutex);
+    return numOfCxtNodes;
+}
@@ -1,5 +1,6 @@
 //===- NodeIDAllocator.cpp -- Allocates node IDs on request ------------------------//
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <queue>
@@ -170,6 +171,7 @@ const std::string NodeIDAllocator::Clusterer::NumObjects = "NumObjects";
 const std::string NodeIDAllocator::Clusterer::RegioningTime = "RegioningTime";
 const std::string NodeIDAllocator::Clusterer::DistanceMatrixTime = "DistanceMatrixTime";
 const std::string NodeIDAllocator::Clusterer::FastClusterTime = "FastClusterTime";
+const std::string NodeIDAllocator::Clusterer::StreamingTime = "StreamingTime";
 const std::string NodeIDAllocator::Clusterer::DendrogramTraversalTime = "DendrogramTravTime";
 const std::string NodeIDAllocator::Clusterer::EvalTime = "EvalTime";
 const std::string NodeIDAllocator::Clusterer::TotalTime = "TotalTime";
@@ -191,6 +193,7 @@ std::vector<NodeID> NodeIDAllocator::Clusterer::cluster(BVDataPTAImpl *pta, cons
 
     Map<std::string, std::string> overallStats;
     double fastClusterTime = 0.0;
+    double streamingTime = 0.0;
     double distanceMatrixTime = 0.0;
     double dendrogramTraversalTime = 0.0;
     double regioningTime = 0.0;
@@ -349,6 +352,15 @@ std::vector<NodeID> NodeIDAllocator::Clusterer::cluster(BVDataPTAImpl *pta, cons
             ++numGtIntRegions;
             nonTrivialRegionObjects += regionNumObjects;
 
+            if (method == HCLUST_METHOD_SVF_STREAMING)
+            {
+                clkStart = PTAStat::getClk(true);
+                streamRegion(regionsPointsTos[region], regionsObjects[region], nodeMap, allocCounter);
+                clkEnd = PTAStat::getClk(true);
+                streamingTime += (clkEnd - clkStart) / TIMEINTERVAL;
+                continue;
+            }
+
             double *distMatrix = getDistanceMatrix(regionsPointsTos[region], regionNumObjects,
                                                    regionReverseMappings[region], distanceMatrixTime);
 
@@ -385,8 +397,10 @@ std::vector<NodeID> NodeIDAllocator::Clusterer::cluster(BVDataPTAImpl *pta, cons
     overallStats[DistanceMatrixTime] = std::to_string(distanceMatrixTime);
     overallStats[DendrogramTraversalTime] = std::to_string(dendrogramTraversalTime);
     overallStats[FastClusterTime] = std::to_string(fastClusterTime);
+    overallStats[StreamingTime] = std::to_string(streamingTime);
     overallStats[EvalTime] = std::to_string(evalTime);
-    overallStats[TotalTime] = std::to_string(distanceMatrixTime + dendrogramTraversalTime + fastClusterTime + regioningTime + evalTime);
+    overallStats[TotalTime] = std::to_string(distanceMatrixTime + dendrogramTraversalTime + fastClusterTime + streamingTime
+                              + regioningTime + evalTime);
 
     overallStats[BestCandidate] = SVFUtil::hclustMethodToString(bestMapping.first);
     printStats(evalSubtitle + ": overall", overallStats);
@@ -498,6 +512,40 @@ double *NodeIDAllocator::Clusterer::getDistanceMatrix(const std::vector<std::pai
     return distMatrix;
 }
 
+void NodeIDAllocator::Clusterer::streamRegion(const std::vector<std::pair<const PointsTo *, unsigned>> &pointsToSets,
+        const OrderedSet<NodeID> &regionObjects, std::vector<NodeID> &nodeMap,
+        unsigned &allocCounter)
+{
+    // Most occurring sets first. Among sets occurring as often, smaller sets first:
+    // they are the ones which can fit in a word or two.
+    std::vector<std::pair<unsigned, size_t>> occAndSize;
+    std::vector<size_t> order;
+    for (size_t i = 0; i < pointsToSets.size(); ++i)
+    {
+        occAndSize.push_back(std::make_pair(pointsToSets[i].second, pointsToSets[i].first->count()));
+        order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&occAndSize](size_t i, size_t j)
+    {
+        if (occAndSize[i].first != occAndSize[j].first) return occAndSize[i].first > occAndSize[j].first;
+        return occAndSize[i].second < occAndSize[j].second;
+    });
+
+    for (size_t i : order)
+    {
+        for (const NodeID o : *pointsToSets[i].first)
+        {
+            if (nodeMap[o] == UINT_MAX) nodeMap[o] = allocCounter++;
+        }
+    }
+
+    // Every object of a region is in one of its points-to sets, but be safe.
+    for (const NodeID o : regionObjects)
+    {
+        if (nodeMap[o] == UINT_MAX) nodeMap[o] = allocCounter++;
+    }
+}
+
 void NodeIDAllocator::Clusterer::traverseDendrogram(std::vector<NodeID> &nodeMap, const int *dendrogram, const size_t numObjects, unsigned &allocCounter, Set<int> &visited, const int index, const std::vector<NodeID> &regionNodeMap)
 {
     if (visited.find(index) != visited.end()) return;
@@ -672,7 +720,8 @@ std::pair<hclust_fast_methods, std::vector<NodeID>> NodeIDAllocator::Clusterer::
             printStats(evalSubtitle + ": candidate " + candidateMethodName, candidateStats);
 
             size_t candidateWords = 0;
-            if (Options::PtType() == PointsTo::SBV) candidateWords = std::stoull(candidateStats[NewSbvNumWords]);
+            // RBV chunks, like SBV elements, only exist where bits are set.
+            if (Options::PtType() == PointsTo::SBV || Options::PtType() == PointsTo::RBV) candidateWords = std::stoull(candidateStats[NewSbvNumWords]);
             else if (Options::PtType() == PointsTo::CBV) candidateWords = std::stoull(candidateStats[NewBvNumWords]);
             else assert(false && "Clusterer::cluster: unsupported BV type for clustering.");
 
@@ -695,7 +744,7 @@ void NodeIDAllocator::Clusterer::printStats(std::string subtitle, Map<std::strin
         NumObjects, TheoreticalNumWords, OriginalSbvNumWords, OriginalBvNumWords,
         NewSbvNumWords, NewBvNumWords, NumRegions, NumGtIntRegions,
         NumNonTrivialRegionObjects, LargestRegion, RegioningTime,
-        DistanceMatrixTime, FastClusterTime, DendrogramTraversalTime,
+        DistanceMatrixTime, FastClusterTime, DendrogramTraversalTime, StreamingTime,
         EvalTime, TotalTime, BestCandidate
     };
 
@@ -56,12 +56,24 @@ const Option<u32_t> Options::FsTimeLimit(
     0
 );
 
+const Option<u32_t> Options::FsThreads(
+    "fs-threads",
+    "number of threads used to solve the independent SVFG SCCs of -fspta (1 means sequential)",
+    1
+);
+
 const Option<u32_t> Options::VersioningThreads(
     "versioning-threads",
     "number of threads to use in the versioning phase of versioned flow-sensitive analysis",
     1
 );
 
+const Option<u32_t> Options::VfsThreads(
+    "vfs-threads",
+    "number of threads processing loads and stores and propagating object versions in the main phase of -vfspta, one object per task (1 means sequential)",
+    1
+);
+
 const Option<u32_t> Options::AnderTimeLimit(
     "ander-time-limit",
     "time limit for Andersen's analyses (ignored when -fs-time-limit set)",
@@ -75,6 +87,12 @@ const Option<u32_t> Options::CxtBudget(
     10000
 );
 
+const Option<bool> Options::DDAQueryCache(
+    "dda-query-cache",
+    "Reuse the points-to sets of answered queries across queries of context-sensitive DDA",
+    false
+);
+
 // DDAPass.cpp
 const Option<u32_t> Options::MaxPathLen(
     "max-path",
@@ -130,6 +148,12 @@ const Option<bool> Options::WPANum(
     false
 );
 
+const Option<bool> Options::DDABatch(
+    "dda-batch",
+    "Answer the DDA queries as a batch, in an order chosen by the analysis to reuse results (out-of-budget results depend on the order)",
+    false
+);
+
 /// register this into alias analysis group
 //static RegisterAnalysisGroup<AliasAnalysis> AA_GROUP(DDAPA);
 OptionMultiple<PointerAnalysis::PTATY> Options::DDASelected(
@@ -261,13 +285,13 @@ const Option<bool> Options::DumpICFG(
 
 const Option<std::string> Options::DumpJson(
     "dump-json",
-    "Dump the SVFIR in JSON format",
+    "Dump a binary snapshot of the SVFIR to the given file",
     ""
 );
 
 const Option<bool> Options::ReadJson(
     "read-json",
-    "Read the SVFIR in JSON format",
+    "Read the SVFIR from a binary snapshot (the input file) instead of building it from bitcode",
     false
 );
 
@@ -295,6 +319,12 @@ const Option<bool> Options::UsePreCompFieldSensitive(
     true
 );
 
+const Option<bool> Options::SBVArena(
+    "sbv-arena",
+    "Allocate sparse bit-vector elements from an arena per pointer analysis, freed once the analysis and the elements allocated from it are",
+    false
+);
+
 const Option<bool> Options::EnableAliasCheck(
     "alias-check",
     "Enable alias check functions",
@@ -353,6 +383,7 @@ const OptionMap<PointsTo::Type> Options::PtType(
     {PointsTo::Type::SBV, "sbv", "sparse bit-vector"},
     {PointsTo::Type::CBV, "cbv", "core bit-vector (dynamic bit-vector without leading and trailing 0s)"},
     {PointsTo::Type::BV, "bv", "bit-vector (dynamic bit-vector without trailing 0s)"},
+    {PointsTo::Type::RBV, "roaring", "roaring bit-vector (array, run and bitmap containers)"},
 }
 );
 
@@ -365,6 +396,7 @@ const OptionMap<enum hclust_fast_methods> Options::ClusterMethod(
     {HCLUST_METHOD_COMPLETE, "complete", "complete linkage; nearest-neighbour-chain algorithm"},
     {HCLUST_METHOD_AVERAGE,   "average", "unweighted average linkage; nearest-neighbour-chain algorithm"},
     {HCLUST_METHOD_SVF_BEST,     "best", "try all linkage criteria; choose best"},
+    {HCLUST_METHOD_SVF_STREAMING, "streaming", "pack the objects of the most common points-to sets together; no distance matrix (for large programs)"},
 }
 );
 
@@ -419,6 +451,12 @@ const OptionMap<MemSSA::MemPartition> Options::MemPar(
 }
 );
 
+const Option<u32_t> Options::MSSAThreads(
+    "mssa-threads",
+    "number of threads computing mod-ref and building the memory SSA of functions (1 means sequential)",
+    1
+);
+
 
 // SVFG builder (SVFGBuilder.cpp)
 const Option<bool> Options::SVFGWithIndirectCall(
@@ -483,6 +521,14 @@ const Option<bool> Options::AllPairMHP(
 );
 
 
+// MTA.cpp
+const Option<u32_t> Options::MTAThreads(
+    "mta-threads",
+    "number of threads checking the candidate race pairs of the race detector (1 means sequential)",
+    1
+);
+
+
 // TCT.cpp
 const Option<bool> Options::TCTDotGraph(
     "dump-tct",
@@ -512,6 +558,12 @@ const Option<u32_t> Options::CxtLimit(
     3
 );
 
+const Option<u32_t> Options::SaberThreads(
+    "saber-threads",
+    "number of threads computing the slices of the sources of a SABER checker (1 means sequential)",
+    1
+);
+
 
 // CHG.cpp
 const Option<bool> Options::DumpCHA(
@@ -589,6 +641,12 @@ const Option<bool> Options::PrintPathCond(
     false
 );
 
+const Option<bool> Options::SaberBDD(
+    "saber-bdd",
+    "Use BDDs instead of Z3 expressions for the path conditions of SABER checkers",
+    false
+);
+
 
 // SaberSVFGBuilder.cpp
 const Option<bool> Options::CollectExtRetGlobals(
@@ -627,13 +685,19 @@ const Option<bool> Options::PrintCGGraph(
 
 const Option<std::string> Options::WriteAnder(
     "write-ander",
-    "-write-ander=ir_annotator (Annotated IR with Andersen's results) or write Andersen's analysis results to a user-specified text file",
+    "-write-ander=ir_annotator (Annotated IR with Andersen's results) or write Andersen's analysis results to a user-specified (binary) file",
     ""
 );
 
 const Option<std::string> Options::ReadAnder(
     "read-ander",
-    "-read-ander=ir_annotator (Read Andersen's analysis results from the annotated IR, e.g., *.pre.bc) or from a text file",
+    "-read-ander=ir_annotator (Read Andersen's analysis results from the annotated IR, e.g., *.pre.bc) or from a file written by -write-ander",
+    ""
+);
+
+const Option<std::string> Options::AnderSnapshot(
+    "ander-snapshot",
+    "Re-solve Andersen's analysis from the snapshot a previous run wrote to this file (if any), reusing the results of unchanged functions, then update the snapshot",
     ""
 );
 
@@ -649,6 +713,12 @@ Option<bool> Options::DetectPWC(
     true
 );
 
+const Option<u32_t> Options::AnderThreads(
+    "ander-threads",
+    "number of threads used to propagate points-to sets in each wave of -ander (1 means sequential)",
+    1
+);
+
 //SVFIRBuilder.cpp
 const Option<bool> Options::VtableInSVFIR(
     "vt-in-ir",
@@ -759,6 +829,18 @@ const Option<bool> Options::POCRHybrid(
     false
 );
 
+const Option<bool> Options::CFLMatrix(
+    "cfl-matrix",
+    "When explicit to true, CFLMatrixSolver solves CFL reachability by row unions over label-indexed adjacency matrices.",
+    false
+);
+
+const Option<u32_t> Options::CFLThreads(
+    "cfl-threads",
+    "Number of threads of CFLParallelSolver, which is used for CFL alias and value-flow analysis when more than one",
+    1
+);
+
 const Option<bool> Options::Customized(
     "customized",
     "When explicit to true, user can use any grammar file.",
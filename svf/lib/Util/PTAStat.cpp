@@ -32,6 +32,7 @@
 #include "Util/PTAStat.h"
 #include "MemoryModel/PointerAnalysisImpl.h"
 #include "SVFIR/SVFIR.h"
+#include "Util/Options.h"
 
 using namespace SVF;
 using namespace std;
@@ -70,6 +71,28 @@ void PTAStat::performStat()
     }
     PTNumStatMap["LocalVarInRecur"] = localVarInRecursion.count();
 
+    // Hits (lookups) and misses (unique operations) of the persistent points-to cache
+    BVDataPTAImpl* bvPta = SVFUtil::dyn_cast<BVDataPTAImpl>(pta);
+    if (bvPta && Options::ptDataBacking() == BVDataPTAImpl::PTBackingType::Persistent)
+    {
+        const PersistentPointsToCache<PointsTo>& ptCache = bvPta->getPtCache();
+        PTNumStatMap["UnionHits"] = ptCache.getUnionStats().lookup;
+        PTNumStatMap["UnionMisses"] = ptCache.getUnionStats().unique;
+        PTNumStatMap["ComplementHits"] = ptCache.getComplementStats().lookup;
+        PTNumStatMap["ComplementMisses"] = ptCache.getComplementStats().unique;
+        PTNumStatMap["IntersectionHits"] = ptCache.getIntersectionStats().lookup;
+        PTNumStatMap["IntersectionMisses"] = ptCache.getIntersectionStats().unique;
+    }
+
+    // Sparse bit-vector elements allocated from the heap and from arenas, and
+    // the blocks arenas allocated; the heap is hit by HeapElems + ArenaBlocks mallocs
+    if (Options::SBVArena())
+    {
+        PTNumStatMap["SBVHeapElems"] = SparseBitVectorArena::getNumOfHeapNodes();
+        PTNumStatMap["SBVArenaElems"] = SparseBitVectorArena::getNumOfArenaNodes();
+        PTNumStatMap["SBVArenaBlocks"] = SparseBitVectorArena::getNumOfBlocks();
+    }
+
     u32_t vmrss = 0;
     u32_t vmsize = 0;
     SVFUtil::getMemoryUsageKB(&vmrss, &vmsize);
@@ -0,0 +1,718 @@
+//===- RoaringBitVector.cpp -- Compressed bit vector data structure ------------//
+
+/*
+ * RoaringBitVector.cpp
+ *
+ * Two-level compressed bit vector in the style of Roaring bitmaps (implementation).
+ */
+
+#include <algorithm>
+#include <iterator>
+
+#include "Util/SparseBitVector.h"  // For LLVM's countPopulation.
+#include "Util/RoaringBitVector.h"
+
+namespace SVF
+{
+
+namespace
+{
+
+typedef RoaringBitVector::Word Word;
+
+constexpr u32_t ChunkSize = 1u << RoaringBitVector::ChunkBits;
+constexpr u32_t BitmapWords = RoaringBitVector::BitmapWords;
+
+inline bool testBit(const Word *bitmap, u32_t low)
+{
+    return (bitmap[low / 64] >> (low % 64)) & 1;
+}
+
+/// Set bits [first, last] of bitmap.
+void setRange(Word *bitmap, u32_t first, u32_t last)
+{
+    u32_t firstWord = first / 64, lastWord = last / 64;
+    Word firstMask = ~(Word)0 << (first % 64);
+    Word lastMask = ~(Word)0 >> (63 - last % 64);
+    if (firstWord == lastWord)
+    {
+        bitmap[firstWord] |= firstMask & lastMask;
+        return;
+    }
+    bitmap[firstWord] |= firstMask;
+    for (u32_t i = firstWord + 1; i < lastWord; ++i) bitmap[i] = ~(Word)0;
+    bitmap[lastWord] |= lastMask;
+}
+
+/// Returns the first set (clear if set is false) bit at or after from, or ChunkSize.
+u32_t findNext(const Word *bitmap, u32_t from, bool set)
+{
+    if (from >= ChunkSize) return ChunkSize;
+    u32_t i = from / 64;
+    Word w = (set ? bitmap[i] : ~bitmap[i]) & (~(Word)0 << (from % 64));
+    while (w == 0)
+    {
+        if (++i == BitmapWords) return ChunkSize;
+        w = set ? bitmap[i] : ~bitmap[i];
+    }
+    return i * 64 + countTrailingZeros(w);
+}
+
+/// Returns the number of bits set in bitmap and the number of runs they form.
+void countBitmap(const Word *bitmap, u32_t &card, u32_t &runs)
+{
+    card = 0;
+    runs = 0;
+    Word carry = 0;
+    for (u32_t i = 0; i < BitmapWords; ++i)
+    {
+        Word w = bitmap[i];
+        card += countPopulation(w);
+        // A run starts at every set bit whose predecessor is clear.
+        runs += countPopulation(w & ~((w << 1) | carry));
+        carry = w >> 63;
+    }
+}
+
+/// Returns the index of the first run of runs ([first, last] pairs) with last >= low.
+u32_t findRun(const std::vector<u16_t> &runs, u32_t low)
+{
+    u32_t lo = 0, hi = runs.size() / 2;
+    while (lo < hi)
+    {
+        u32_t mid = (lo + hi) / 2;
+        if (runs[2 * mid + 1] < low) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+}  // End anonymous namespace
+
+bool RoaringBitVector::Chunk::test(u32_t low) const
+{
+    if (kind == ArrayKind) return std::binary_search(data.begin(), data.end(), low);
+    else if (kind == RunKind)
+    {
+        u32_t r = findRun(data, low);
+        return 2 * r < data.size() && data[2 * r] <= low;
+    }
+    else return testBit(words.data(), low);
+}
+
+bool RoaringBitVector::Chunk::set(u32_t low)
+{
+    if (kind == ArrayKind)
+    {
+        std::vector<u16_t>::iterator it = std::lower_bound(data.begin(), data.end(), low);
+        if (it != data.end() && *it == low) return false;
+        data.insert(it, low);
+        ++card;
+        normalise();
+        return true;
+    }
+    else if (kind == RunKind)
+    {
+        u32_t r = findRun(data, low);
+        u32_t numRuns = data.size() / 2;
+        if (r < numRuns && data[2 * r] <= low) return false;
+
+        ++card;
+        bool joinsLeft = r > 0 && data[2 * r - 1] + 1u == low;
+        bool joinsRight = r < numRuns && data[2 * r] == low + 1;
+        if (joinsLeft && joinsRight)
+        {
+            data[2 * r - 1] = data[2 * r + 1];
+            data.erase(data.begin() + 2 * r, data.begin() + 2 * r + 2);
+        }
+        else if (joinsLeft) data[2 * r - 1] = low;
+        else if (joinsRight) data[2 * r] = low;
+        else
+        {
+            u16_t run[2] = { (u16_t)low, (u16_t)low };
+            data.insert(data.begin() + 2 * r, run, run + 2);
+        }
+        normalise();
+        return true;
+    }
+    else
+    {
+        if (testBit(words.data(), low)) return false;
+        words[low / 64] |= (Word)1 << (low % 64);
+        ++card;
+        bool left = low > 0 && testBit(words.data(), low - 1);
+        bool right = low + 1 < ChunkSize && testBit(words.data(), low + 1);
+        runs = runs + 1 - left - right;
+        normalise();
+        return true;
+    }
+}
+
+bool RoaringBitVector::Chunk::reset(u32_t low)
+{
+    if (kind == ArrayKind)
+    {
+        std::vector<u16_t>::iterator it = std::lower_bound(data.begin(), data.end(), low);
+        if (it == data.end() || *it != low) return false;
+        data.erase(it);
+        --card;
+        return true;
+    }
+    else if (kind == RunKind)
+    {
+        u32_t r = findRun(data, low);
+        if (2 * r >= data.size() || data[2 * r] > low) return false;
+
+        --card;
+        u32_t first = data[2 * r], last = data[2 * r + 1];
+        if (first == last) data.erase(data.begin() + 2 * r, data.begin() + 2 * r + 2);
+        else if (low == first) ++data[2 * r];
+        else if (low == last) --data[2 * r + 1];
+        else
+        {
+            // Split the run around low.
+            data[2 * r + 1] = low - 1;
+            u16_t run[2] = { (u16_t)(low + 1), (u16_t)last };
+            data.insert(data.begin() + 2 * r + 2, run, run + 2);
+        }
+        normalise();
+        return true;
+    }
+    else
+    {
+        if (!testBit(words.data(), low)) return false;
+        words[low / 64] &= ~((Word)1 << (low % 64));
+        --card;
+        bool left = low > 0 && testBit(words.data(), low - 1);
+        bool right = low + 1 < ChunkSize && testBit(words.data(), low + 1);
+        if (left && right) ++runs;
+        else if (!left && !right) --runs;
+        normalise();
+        return true;
+    }
+}
+
+void RoaringBitVector::Chunk::toBitmap(Word *bitmap) const
+{
+    if (kind == ArrayKind)
+    {
+        for (u16_t v : data) bitmap[v / 64] |= (Word)1 << (v % 64);
+    }
+    else if (kind == RunKind)
+    {
+        for (size_t r = 0; r < data.size(); r += 2) setRange(bitmap, data[r], data[r + 1]);
+    }
+    else
+    {
+        for (u32_t i = 0; i < BitmapWords; ++i) bitmap[i] |= words[i];
+    }
+}
+
+void RoaringBitVector::Chunk::fromBitmap(const Word *bitmap)
+{
+    countBitmap(bitmap, card, runs);
+    if (card <= MaxArraySize)
+    {
+        kind = ArrayKind;
+        data.clear();
+        data.reserve(card);
+        for (u32_t i = 0; i < BitmapWords; ++i)
+        {
+            for (Word w = bitmap[i]; w != 0; w &= w - 1)
+                data.push_back(i * 64 + countTrailingZeros(w));
+        }
+        std::vector<Word>().swap(words);
+    }
+    else if (runs <= MaxRuns)
+    {
+        kind = RunKind;
+        data.clear();
+        data.reserve(2 * runs);
+        for (u32_t first = findNext(bitmap, 0, true); first < ChunkSize;)
+        {
+            u32_t end = findNext(bitmap, first, false);
+            data.push_back(first);
+            data.push_back(end - 1);
+            first = findNext(bitmap, end, true);
+        }
+        std::vector<Word>().swap(words);
+    }
+    else
+    {
+        kind = BitmapKind;
+        words.assign(bitmap, bitmap + BitmapWords);
+        std::vector<u16_t>().swap(data);
+    }
+}
+
+void RoaringBitVector::Chunk::normalise(void)
+{
+    if (kind == ArrayKind)
+    {
+        if (card <= MaxArraySize) return;
+    }
+    else if (kind == RunKind)
+    {
+        if (card > MaxArraySize && data.size() / 2 <= MaxRuns) return;
+    }
+    else if (card > MaxArraySize && runs > MaxRuns) return;
+
+    Word bitmap[BitmapWords] = {};
+    toBitmap(bitmap);
+    fromBitmap(bitmap);
+}
+
+bool RoaringBitVector::Chunk::unionWith(const Chunk &rhs)
+{
+    u32_t oldCard = card;
+    if (kind == ArrayKind && rhs.kind == ArrayKind)
+    {
+        std::vector<u16_t> merged;
+        merged.reserve(card + rhs.card);
+        std::set_union(data.begin(), data.end(), rhs.data.begin(), rhs.data.end(),
+                       std::back_inserter(merged));
+        if (merged.size() == oldCard) return false;
+        data.swap(merged);
+        card = data.size();
+        normalise();
+        return true;
+    }
+    else if (kind == BitmapKind && rhs.kind == ArrayKind)
+    {
+        for (u16_t v : rhs.data)
+        {
+            if (testBit(words.data(), v)) continue;
+            words[v / 64] |= (Word)1 << (v % 64);
+            ++card;
+            bool left = v > 0 && testBit(words.data(), v - 1);
+            bool right = v + 1u < ChunkSize && testBit(words.data(), v + 1);
+            runs = runs + 1 - left - right;
+        }
+        if (card == oldCard) return false;
+        normalise();
+        return true;
+    }
+    else if (kind == BitmapKind && rhs.kind == BitmapKind)
+    {
+        Word *lw = words.data();
+        const Word *rw = rhs.words.data();
+        for (u32_t i = 0; i < BitmapWords; ++i) lw[i] |= rw[i];
+        countBitmap(lw, card, runs);
+        if (card == oldCard) return false;
+        normalise();
+        return true;
+    }
+
+    Word bitmap[BitmapWords] = {};
+    toBitmap(bitmap);
+    rhs.toBitmap(bitmap);
+    fromBitmap(bitmap);
+    return card != oldCard;
+}
+
+bool RoaringBitVector::Chunk::intersectWith(const Chunk &rhs)
+{
+    u32_t oldCard = card;
+    if (kind == ArrayKind)
+    {
+        if (rhs.kind == ArrayKind)
+        {
+            std::vector<u16_t>::iterator end = std::set_intersection(
+                                                   data.begin(), data.end(), rhs.data.begin(), rhs.data.end(), data.begin());
+            data.erase(end, data.end());
+        }
+        else data.erase(std::remove_if(data.begin(), data.end(),
+                                           [&rhs](u16_t v)
+        {
+            return !rhs.test(v);
+        }), data.end());
+        card = data.size();
+        return card != oldCard;
+    }
+    else if (rhs.kind == ArrayKind)
+    {
+        std::vector<u16_t> common;
+        for (u16_t v : rhs.data)
+            if (test(v)) common.push_back(v);
+        kind = ArrayKind;
+        data.swap(common);
+        card = data.size();
+        std::vector<Word>().swap(words);
+        return card != oldCard;
+    }
+    else if (kind == BitmapKind && rhs.kind == BitmapKind)
+    {
+        Word *lw = words.data();
+        const Word *rw = rhs.words.data();
+        for (u32_t i = 0; i < BitmapWords; ++i) lw[i] &= rw[i];
+        Word bitmap[BitmapWords];
+        std::copy(lw, lw + BitmapWords, bitmap);
+        fromBitmap(bitmap);
+        return card != oldCard;
+    }
+
+    Word lhsBitmap[BitmapWords] = {};
+    Word rhsBitmap[BitmapWords] = {};
+    toBitmap(lhsBitmap);
+    rhs.toBitmap(rhsBitmap);
+    for (u32_t i = 0; i < BitmapWords; ++i) lhsBitmap[i] &= rhsBitmap[i];
+    fromBitmap(lhsBitmap);
+    return card != oldCard;
+}
+
+bool RoaringBitVector::Chunk::subtract(const Chunk &rhs)
+{
+    u32_t oldCard = card;
+    if (kind == ArrayKind)
+    {
+        if (rhs.kind == ArrayKind)
+        {
+            std::vector<u16_t>::iterator end = std::set_difference(
+                                                   data.begin(), data.end(), rhs.data.begin(), rhs.data.end(), data.begin());
+            data.erase(end, data.end());
+        }
+        else data.erase(std::remove_if(data.begin(), data.end(),
+                                           [&rhs](u16_t v)
+        {
+            return rhs.test(v);
+        }), data.end());
+        card = data.size();
+        return card != oldCard;
+    }
+    else if (kind == BitmapKind && rhs.kind == ArrayKind)
+    {
+        for (u16_t v : rhs.data)
+        {
+            if (!testBit(words.data(), v)) continue;
+            words[v / 64] &= ~((Word)1 << (v % 64));
+            --card;
+            bool left = v > 0 && testBit(words.data(), v - 1);
+            bool right = v + 1u < ChunkSize && testBit(words.data(), v + 1);
+            if (left && right) ++runs;
+            else if (!left && !right) --runs;
+        }
+        if (card == oldCard) return false;
+        if (card != 0) normalise();
+        return true;
+    }
+
+    Word lhsBitmap[BitmapWords] = {};
+    Word rhsBitmap[BitmapWords] = {};
+    toBitmap(lhsBitmap);
+    rhs.toBitmap(rhsBitmap);
+    for (u32_t i = 0; i < BitmapWords; ++i) lhsBitmap[i] &= ~rhsBitmap[i];
+    fromBitmap(lhsBitmap);
+    return card != oldCard;
+}
+
+bool RoaringBitVector::Chunk::contains(const Chunk &rhs) const
+{
+    if (rhs.card > card) return false;
+    if (rhs.kind == ArrayKind)
+    {
+        if (kind == ArrayKind)
+            return std::includes(data.begin(), data.end(), rhs.data.begin(), rhs.data.end());
+        for (u16_t v : rhs.data)
+            if (!test(v)) return false;
+        return true;
+    }
+    else if (kind == RunKind && rhs.kind == RunKind)
+    {
+        // Every run of rhs must lie within a run of this chunk.
+        for (size_t r = 0; r < rhs.data.size(); r += 2)
+        {
+            u32_t l = findRun(data, rhs.data[r]);
+            if (2 * l >= data.size() || data[2 * l] > rhs.data[r] || data[2 * l + 1] < rhs.data[r + 1])
+                return false;
+        }
+        return true;
+    }
+
+    // rhs holds more bits than an array, and so does this chunk.
+    Word lhsBitmap[BitmapWords] = {};
+    Word rhsBitmap[BitmapWords] = {};
+    toBitmap(lhsBitmap);
+    rhs.toBitmap(rhsBitmap);
+    Word missing = 0;
+    for (u32_t i = 0; i < BitmapWords; ++i) missing |= rhsBitmap[i] & ~lhsBitmap[i];
+    return missing == 0;
+}
+
+bool RoaringBitVector::Chunk::intersects(const Chunk &rhs) const
+{
+    if (kind == ArrayKind && rhs.kind == ArrayKind)
+    {
+        std::vector<u16_t>::const_iterator l = data.begin(), r = rhs.data.begin();
+        while (l != data.end() && r != rhs.data.end())
+        {
+            if (*l < *r) ++l;
+            else if (*r < *l) ++r;
+            else return true;
+        }
+        return false;
+    }
+    else if (kind == ArrayKind || rhs.kind == ArrayKind)
+    {
+        const Chunk &array = kind == ArrayKind ? *this : rhs;
+        const Chunk &other = kind == ArrayKind ? rhs : *this;
+        for (u16_t v : array.data)
+            if (other.test(v)) return true;
+        return false;
+    }
+
+    Word lhsBitmap[BitmapWords] = {};
+    Word rhsBitmap[BitmapWords] = {};
+    toBitmap(lhsBitmap);
+    rhs.toBitmap(rhsBitmap);
+    Word common = 0;
+    for (u32_t i = 0; i < BitmapWords; ++i) common |= lhsBitmap[i] & rhsBitmap[i];
+    return common != 0;
+}
+
+bool RoaringBitVector::Chunk::operator==(const Chunk &rhs) const
+{
+    // Containers are picked by content, so equal chunks have equal containers.
+    if (key != rhs.key || kind != rhs.kind || card != rhs.card) return false;
+    return kind == BitmapKind ? words == rhs.words : data == rhs.data;
+}
+
+u32_t RoaringBitVector::Chunk::first(void) const
+{
+    if (kind == BitmapKind) return findNext(words.data(), 0, true);
+    return data.front();
+}
+
+u32_t RoaringBitVector::Chunk::last(void) const
+{
+    if (kind != BitmapKind) return data.back();
+    u32_t i = BitmapWords - 1;
+    while (words[i] == 0) --i;
+    return i * 64 + 63 - countLeadingZeros(words[i]);
+}
+
+size_t RoaringBitVector::lowerBound(u32_t key) const
+{
+    return std::lower_bound(chunks.begin(), chunks.end(), key,
+                            [](const Chunk &c, u32_t k)
+    {
+        return c.key < k;
+    }) - chunks.begin();
+}
+
+u32_t RoaringBitVector::count(void) const
+{
+    u32_t n = 0;
+    for (const Chunk &c : chunks) n += c.card;
+    return n;
+}
+
+void RoaringBitVector::clear(void)
+{
+    chunks.clear();
+    chunks.shrink_to_fit();
+}
+
+bool RoaringBitVector::test(u32_t bit) const
+{
+    size_t i = lowerBound(bit >> ChunkBits);
+    return i < chunks.size() && chunks[i].key == bit >> ChunkBits
+           && chunks[i].test(bit & (ChunkSize - 1));
+}
+
+bool RoaringBitVector::test_and_set(u32_t bit)
+{
+    u32_t key = bit >> ChunkBits;
+    size_t i = lowerBound(key);
+    if (i == chunks.size() || chunks[i].key != key) chunks.insert(chunks.begin() + i, Chunk(key));
+    return chunks[i].set(bit & (ChunkSize - 1));
+}
+
+void RoaringBitVector::reset(u32_t bit)
+{
+    u32_t key = bit >> ChunkBits;
+    size_t i = lowerBound(key);
+    if (i == chunks.size() || chunks[i].key != key) return;
+    if (chunks[i].reset(bit & (ChunkSize - 1)) && chunks[i].card == 0)
+        chunks.erase(chunks.begin() + i);
+}
+
+bool RoaringBitVector::contains(const RoaringBitVector &rhs) const
+{
+    size_t i = 0;
+    for (const Chunk &r : rhs.chunks)
+    {
+        while (i < chunks.size() && chunks[i].key < r.key) ++i;
+        if (i == chunks.size() || chunks[i].key != r.key || !chunks[i].contains(r))
+            return false;
+    }
+    return true;
+}
+
+bool RoaringBitVector::intersects(const RoaringBitVector &rhs) const
+{
+    size_t i = 0, j = 0;
+    while (i < chunks.size() && j < rhs.chunks.size())
+    {
+        if (chunks[i].key < rhs.chunks[j].key) ++i;
+        else if (rhs.chunks[j].key < chunks[i].key) ++j;
+        else if (chunks[i++].intersects(rhs.chunks[j++])) return true;
+    }
+    return false;
+}
+
+bool RoaringBitVector::operator==(const RoaringBitVector &rhs) const
+{
+    return chunks == rhs.chunks;
+}
+
+bool RoaringBitVector::operator|=(const RoaringBitVector &rhs)
+{
+    bool changed = false;
+    size_t i = 0;
+    for (const Chunk &r : rhs.chunks)
+    {
+        while (i < chunks.size() && chunks[i].key < r.key) ++i;
+        if (i == chunks.size() || chunks[i].key != r.key)
+        {
+            chunks.insert(chunks.begin() + i, r);
+            changed = true;
+        }
+        else if (chunks[i].unionWith(r)) changed = true;
+        ++i;
+    }
+    return changed;
+}
+
+bool RoaringBitVector::operator&=(const RoaringBitVector &rhs)
+{
+    bool changed = false;
+    size_t kept = 0, j = 0;
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        while (j < rhs.chunks.size() && rhs.chunks[j].key < chunks[i].key) ++j;
+        if (j < rhs.chunks.size() && rhs.chunks[j].key == chunks[i].key)
+        {
+            if (chunks[i].intersectWith(rhs.chunks[j])) changed = true;
+        }
+        else
+        {
+            changed = true;
+            continue;
+        }
+
+        if (chunks[i].card == 0) continue;
+        if (kept != i) chunks[kept] = std::move(chunks[i]);
+        ++kept;
+    }
+    chunks.erase(chunks.begin() + kept, chunks.end());
+    return changed;
+}
+
+bool RoaringBitVector::intersectWithComplement(const RoaringBitVector &rhs)
+{
+    bool changed = false;
+    size_t kept = 0, j = 0;
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        while (j < rhs.chunks.size() && rhs.chunks[j].key < chunks[i].key) ++j;
+        if (j < rhs.chunks.size() && rhs.chunks[j].key == chunks[i].key
+                && chunks[i].subtract(rhs.chunks[j]))
+            changed = true;
+
+        if (chunks[i].card == 0) continue;
+        if (kept != i) chunks[kept] = std::move(chunks[i]);
+        ++kept;
+    }
+    chunks.erase(chunks.begin() + kept, chunks.end());
+    return changed;
+}
+
+void RoaringBitVector::intersectWithComplement(const RoaringBitVector &lhs, const RoaringBitVector &rhs)
+{
+    *this = lhs;
+    intersectWithComplement(rhs);
+}
+
+size_t RoaringBitVector::hash(void) const
+{
+    // Like SparseBitVector: the count and the first and last bits (-1 if empty).
+    size_t first = static_cast<size_t>(-1), last = static_cast<size_t>(-1);
+    if (!empty())
+    {
+        first = (chunks.front().key << ChunkBits) | chunks.front().first();
+        last = (chunks.back().key << ChunkBits) | chunks.back().last();
+    }
+    Hash<std::pair<std::pair<size_t, size_t>, size_t>> h;
+    return h(std::make_pair(std::make_pair(count(), first), last));
+}
+
+RoaringBitVector::const_iterator RoaringBitVector::begin(void) const
+{
+    return RoaringBitVectorIterator(this);
+}
+
+RoaringBitVector::const_iterator RoaringBitVector::end(void) const
+{
+    return RoaringBitVectorIterator(this, true);
+}
+
+RoaringBitVector::RoaringBitVectorIterator::RoaringBitVectorIterator(const RoaringBitVector *rbv, bool end)
+    : rbv(rbv), chunk(end ? rbv->chunks.size() : 0), pos(0), low(0)
+{
+    enterChunk();
+}
+
+void RoaringBitVector::RoaringBitVectorIterator::enterChunk(void)
+{
+    pos = 0;
+    low = chunk < rbv->chunks.size() ? rbv->chunks[chunk].first() : 0;
+}
+
+const RoaringBitVector::RoaringBitVectorIterator &RoaringBitVector::RoaringBitVectorIterator::operator++(void)
+{
+    assert(chunk < rbv->chunks.size() && "RoaringBitVectorIterator::++(pre): incrementing past end!");
+    const Chunk &c = rbv->chunks[chunk];
+    if (c.kind == ArrayKind)
+    {
+        if (++pos < c.card)
+        {
+            low = c.data[pos];
+            return *this;
+        }
+    }
+    else if (c.kind == RunKind)
+    {
+        if (low < c.data[2 * pos + 1])
+        {
+            ++low;
+            return *this;
+        }
+        if (2 * ++pos < c.data.size())
+        {
+            low = c.data[2 * pos];
+            return *this;
+        }
+    }
+    else
+    {
+        u32_t next = findNext(c.words.data(), low + 1, true);
+        if (next < ChunkSize)
+        {
+            low = next;
+            return *this;
+        }
+    }
+
+    ++chunk;
+    enterChunk();
+    return *this;
+}
+
+const RoaringBitVector::RoaringBitVectorIterator RoaringBitVector::RoaringBitVectorIterator::operator++(int)
+{
+    RoaringBitVectorIterator old = *this;
+    ++*this;
+    return old;
+}
+
+};  // namespace SVF
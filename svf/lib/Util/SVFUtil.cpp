@@ -272,6 +272,8 @@ std::string SVFUtil::hclustMethodToString(hclust_fast_methods method)
         return "median";
     case HCLUST_METHOD_SVF_BEST:
         return "svf-best";
+    case HCLUST_METHOD_SVF_STREAMING:
+        return "svf-streaming";
     default:
         assert(false && "SVFUtil::hclustMethodToString: unknown method");
         abort();
@@ -0,0 +1,257 @@
+//===- SparseBitVector.cpp -- Arenas for sparse bit vectors ------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+/*
+ * SparseBitVector.cpp
+ */
+
+#include "Util/SparseBitVector.h"
+#include <algorithm>
+#include <new>
+
+namespace SVF
+{
+
+std::atomic<SparseBitVectorArena*> SparseBitVectorArena::current(nullptr);
+std::atomic<bool> SparseBitVectorArena::countHeapNodes(false);
+std::atomic<size_t> SparseBitVectorArena::numOfHeapNodes(0);
+std::atomic<size_t> SparseBitVectorArena::numOfArenaNodes(0);
+std::atomic<size_t> SparseBitVectorArena::numOfBlocks(0);
+
+static_assert(sizeof(std::list<int, SparseBitVectorAllocator<int>>) == sizeof(std::list<int>),
+              "the allocator must not make SparseBitVectors larger");
+
+/// The free lists of a thread, given back to their arenas when the thread exits.
+struct ThreadCaches
+{
+    std::vector<SparseBitVectorArena::ThreadCache> caches;
+    /// Index of the cache used last.
+    size_t last = 0;
+
+    ~ThreadCaches();
+};
+
+namespace
+{
+/// Guards the two lists below.
+std::mutex arenasMutex;
+/// Arenas pushed and not yet released, the last one being current.
+std::vector<SparseBitVectorArena*> arenaStack;
+/// Arenas not deleted yet.
+std::vector<SparseBitVectorArena*> liveArenas;
+size_t numOfArenas = 0;
+
+thread_local ThreadCaches threadCaches;
+
+inline size_t slotSize(size_t bytes)
+{
+    return (bytes + SparseBitVectorArena::SlotAlign - 1) & ~(SparseBitVectorArena::SlotAlign - 1);
+}
+
+inline void*& freeListOf(void** freeLists, size_t slot)
+{
+    return freeLists[slot / SparseBitVectorArena::SlotAlign - 1];
+}
+
+/// The arena recorded in the header of the block of p.
+inline SparseBitVectorArena* arenaOf(void* p)
+{
+    uintptr_t block = reinterpret_cast<uintptr_t>(p) & ~(uintptr_t)(SparseBitVectorArena::BlockSize - 1);
+    return *reinterpret_cast<SparseBitVectorArena**>(block);
+}
+} // End anonymous namespace
+
+ThreadCaches::~ThreadCaches()
+{
+    std::lock_guard<std::mutex> guard(arenasMutex);
+    for (SparseBitVectorArena::ThreadCache& cache : caches)
+    {
+        if (SparseBitVectorArena::isLive(cache))
+            cache.arena->giveBack(cache);
+    }
+}
+
+SparseBitVectorArena::SparseBitVectorArena() : id(0), refs(1), freeLists() {}
+
+SparseBitVectorArena* SparseBitVectorArena::push()
+{
+    SparseBitVectorArena* arena = new SparseBitVectorArena();
+    countHeapNodes.store(true, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> guard(arenasMutex);
+    arena->id = ++numOfArenas;
+    liveArenas.push_back(arena);
+    arenaStack.push_back(arena);
+    current.store(arena, std::memory_order_release);
+    return arena;
+}
+
+/*!
+ * Arenas need not be released in the order they were pushed.
+ * The blocks stay until every node allocated from them has been freed,
+ * as SparseBitVectors may outlive the analysis that created them.
+ */
+void SparseBitVectorArena::release()
+{
+    {
+        std::lock_guard<std::mutex> guard(arenasMutex);
+        std::vector<SparseBitVectorArena*>::iterator it = std::find(arenaStack.begin(), arenaStack.end(), this);
+        assert(it != arenaStack.end() && "arena released twice?");
+        arenaStack.erase(it);
+        current.store(arenaStack.empty() ? nullptr : arenaStack.back(), std::memory_order_release);
+    }
+    unref();
+}
+
+SparseBitVectorArena::~SparseBitVectorArena()
+{
+    for (char* block : blocks)
+        ::operator delete(block, std::align_val_t(BlockSize));
+}
+
+bool SparseBitVectorArena::isLive(const ThreadCache& cache)
+{
+    // the arena of a cache may have been deleted, and another one allocated at its address
+    std::vector<SparseBitVectorArena*>::iterator it = std::find(liveArenas.begin(), liveArenas.end(), cache.arena);
+    return it != liveArenas.end() && (*it)->id == cache.arenaId;
+}
+
+void SparseBitVectorArena::unref()
+{
+    if (refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+    {
+        std::lock_guard<std::mutex> guard(arenasMutex);
+        liveArenas.erase(std::find(liveArenas.begin(), liveArenas.end(), this));
+    }
+    delete this;
+}
+
+void* SparseBitVectorArena::allocateSlot(size_t bytes)
+{
+    size_t slot = slotSize(bytes);
+    numOfArenaNodes.fetch_add(1, std::memory_order_relaxed);
+    refs.fetch_add(1, std::memory_order_relaxed);
+
+    ThreadCache& cache = getThreadCache();
+    void*& freeList = freeListOf(cache.freeLists, slot);
+    if (freeList == nullptr && static_cast<size_t>(cache.end - cache.top) < slot)
+        refill(cache, slot);
+
+    if (freeList != nullptr)
+    {
+        void* p = freeList;
+        freeList = *static_cast<void**>(p);
+        return p;
+    }
+    void* p = cache.top;
+    cache.top += slot;
+    return p;
+}
+
+void SparseBitVectorArena::deallocateSlot(void* p, size_t bytes)
+{
+    SparseBitVectorArena* arena = arenaOf(p);
+    ThreadCache& cache = arena->getThreadCache();
+    void*& freeList = freeListOf(cache.freeLists, slotSize(bytes));
+    *static_cast<void**>(p) = freeList;
+    freeList = p;
+    arena->unref();
+}
+
+SparseBitVectorArena::ThreadCache& SparseBitVectorArena::getThreadCache()
+{
+    std::vector<ThreadCache>& caches = threadCaches.caches;
+    size_t& last = threadCaches.last;
+    if (last < caches.size() && caches[last].arena == this && caches[last].arenaId == id)
+        return caches[last];
+    for (last = 0; last < caches.size(); ++last)
+    {
+        if (caches[last].arena == this && caches[last].arenaId == id)
+            return caches[last];
+    }
+
+    // The caches of deleted arenas are dropped, so that their number stays small.
+    {
+        std::lock_guard<std::mutex> guard(arenasMutex);
+        caches.erase(std::remove_if(caches.begin(), caches.end(), [](const ThreadCache& cache)
+        {
+            return !isLive(cache);
+        }), caches.end());
+    }
+    ThreadCache cache = ThreadCache();
+    cache.arena = this;
+    cache.arenaId = id;
+    caches.push_back(cache);
+    last = caches.size() - 1;
+    return caches[last];
+}
+
+void SparseBitVectorArena::refill(ThreadCache& cache, size_t slot)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+
+    void*& freeList = freeListOf(freeLists, slot);
+    if (freeList != nullptr)
+    {
+        freeListOf(cache.freeLists, slot) = freeList;
+        freeList = nullptr;
+        return;
+    }
+
+    while (!spareBlocks.empty())
+    {
+        std::pair<char*, char*> spare = spareBlocks.back();
+        spareBlocks.pop_back();
+        if (static_cast<size_t>(spare.second - spare.first) >= slot)
+        {
+            cache.top = spare.first;
+            cache.end = spare.second;
+            return;
+        }
+    }
+
+    char* block = static_cast<char*>(::operator new(BlockSize, std::align_val_t(BlockSize)));
+    *reinterpret_cast<SparseBitVectorArena**>(block) = this;
+    blocks.push_back(block);
+    numOfBlocks.fetch_add(1, std::memory_order_relaxed);
+    cache.top = block + SlotOffset;
+    cache.end = block + BlockSize;
+}
+
+void SparseBitVectorArena::giveBack(ThreadCache& cache)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    for (size_t i = 0; i < MaxSlotSize / SlotAlign; ++i)
+    {
+        void* head = cache.freeLists[i];
+        if (head == nullptr)
+            continue;
+        void* tail = head;
+        while (*static_cast<void**>(tail) != nullptr)
+            tail = *static_cast<void**>(tail);
+        *static_cast<void**>(tail) = freeLists[i];
+        freeLists[i] = head;
+    }
+    if (cache.top != cache.end)
+        spareBlocks.push_back(std::make_pair(cache.top, cache.end));
+}
+
+} // End namespace SVF
@@ -33,6 +33,7 @@
 #include "MemoryModel/PointsTo.h"
 #include "WPA/Andersen.h"
 #include "WPA/Steensgaard.h"
+#include "WPA/AndersenSnapshot.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -46,6 +47,14 @@ u32_t AndersenBase::numOfProcessedLoad = 0;
 u32_t AndersenBase::numOfProcessedStore = 0;
 u32_t AndersenBase::numOfSfrs = 0;
 u32_t AndersenBase::numOfFieldExpand = 0;
+u32_t AndersenBase::numOfParallelLevels = 0;
+u32_t AndersenBase::numOfDeferredGeps = 0;
+u32_t AndersenBase::numOfIncChangedScopes = 0;
+u32_t AndersenBase::numOfIncReusedPts = 0;
+u32_t AndersenBase::numOfIncResetPts = 0;
+u64_t AndersenBase::numOfIncBaselineWork = 0;
+double AndersenBase::timeOfIncBaselineSolve = 0;
+double AndersenBase::timeOfIncSolve = 0;
 
 u32_t AndersenBase::numOfSCCDetection = 0;
 double AndersenBase::timeOfSCCDetection = 0;
@@ -136,6 +145,10 @@ void AndersenBase::analyze()
     {
         readPtsFromFile(Options::ReadAnder());
     }
+    else if(!Options::AnderSnapshot().empty())
+    {
+        solveIncrementally(Options::AnderSnapshot());
+    }
     else
     {
         if(Options::WriteAnder().empty())
@@ -177,6 +190,29 @@ void AndersenBase:: solveAndwritePtsToFile(const std::string& filename)
     finalize();
 }
 
+/*!
+ * Andersen analysis: start from the part of the solution in the snapshot which
+ * does not depend on what changed since, solve, and replace the snapshot
+ */
+void AndersenBase::solveIncrementally(const std::string& filename)
+{
+    initialize();
+    double solveStart = stat->getClk(true);
+    AndersenSnapshot snapshot(this);
+    if (snapshot.load(filename))
+    {
+        numOfIncChangedScopes = snapshot.getNumOfChangedScopes();
+        numOfIncReusedPts = snapshot.getNumOfReusedVars();
+        numOfIncResetPts = snapshot.getNumOfResetVars();
+        numOfIncBaselineWork = snapshot.getBaselineWork();
+        timeOfIncBaselineSolve = snapshot.getBaselineTime();
+    }
+    solveConstraints();
+    timeOfIncSolve = (stat->getClk(true) - solveStart) / TIMEINTERVAL;
+    snapshot.write(filename);
+    finalize();
+}
+
 void AndersenBase::cleanConsCG(NodeID id)
 {
     consCG->resetSubs(consCG->getRep(id));
@@ -829,14 +865,32 @@ bool Andersen::collapseField(NodeID nodeId)
 }
 
 /*!
- * SCC detection on constraint graph
+ * SCC detection on constraint graph, or on the part of it reachable from
+ * the wave candidates once a snapshot is loaded
  */
 NodeStack& Andersen::SCCDetect()
 {
     numOfSCCDetection++;
 
     double sccStart = stat->getClk();
-    WPAConstraintSolver::SCCDetect();
+    if (wavesFromWorklist)
+    {
+        std::vector<NodeID> pending;
+        while (!isWorklistEmpty())
+            pending.push_back(popFromWorklist());
+        for (NodeID nodeId : pending)
+        {
+            waveCandidates.insert(nodeId);
+            pushIntoWorklist(nodeId);
+        }
+        NodeSet candidates;
+        for (NodeID nodeId : waveCandidates)
+            candidates.insert(sccRepNode(nodeId));
+        waveCandidates.clear();
+        WPAConstraintSolver::SCCDetect(candidates);
+    }
+    else
+        WPAConstraintSolver::SCCDetect();
     double sccEnd = stat->getClk();
 
     timeOfSCCDetection +=  (sccEnd - sccStart)/TIMEINTERVAL;
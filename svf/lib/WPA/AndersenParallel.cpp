@@ -0,0 +1,239 @@
+//===- AndersenParallel.cpp -- Multi-threaded wave propagation Andersen's analysis--//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===--------------------------------------------------------------------------------===//
+
+/*
+ * AndersenParallel.cpp
+ *
+ * Wave propagation (AndersenWaveDiff) in which the copy/gep propagation of
+ * each topological level of a wave is computed by several threads.
+ */
+
+#include "WPA/Andersen.h"
+#include "MemoryModel/PointsTo.h"
+#include "Util/WorkList.h"
+
+using namespace SVF;
+using namespace SVFUtil;
+using namespace std;
+
+/// Levels with fewer successors per thread than this are propagated sequentially,
+/// as spawning the workers would cost more than the propagation itself.
+static const u32_t MinDstsPerThread = 64;
+
+/*!
+ * solve worklist
+ */
+void AndersenParallel::solveWorklist()
+{
+    // Nodes in nodeStack are in topological order after SCC detection and merging.
+    NodeStack& nodeStack = SCCDetect();
+
+    std::vector<NodeVector> levels;
+    computeLevels(nodeStack, levels);
+
+    // Nodes of the same level are not connected by copy/gep edges, so their
+    // propagation only depends on the levels processed before.
+    for (const NodeVector& level : levels)
+    {
+        processLevel(level);
+        collapseFields();
+    }
+
+    // New nodes will be inserted into workList during processing.
+    while (!isWorklistEmpty())
+    {
+        NodeID nodeId = popFromWorklist();
+        postProcessNode(nodeId);
+    }
+}
+
+/*!
+ * Group the nodes of nodeStack by their longest distance (over copy/gep edges)
+ * from a node without predecessors in the wave.
+ */
+void AndersenParallel::computeLevels(NodeStack& nodeStack, std::vector<NodeVector>& levels)
+{
+    Map<NodeID, u32_t> nodeToLevel;
+    while (!nodeStack.empty())
+    {
+        NodeID nodeId = nodeStack.top();
+        nodeStack.pop();
+
+        u32_t level = 0;
+        ConstraintNode* node = consCG->getConstraintNode(nodeId);
+        for (const ConstraintEdge* edge : node->getDirectInEdges())
+        {
+            NodeID src = sccRepNode(edge->getSrcID());
+            // self-cycle gep edges of PWC nodes
+            if (src == nodeId)
+                continue;
+            Map<NodeID, u32_t>::const_iterator it = nodeToLevel.find(src);
+            if (it != nodeToLevel.end())
+                level = std::max(level, it->second + 1);
+        }
+        nodeToLevel[nodeId] = level;
+
+        if (levels.size() <= level)
+            levels.resize(level + 1);
+        levels[level].push_back(nodeId);
+    }
+}
+
+/*!
+ * Propagate the diff points-to sets of a level. Everything that may change the
+ * graph (PWC collapsing, field creation, variant geps) is done sequentially;
+ * the unions into the successors are computed by the workers.
+ */
+void AndersenParallel::processLevel(const NodeVector& level)
+{
+    double propStart = stat->getClk();
+
+    for (NodeID nodeId : level)
+        collapsePWCNode(nodeId);
+
+    // Group the outgoing copy/gep edges of the level by their (rep) dst node.
+    NodeVector dsts;
+    std::vector<EdgeVector> inEdges;
+    Map<NodeID, u32_t> dstToIdx;
+    std::vector<const GepCGEdge*> variantGeps;
+    for (NodeID nodeId : level)
+    {
+        // This node may be merged during collapsePWCNode().
+        if (sccRepNode(nodeId) != nodeId)
+            continue;
+
+        computeDiffPts(nodeId);
+        if (getDiffPts(nodeId).empty())
+            continue;
+
+        ConstraintNode* node = consCG->getConstraintNode(nodeId);
+        auto addInEdge = [&](const ConstraintEdge* edge)
+        {
+            NodeID dst = sccRepNode(edge->getDstID());
+            auto res = dstToIdx.emplace(dst, dsts.size());
+            if (res.second)
+            {
+                dsts.push_back(dst);
+                inEdges.emplace_back();
+                // Make sure the pts entry exists so that the workers only read the pts map.
+                getPts(dst);
+            }
+            inEdges[res.first->second].push_back(edge);
+        };
+        for (const ConstraintEdge* edge : node->getCopyOutEdges())
+        {
+            numOfProcessedCopy++;
+            addInEdge(edge);
+        }
+        for (const ConstraintEdge* edge : node->getGepOutEdges())
+        {
+            if (const GepCGEdge* gepEdge = SVFUtil::dyn_cast<GepCGEdge>(edge))
+            {
+                if (SVFUtil::isa<VariantGepCGEdge>(gepEdge))
+                {
+                    variantGeps.push_back(gepEdge);
+                    continue;
+                }
+                numOfProcessedGep++;
+                addInEdge(edge);
+            }
+        }
+    }
+
+    // Each dst is owned by the worker which pops it, so only that worker writes newPts[i].
+    u32_t threads = std::min(Options::AnderThreads(), std::max<u32_t>(1, dsts.size() / MinDstsPerThread));
+    if (threads > 1)
+        numOfParallelLevels++;
+
+    std::vector<PointsTo> newPts(dsts.size());
+    std::vector<std::vector<DeferredGep>> deferred(threads);
+    NodeVector dstIndices(dsts.size());
+    for (u32_t i = 0; i < dsts.size(); ++i)
+        dstIndices[i] = i;
+
+    WorkStealingList<NodeID>::forEach(dstIndices, threads, [&](NodeID i, u32_t tid)
+    {
+        PointsTo incoming;
+        collectIncomingPts(inEdges[i], i, incoming, deferred[tid]);
+        newPts[i].intersectWithComplement(incoming, getPts(dsts[i]));
+    });
+
+    // Commit the new points-to targets in a fixed order.
+    for (u32_t i = 0; i < dsts.size(); ++i)
+    {
+        if (!newPts[i].empty() && unionPts(dsts[i], newPts[i]))
+            pushIntoWorklist(dsts[i]);
+    }
+    for (const std::vector<DeferredGep>& fields : deferred)
+    {
+        for (const DeferredGep& field : fields)
+        {
+            numOfDeferredGeps++;
+            const NormalGepCGEdge* gepEdge = std::get<1>(field);
+            NodeID fieldId = consCG->getGepObjVar(std::get<2>(field), gepEdge->getAccessPath().getConstantStructFldIdx());
+            NodeID dst = dsts[std::get<0>(field)];
+            if (addPts(dst, fieldId))
+                pushIntoWorklist(dst);
+        }
+    }
+    for (const GepCGEdge* gepEdge : variantGeps)
+        processGep(gepEdge->getSrcID(), gepEdge);
+
+    double propEnd = stat->getClk();
+    timeOfProcessCopyGep += (propEnd - propStart) / TIMEINTERVAL;
+}
+
+/*!
+ * Union the (gep-transformed) diff points-to sets of the srcs of inEdges.
+ * This runs in a worker thread: it must only read the points-to data and the
+ * graph; field objects which do not exist yet are deferred.
+ */
+void AndersenParallel::collectIncomingPts(const EdgeVector& inEdges, u32_t dstIdx, PointsTo& pts,
+        std::vector<DeferredGep>& deferred)
+{
+    for (const ConstraintEdge* edge : inEdges)
+    {
+        const PointsTo& srcPts = getDiffPts(edge->getSrcID());
+        if (SVFUtil::isa<CopyCGEdge>(edge))
+        {
+            pts |= srcPts;
+            continue;
+        }
+
+        const NormalGepCGEdge* gepEdge = SVFUtil::cast<NormalGepCGEdge>(edge);
+        APOffset offset = gepEdge->getAccessPath().getConstantStructFldIdx();
+        for (NodeID o : srcPts)
+        {
+            if (consCG->isBlkObjOrConstantObj(o) || isFieldInsensitive(o))
+            {
+                pts.set(o);
+                continue;
+            }
+
+            NodeID fieldSrcPtdNode;
+            if (consCG->findGepObjVar(o, offset, fieldSrcPtdNode))
+                pts.set(fieldSrcPtdNode);
+            else
+                deferred.push_back(std::make_tuple(dstIdx, gepEdge, o));
+        }
+    }
+}
@@ -0,0 +1,766 @@
+//===- AndersenSnapshot.cpp -- Snapshots for incremental Andersen's analysis --//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenSnapshot.cpp
+ */
+
+#include "WPA/AndersenSnapshot.h"
+#include "WPA/Andersen.h"
+#include "Util/BitVector.h"
+#include <algorithm>
+#include <functional>
+
+using namespace SVF;
+using namespace SVFUtil;
+
+namespace
+{
+const NodeID NoVar = UINT_MAX;
+
+inline u64_t hashString(const std::string& str)
+{
+    // FNV-1a, stable across runs unlike std::hash
+    u64_t h = 0xcbf29ce484222325ULL;
+    for (char c : str)
+    {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+inline u64_t mix(u64_t h, u64_t v)
+{
+    h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h;
+}
+
+/// Finalise h so that summing the hashes of a scope does not cancel out
+inline u64_t scramble(u64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+} // End anonymous namespace
+
+AndersenSnapshot::AndersenSnapshot(AndersenBase* p) :
+    pta(p), pag(p->getPAG()), numOfInitialNodes(0), numOfChangedScopes(0),
+    numOfReusedVars(0), numOfResetVars(0), baselineWork(0), baselineTime(0)
+{
+    for (SVFIR::const_iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+        numOfInitialNodes = std::max(numOfInitialNodes, it->first + 1);
+
+    computeKeys();
+    computeDigests();
+    recordStmtEdges();
+}
+
+u64_t AndersenSnapshot::getWork()
+{
+    return static_cast<u64_t>(AndersenBase::numOfProcessedAddr) + AndersenBase::numOfProcessedCopy +
+           AndersenBase::numOfProcessedGep + AndersenBase::numOfProcessedLoad + AndersenBase::numOfProcessedStore;
+}
+
+u64_t AndersenSnapshot::getScope(const SVFVar* var) const
+{
+    if (const GepObjVar* gep = SVFUtil::dyn_cast<GepObjVar>(var))
+        return getScope(pag->getGNode(gep->getBaseNode()));
+    if (const SVFFunction* fun = var->getFunction())
+        return hashString(fun->getName());
+    return hashString("global " + var->getName());
+}
+
+u64_t AndersenSnapshot::hashVar(NodeID id) const
+{
+    const SVFVar* var = pag->getGNode(id);
+    if (const GepObjVar* gep = SVFUtil::dyn_cast<GepObjVar>(var))
+        return mix(mix(hashVar(gep->getBaseNode()), gep->getConstantFieldIdx()), SVFVar::GepObjNode);
+    if (id < numOfInitialNodes && hasKey[id])
+        return mix(keys[id].first, keys[id].second);
+    return var->getNodeKind();
+}
+
+/*!
+ * Key the variables of each (scope, kind) by their IR name, which an edit does
+ * not change for the variables it leaves alone. Unnamed variables are numbered
+ * in ID order, which is the order the SVFIR builder visits the IR, separately
+ * for pointers and other values: the latter include the stores, which would
+ * otherwise renumber the pointers after them when one is added or deleted.
+ * Field objects are keyed by their base object and offset instead, as they are
+ * also created while solving.
+ */
+void AndersenSnapshot::computeKeys()
+{
+    keys.resize(numOfInitialNodes);
+    hasKey.resize(numOfInitialNodes, false);
+    Map<std::pair<u64_t, u64_t>, u32_t> ordinals;
+    for (NodeID id = 0; id < numOfInitialNodes; ++id)
+    {
+        if (!pag->hasGNode(id))
+            continue;
+        const SVFVar* var = pag->getGNode(id);
+        if (SVFUtil::isa<GepObjVar>(var))
+            continue;
+
+        u64_t scope = getScope(var);
+        u64_t kind = var->getNodeKind();
+        /// named keys have the top bit set, which kinds and ordinals never reach
+        VarKey key(scope, mix(hashString(var->getName()), kind) | (1ULL << 63));
+        if (var->getName().empty() || keyToVar.find(key) != keyToVar.end())
+        {
+            u64_t isPtr = var->getType() && var->getType()->isPointerTy();
+            kind = (kind << 1) | isPtr;
+            key.second = (kind << 32) | ordinals[std::make_pair(scope, kind)]++;
+        }
+        keys[id] = key;
+        hasKey[id] = true;
+        keyToVar[key] = id;
+    }
+}
+
+/*!
+ * The digest of a scope sums the hashes of its variables, of the statements
+ * of its ICFG nodes (or defining its variables, for global statements) and of
+ * the argument lists of its indirect calls and of the function itself. The
+ * latter are also summed into a binding digest of their own.
+ */
+void AndersenSnapshot::computeDigests()
+{
+    for (NodeID id = 0; id < numOfInitialNodes; ++id)
+    {
+        if (!pag->hasGNode(id))
+            continue;
+        const SVFVar* var = pag->getGNode(id);
+        scopeDigests[getScope(var)] += scramble(hashVar(id));
+
+        for (const SVFStmt* stmt : var->getOutEdges())
+        {
+            u64_t h = mix(mix(stmt->getEdgeKind(), hashVar(stmt->getSrcID())), hashVar(stmt->getDstID()));
+            if (const GepStmt* gep = SVFUtil::dyn_cast<GepStmt>(stmt))
+            {
+                h = mix(h, gep->isVariantFieldGep());
+                h = mix(h, gep->isConstantOffset() ? gep->accumulateConstantOffset() : -1);
+            }
+            else if (const MultiOpndStmt* multi = SVFUtil::dyn_cast<MultiOpndStmt>(stmt))
+            {
+                for (const SVFVar* opnd : multi->getOpndVars())
+                    h = mix(h, hashVar(opnd->getId()));
+            }
+
+            const ICFGNode* node = stmt->getICFGNode();
+            u64_t scope = node && node->getFun() ? hashString(node->getFun()->getName()) : getScope(stmt->getDstNode());
+            scopeDigests[scope] += scramble(h);
+        }
+    }
+
+    /// Indirect calls are bound to their callees by argument position while
+    /// solving rather than through statements, so digest the lists as well
+    for (const auto& item : pag->getIndirectCallsites())
+    {
+        const CallICFGNode* cs = item.first;
+        u64_t h = mix(ICFGNode::FunCallBlock, hashVar(item.second));
+        if (pag->hasCallSiteArgsMap(cs))
+        {
+            for (const SVFVar* arg : pag->getCallSiteArgsList(cs))
+                h = mix(h, hashVar(arg->getId()));
+        }
+        if (pag->callsiteHasRet(cs->getRetICFGNode()))
+            h = mix(h, hashVar(pag->getCallSiteRet(cs->getRetICFGNode())->getId()));
+        u64_t scope = hashString(cs->getFun()->getName());
+        scopeDigests[scope] += scramble(h);
+        bindingDigests[scope] += scramble(h);
+    }
+    for (const auto& item : pag->getFunArgsMap())
+    {
+        u64_t h = ICFGNode::FunEntryBlock;
+        for (const SVFVar* arg : item.second)
+            h = mix(h, hashVar(arg->getId()));
+        u64_t scope = hashString(item.first->getName());
+        scopeDigests[scope] += scramble(h);
+        bindingDigests[scope] += scramble(h);
+    }
+    for (const auto& item : pag->getFunRets())
+    {
+        u64_t h = mix(ICFGNode::FunExitBlock, hashVar(item.second->getId()));
+        u64_t scope = hashString(item.first->getName());
+        scopeDigests[scope] += scramble(h);
+        bindingDigests[scope] += scramble(h);
+    }
+}
+
+void AndersenSnapshot::recordStmtEdges()
+{
+    ConstraintGraph* consCG = pta->getConstraintGraph();
+    for (ConstraintEdge::ConstraintEdgeSetTy* edges :
+            {&consCG->getAddrCGEdges(), &consCG->getDirectCGEdges(), &consCG->getLoadCGEdges(), &consCG->getStoreCGEdges()
+            })
+    {
+        for (const ConstraintEdge* edge : *edges)
+        {
+            APOffset offset = 0;
+            if (const NormalGepCGEdge* gep = SVFUtil::dyn_cast<NormalGepCGEdge>(edge))
+                offset = gep->getConstantFieldIdx();
+            stmtEdges.push_back(StmtEdgeRecord(edge->getEdgeKind(), edge->getSrcID(), edge->getDstID(), offset));
+        }
+    }
+}
+
+bool AndersenSnapshot::load(const std::string& filename)
+{
+    PointsToFileReader F(filename);
+    if (!F.good())
+        return false;
+
+    outs() << "Loading Andersen snapshot from '" << filename << "'...";
+
+    /// Every variable of the old run, in old IDs
+    BitVector oldVars;
+    NodeID numOfOldVars = 0;
+    auto addOldVar = [&](NodeID var)
+    {
+        oldVars.set(var);
+        numOfOldVars = std::max(numOfOldVars, var + 1);
+    };
+
+    /// The old solution, as indices into the distinct old points-to sets
+    std::vector<PointsTo> oldPtsSets;
+    OrderedMap<NodeID, u32_t> oldPts;
+    if (F.seekSection(PointsToFile::PtsResult))
+    {
+        Map<const PointsTo*, u32_t> setIds;
+        while (!F.atSectionEnd())
+        {
+            NodeID var = F.readVarint();
+            const PointsTo& pts = F.readPts();
+            auto setIt = setIds.emplace(&pts, oldPtsSets.size());
+            if (setIt.second)
+                oldPtsSets.push_back(pts);
+            oldPts[var] = setIt.first->second;
+            addOldVar(var);
+        }
+    }
+
+    const PointsTo emptyPts;
+    auto getOldPts = [&](NodeID var) -> const PointsTo&
+    {
+        OrderedMap<NodeID, u32_t>::const_iterator it = oldPts.find(var);
+        return it == oldPts.end() ? emptyPts : oldPtsSets[it->second];
+    };
+
+    Map<NodeID, std::pair<NodeID, APOffset>> oldGepObjs;
+    if (F.seekSection(PointsToFile::GepObjVarMap))
+    {
+        while (!F.atSectionEnd())
+        {
+            NodeID base = F.readVarint();
+            APOffset offset = F.readSignedVarint();
+            NodeID gep = F.readVarint();
+            oldGepObjs[gep] = std::make_pair(base, offset);
+            addOldVar(gep);
+        }
+    }
+
+    NodeBS oldFIObjs;
+    if (F.seekSection(PointsToFile::ObjFieldSensitivity))
+    {
+        while (!F.atSectionEnd())
+        {
+            NodeID base = F.readVarint();
+            if (F.readVarint())
+                oldFIObjs.set(base);
+        }
+    }
+
+    if (!F.seekSection(PointsToFile::SolveInfo))
+    {
+        outs() << "  not a snapshot, solving from scratch\n";
+        return false;
+    }
+    baselineWork = F.readVarint();
+    /// snapshots written before the time was recorded only hold the work
+    baselineTime = F.atSectionEnd() ? 0 : (double)F.readVarint() / TIMEINTERVAL;
+
+    Map<NodeID, VarKey> oldKeys;
+    if (F.seekSection(PointsToFile::NodeKeys))
+    {
+        while (!F.atSectionEnd())
+        {
+            NodeID var = F.readVarint();
+            u64_t scope = F.readVarint();
+            oldKeys[var] = VarKey(scope, F.readVarint());
+            addOldVar(var);
+        }
+    }
+
+    Map<u64_t, u64_t> oldDigests;
+    if (F.seekSection(PointsToFile::ScopeDigests))
+    {
+        while (!F.atSectionEnd())
+        {
+            u64_t scope = F.readVarint();
+            oldDigests[scope] = F.readVarint();
+        }
+    }
+
+    /// Snapshots without binding digests also key variables by ordinal only
+    Map<u64_t, u64_t> oldBindingDigests;
+    if (!F.seekSection(PointsToFile::BindingDigests))
+    {
+        outs() << "  snapshot of an older version, solving from scratch\n";
+        return false;
+    }
+    while (!F.atSectionEnd())
+    {
+        u64_t scope = F.readVarint();
+        oldBindingDigests[scope] = F.readVarint();
+    }
+
+    /// The old constraint graph. Loads and stores are solved into copy edges,
+    /// so what each variable flows into is given by the edges other than stores,
+    /// plus the objects pointed to by the pointers that are stored through.
+    std::vector<std::pair<NodeID, NodeID>> flows;
+    BitVector storePtrs;
+    std::vector<StmtEdgeRecord> oldStmtEdges;
+    std::vector<std::pair<NodeID, NodeID>> oldCopies;
+    std::vector<std::pair<NodeID, NodeID>> oldIndCalls;
+    if (F.seekSection(PointsToFile::ConsGEdges))
+    {
+        while (!F.atSectionEnd())
+        {
+            u32_t kind = F.readVarint();
+            NodeID src = F.readVarint();
+            NodeID dst = F.readVarint();
+            addOldVar(src);
+            addOldVar(dst);
+            if (kind >= StmtEdge)
+            {
+                APOffset offset = kind == StmtEdge + ConstraintEdge::NormalGep ? F.readSignedVarint() : 0;
+                oldStmtEdges.push_back(StmtEdgeRecord(kind - StmtEdge, src, dst, offset));
+                continue;
+            }
+            if (kind == ConstraintEdge::Store)
+            {
+                storePtrs.set(dst);
+                continue;
+            }
+            if (kind == ConstraintEdge::Copy)
+                oldCopies.push_back(std::make_pair(src, dst));
+            else if (kind == IndCallEdge)
+                oldIndCalls.push_back(std::make_pair(src, dst));
+            flows.push_back(std::make_pair(src, dst));
+            if (kind == RepEdge)
+                flows.push_back(std::make_pair(dst, src));
+        }
+    }
+    std::vector<std::vector<NodeID>> succs(numOfOldVars);
+    for (const std::pair<NodeID, NodeID>& flow : flows)
+        succs[flow.first].push_back(flow.second);
+
+    auto diffDigests = [](const Map<u64_t, u64_t>& oldOnes, const Map<u64_t, u64_t>& newOnes)
+    {
+        Set<u64_t> changed;
+        for (const auto& digest : oldOnes)
+        {
+            Map<u64_t, u64_t>::const_iterator it = newOnes.find(digest.first);
+            if (it == newOnes.end() || it->second != digest.second)
+                changed.insert(digest.first);
+        }
+        for (const auto& digest : newOnes)
+        {
+            if (oldOnes.find(digest.first) == oldOnes.end())
+                changed.insert(digest.first);
+        }
+        return changed;
+    };
+    Set<u64_t> changedScopes = diffDigests(oldDigests, scopeDigests);
+    Set<u64_t> changedBindings = diffDigests(oldBindingDigests, bindingDigests);
+    numOfChangedScopes = changedScopes.size();
+
+    /// An old variable is mapped to the new variable with the same key, even if
+    /// its scope changed: a variable mapped to a different one has different
+    /// statements, which are handled below. Field objects are mapped through
+    /// their bases.
+    std::vector<u8_t> mappable(numOfOldVars, 0);
+    std::function<bool(NodeID)> isMappable = [&](NodeID old) -> bool
+    {
+        if (mappable[old] == 0)
+        {
+            bool res = false;
+            auto gepIt = oldGepObjs.find(old);
+            if (gepIt != oldGepObjs.end())
+                res = isMappable(gepIt->second.first);
+            else
+            {
+                auto keyIt = oldKeys.find(old);
+                res = keyIt != oldKeys.end() && keyToVar.find(keyIt->second) != keyToVar.end();
+            }
+            mappable[old] = res ? 1 : 2;
+        }
+        return mappable[old] == 1;
+    };
+    std::vector<NodeID> oldToNew(numOfOldVars, NoVar);
+    std::function<NodeID(NodeID)> mapVar = [&](NodeID old) -> NodeID
+    {
+        if (oldToNew[old] != NoVar || !isMappable(old))
+            return oldToNew[old];
+        auto gepIt = oldGepObjs.find(old);
+        if (gepIt != oldGepObjs.end())
+            oldToNew[old] = pta->getConstraintGraph()->getGepObjVar(mapVar(gepIt->second.first), gepIt->second.second);
+        else
+            oldToNew[old] = keyToVar[oldKeys[old]];
+        return oldToNew[old];
+    };
+
+    /// Reset the variables which cannot be mapped, and all variables which may
+    /// depend on them in the old constraint graph.
+    BitVector reset;
+    std::vector<NodeID> worklist;
+    auto resetVar = [&](NodeID var)
+    {
+        if (reset.test_and_set(var))
+            worklist.push_back(var);
+    };
+    for (NodeID var : oldVars)
+    {
+        if (!isMappable(var))
+            resetVar(var);
+    }
+
+    auto inChanged = [&](const Set<u64_t>& scopes)
+    {
+        std::function<bool(NodeID)> test = [&](NodeID old) -> bool
+        {
+            auto gepIt = oldGepObjs.find(old);
+            if (gepIt != oldGepObjs.end())
+                return test(gepIt->second.first);
+            auto keyIt = oldKeys.find(old);
+            return keyIt == oldKeys.end() || scopes.count(keyIt->second.first);
+        };
+        return test;
+    };
+    /// The parameters connected at an indirect callsite are not statements: if
+    /// the caller or the callee changed its argument lists, the arguments may
+    /// not be the same.
+    std::function<bool(NodeID)> inChangedBinding = inChanged(changedBindings);
+    for (const std::pair<NodeID, NodeID>& call : oldIndCalls)
+    {
+        if (inChangedBinding(call.first) || inChangedBinding(call.second))
+            resetVar(call.second);
+    }
+    /// Objects may also be field-insensitive because of their type
+    std::function<bool(NodeID)> inChangedScope = inChanged(changedScopes);
+    for (NodeID o : oldFIObjs)
+    {
+        if (inChangedScope(o))
+            resetVar(o);
+    }
+
+    /// Statements deleted between kept variables reset what they flow into, and
+    /// statements added make their ends change
+    std::vector<std::pair<StmtEdgeRecord, NodeID>> mappedStmtEdges;
+    for (const StmtEdgeRecord& edge : oldStmtEdges)
+    {
+        NodeID src = std::get<1>(edge);
+        NodeID dst = std::get<2>(edge);
+        if (isMappable(src) && isMappable(dst))
+        {
+            StmtEdgeRecord mapped(std::get<0>(edge), mapVar(src), mapVar(dst), std::get<3>(edge));
+            mappedStmtEdges.push_back(std::make_pair(mapped, dst));
+        }
+    }
+    std::sort(mappedStmtEdges.begin(), mappedStmtEdges.end());
+    std::vector<StmtEdgeRecord> newStmtEdges(stmtEdges);
+    std::sort(newStmtEdges.begin(), newStmtEdges.end());
+
+    BitVector changed;
+    std::vector<std::pair<StmtEdgeRecord, NodeID>>::const_iterator oldIt = mappedStmtEdges.begin();
+    std::vector<StmtEdgeRecord>::const_iterator newIt = newStmtEdges.begin();
+    while (oldIt != mappedStmtEdges.end() || newIt != newStmtEdges.end())
+    {
+        if (newIt == newStmtEdges.end() || (oldIt != mappedStmtEdges.end() && oldIt->first < *newIt))
+        {
+            if (std::get<0>(oldIt->first) == ConstraintEdge::Store)
+            {
+                for (NodeID o : getOldPts(oldIt->second))
+                    resetVar(o);
+            }
+            else
+                resetVar(oldIt->second);
+            ++oldIt;
+        }
+        else if (oldIt == mappedStmtEdges.end() || *newIt < oldIt->first)
+        {
+            changed.set(std::get<1>(*newIt));
+            changed.set(std::get<2>(*newIt));
+            ++newIt;
+        }
+        else
+        {
+            ++oldIt;
+            ++newIt;
+        }
+    }
+
+    while (!worklist.empty())
+    {
+        NodeID var = worklist.back();
+        worklist.pop_back();
+
+        for (NodeID succ : succs[var])
+            resetVar(succ);
+        /// stores through var
+        if (storePtrs.test(var))
+        {
+            for (NodeID o : getOldPts(var))
+                resetVar(o);
+        }
+        /// objects which var may have made field-insensitive through a positive weight cycle
+        for (NodeID o : getOldPts(var))
+        {
+            if (oldFIObjs.test(o))
+                resetVar(o);
+        }
+    }
+
+    /// Re-solving most of the program from the rest costs more than solving it
+    /// from scratch, as the reused sets hardly save any work then
+    u32_t numOfNonEmptyPts = 0;
+    for (const auto& pts : oldPts)
+    {
+        if (oldPtsSets[pts.second].empty())
+            continue;
+        ++numOfNonEmptyPts;
+        if (reset.test(pts.first))
+            ++numOfResetVars;
+    }
+    if (numOfResetVars * 2 > numOfNonEmptyPts)
+    {
+        outs() << "  " << numOfChangedScopes << " changed functions/globals, " << numOfResetVars << " of "
+               << numOfNonEmptyPts << " points-to sets to reset, solving from scratch\n";
+        /// which makes this solve the baseline of the next snapshot
+        baselineWork = 0;
+        baselineTime = 0;
+        return false;
+    }
+
+    /// Field objects are left out, so that no more of them are created than
+    /// solving from scratch would
+    BitVector kept;
+    for (NodeID var : oldVars)
+    {
+        if (!reset.test(var) && oldGepObjs.find(var) == oldGepObjs.end())
+            kept.set(mapVar(var));
+    }
+    /// The copy edges derived from loads, stores and indirect calls hold as long
+    /// as both of their ends are kept
+    ConstraintGraph* consCG = pta->getConstraintGraph();
+    for (const std::pair<NodeID, NodeID>& copy : oldCopies)
+    {
+        if (!reset.test(copy.first) && !reset.test(copy.second))
+            consCG->addCopyCGEdge(mapVar(copy.first), mapVar(copy.second));
+    }
+    /// Statements involving reset variables are solved again
+    for (const StmtEdgeRecord& edge : stmtEdges)
+    {
+        if (!kept.test(std::get<1>(edge)) || !kept.test(std::get<2>(edge)))
+        {
+            changed.set(std::get<1>(edge));
+            changed.set(std::get<2>(edge));
+        }
+    }
+
+    /// Seed the other variables with their old points-to sets
+    Andersen* ander = SVFUtil::dyn_cast<Andersen>(pta);
+    /// old set -> (new set, whether it has reset objects, a variable already seeded with exactly it)
+    Map<u32_t, std::tuple<PointsTo, bool, NodeID>> newPtsOf;
+    for (const auto& pts : oldPts)
+    {
+        if (reset.test(pts.first))
+            continue;
+        auto newIt = newPtsOf.find(pts.second);
+        if (newIt == newPtsOf.end())
+        {
+            std::tuple<PointsTo, bool, NodeID> newPts(PointsTo(), false, NoVar);
+            for (NodeID o : oldPtsSets[pts.second])
+            {
+                NodeID obj = mapVar(o);
+                assert(obj != NoVar && "unmappable object in the points-to set of a kept variable!");
+                std::get<0>(newPts).set(obj);
+                std::get<1>(newPts) |= reset.test(o);
+            }
+            newIt = newPtsOf.emplace(pts.second, newPts).first;
+        }
+        NodeID var = mapVar(pts.first);
+        /// Variables sharing an old set are seeded from the first one which holds
+        /// exactly that set, instead of building the set again for each of them
+        NodeID& seeded = std::get<2>(newIt->second);
+        if (seeded != NoVar && pta->sccRepNode(seeded) != pta->sccRepNode(var))
+            pta->unionPts(var, seeded);
+        else
+        {
+            pta->unionPts(var, std::get<0>(newIt->second));
+            if (seeded == NoVar && pta->getPts(var) == std::get<0>(newIt->second))
+                seeded = var;
+        }
+        /// the copy edges derived for the reset objects have to be added again
+        ConstraintNode* node = consCG->getConstraintNode(var);
+        if (std::get<1>(newIt->second) && (!node->getLoadOutEdges().empty() || !node->getStoreInEdges().empty()))
+            changed.set(var);
+        /// Mark the other variables as already propagated
+        if (ander && !changed.test(var))
+            ander->computeDiffPts(var);
+        else
+            changed.set(var);
+        ++numOfReusedVars;
+    }
+    for (NodeID o : oldFIObjs)
+    {
+        if (!reset.test(o))
+            pta->setObjFieldInsensitive(mapVar(o));
+    }
+
+    /// Only process the changed variables again, instead of all address targets,
+    /// and let the waves of AndersenWaveDiff only visit what they reach
+    if (ander)
+    {
+        ander->worklist.clear();
+        ander->wavesFromWorklist = pta->getAnalysisTy() == PointerAnalysis::AndersenWaveDiff_WPA;
+    }
+    for (NodeID var : changed)
+        pta->pushIntoWorklist(var);
+
+    outs() << "  " << numOfChangedScopes << " changed functions/globals, "
+           << numOfReusedVars << " points-to sets reused, " << numOfResetVars << " reset\n";
+    return true;
+}
+
+void AndersenSnapshot::write(const std::string& filename)
+{
+    u64_t work = getWork();
+    {
+        /// Replace the loaded snapshot, as writeToFile appends
+        PointsToFileWriter truncated(filename, false);
+    }
+    pta->writeToFile(filename);
+
+    PointsToFileWriter f(filename, true);
+    if (!f.good())
+        return;
+
+    /// Incremental solves report their savings against the last full solve
+    f.beginSection(PointsToFile::SolveInfo);
+    f.writeVarint(baselineWork != 0 ? baselineWork : work);
+    f.writeVarint(static_cast<u64_t>((baselineWork != 0 ? baselineTime : AndersenBase::timeOfIncSolve) * TIMEINTERVAL));
+    f.endSection();
+
+    f.beginSection(PointsToFile::NodeKeys);
+    for (NodeID id = 0; id < numOfInitialNodes; ++id)
+    {
+        if (!hasKey[id])
+            continue;
+        f.writeVarint(id);
+        f.writeVarint(keys[id].first);
+        f.writeVarint(keys[id].second);
+    }
+    f.endSection();
+
+    f.beginSection(PointsToFile::ScopeDigests);
+    for (const auto& digest : scopeDigests)
+    {
+        f.writeVarint(digest.first);
+        f.writeVarint(digest.second);
+    }
+    f.endSection();
+
+    f.beginSection(PointsToFile::BindingDigests);
+    for (const auto& digest : bindingDigests)
+    {
+        f.writeVarint(digest.first);
+        f.writeVarint(digest.second);
+    }
+    f.endSection();
+
+    ConstraintGraph* consCG = pta->getConstraintGraph();
+    f.beginSection(PointsToFile::ConsGEdges);
+    for (const StmtEdgeRecord& edge : stmtEdges)
+    {
+        f.writeVarint(StmtEdge + std::get<0>(edge));
+        f.writeVarint(std::get<1>(edge));
+        f.writeVarint(std::get<2>(edge));
+        if (std::get<0>(edge) == ConstraintEdge::NormalGep)
+            f.writeSignedVarint(std::get<3>(edge));
+    }
+    for (ConstraintEdge::ConstraintEdgeSetTy* edges :
+            {&consCG->getAddrCGEdges(), &consCG->getDirectCGEdges(), &consCG->getLoadCGEdges(), &consCG->getStoreCGEdges()
+            })
+    {
+        for (const ConstraintEdge* edge : *edges)
+        {
+            f.writeVarint(edge->getEdgeKind());
+            f.writeVarint(edge->getSrcID());
+            f.writeVarint(edge->getDstID());
+        }
+    }
+    for (SVFIR::const_iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        NodeID rep = consCG->sccRepNode(it->first);
+        if (rep == it->first)
+            continue;
+        f.writeVarint(RepEdge);
+        f.writeVarint(it->first);
+        f.writeVarint(rep);
+    }
+    /// Parameters connected at indirect callsites depend on the function pointers
+    const SVFIR::CallSiteToFunPtrMap& indCallsites = pta->getIndirectCallsites();
+    for (const auto& call : pta->getIndCallMap())
+    {
+        const CallICFGNode* cs = call.first;
+        SVFIR::CallSiteToFunPtrMap::const_iterator fpIt = indCallsites.find(cs);
+        if (fpIt == indCallsites.end())
+            continue;
+        NodeSet dsts;
+        if (pag->callsiteHasRet(cs->getRetICFGNode()))
+            dsts.insert(pag->getCallSiteRet(cs->getRetICFGNode())->getId());
+        for (const SVFFunction* callee : call.second)
+        {
+            if (pag->hasFunArgsList(callee))
+            {
+                for (const SVFVar* arg : pag->getFunArgsList(callee))
+                    dsts.insert(arg->getId());
+            }
+            if (callee->isVarArg())
+                dsts.insert(pag->getVarargNode(callee));
+        }
+        for (NodeID dst : dsts)
+        {
+            f.writeVarint(IndCallEdge);
+            f.writeVarint(fpIt->second);
+            f.writeVarint(dst);
+        }
+    }
+    f.endSection();
+}
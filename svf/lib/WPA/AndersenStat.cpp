@@ -30,6 +30,7 @@
 #include "MemoryModel/PointerAnalysis.h"
 #include "WPA/WPAStat.h"
 #include "WPA/Andersen.h"
+#include "Util/Options.h"
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -325,6 +326,26 @@ void AndersenStat::performStat()
 
     PTNumStatMap["NumOfSFRs"] = Andersen::numOfSfrs;
     PTNumStatMap["NumOfFieldExpand"] = Andersen::numOfFieldExpand;
+    PTNumStatMap["NumOfParallelLevels"] = Andersen::numOfParallelLevels;
+    PTNumStatMap["NumOfDeferredGeps"] = Andersen::numOfDeferredGeps;
+
+    if (!Options::AnderSnapshot().empty())
+    {
+        u64_t work = static_cast<u64_t>(Andersen::numOfProcessedAddr) + Andersen::numOfProcessedCopy +
+                     Andersen::numOfProcessedGep + Andersen::numOfProcessedLoad + Andersen::numOfProcessedStore;
+        PTNumStatMap["IncChangedFuns"] = Andersen::numOfIncChangedScopes;
+        PTNumStatMap["IncReusedPts"] = Andersen::numOfIncReusedPts;
+        PTNumStatMap["IncResetPts"] = Andersen::numOfIncResetPts;
+        // Edges not processed compared to the full solve the snapshot derives from
+        PTNumStatMap["IncSavedWork"] = Andersen::numOfIncBaselineWork > work ? Andersen::numOfIncBaselineWork - work : 0;
+        // Time of loading the snapshot and solving, against the full solve it derives from
+        timeStatMap["IncSolveTime"] = Andersen::timeOfIncSolve;
+        if (Andersen::timeOfIncBaselineSolve > 0)
+        {
+            timeStatMap["IncBaselineTime"] = Andersen::timeOfIncBaselineSolve;
+            timeStatMap["IncSavedTime"] = Andersen::timeOfIncBaselineSolve - Andersen::timeOfIncSolve;
+        }
+    }
 
     PTNumStatMap["Pointers"] = pag->getValueNodeNum();
     PTNumStatMap["MemObjects"] = pag->getObjectNodeNum();
@@ -0,0 +1,638 @@
+//===- FlowSensitiveParallel.cpp -- Multi-threaded flow-sensitive analysis----------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===--------------------------------------------------------------------------------===//
+
+/*
+ * FlowSensitiveParallel.cpp
+ *
+ * Sparse flow-sensitive analysis which solves the SVFG level by level of its
+ * SCC DAG, solving the SCCs of each level with several threads.
+ */
+
+#include "WPA/FlowSensitive.h"
+#include "Util/Options.h"
+#include "Util/WorkList.h"
+
+using namespace SVF;
+using namespace SVFUtil;
+
+/// Levels with fewer propagations per thread than this are checked sequentially,
+/// as spawning the workers would cost more than the checks themselves.
+static const u32_t MinPropsPerThread = 256;
+
+/// Levels with fewer SCCs per thread than this are solved sequentially.
+static const u32_t MinSCCsPerThread = 16;
+
+/*!
+ * Whether var has new points-to targets at src, i.e., whether propagating it
+ * from src may change anything (as checked by the incremental data-flow data
+ * before a union). Without incremental data every variable may have changed.
+ */
+static bool varHasNewPts(BVDataPTAImpl::DFPTDataTy* dfData, const SVFGNode* src, NodeID var)
+{
+    // The OUT set of a store and the IN set of any other node flow along indirect edges.
+    bool fromOut = SVFUtil::isa<StoreSVFGNode>(src);
+    if (const BVDataPTAImpl::PersIncDFPTDataTy* incData = SVFUtil::dyn_cast<BVDataPTAImpl::PersIncDFPTDataTy>(dfData))
+        return fromOut ? incData->varHasNewDFOutPts(src->getId(), var) : incData->varHasNewDFInPts(src->getId(), var);
+    if (const BVDataPTAImpl::MutIncDFPTDataTy* incData = SVFUtil::dyn_cast<BVDataPTAImpl::MutIncDFPTDataTy>(dfData))
+        return fromOut ? incData->varHasNewDFOutPts(src->getId(), var) : incData->varHasNewDFInPts(src->getId(), var);
+    return true;
+}
+
+/*!
+ * Initialize analysis. Only the persistent points-to data is updated through
+ * the thread-safe points-to cache; with the mutable one the SCCs are solved
+ * sequentially.
+ */
+void FlowSensitiveParallel::initialize()
+{
+    FlowSensitive::initialize();
+
+    parallelPtsData = SVFUtil::isa<PersDFPTDataTy>(getDFPTDataTy());
+    if (!parallelPtsData)
+        SVFUtil::writeWrnMsg("-fs-threads: the SVFG SCCs are only solved in parallel with -ptd=persistent");
+}
+
+/*!
+ * Record the representatives of the SVFG SCCs in topological order. Unlike
+ * SCCDetect, which expands every SCC into its nodes, only the representatives
+ * are kept: the members of an SCC are solved with it.
+ */
+void FlowSensitiveParallel::initWorklist()
+{
+    double start = stat->getClk();
+    getSCCDetector()->find();
+    NodeStack& topoStack = getSCCDetector()->topoNodeStack();
+    topoOrder.clear();
+    while (!topoStack.empty())
+    {
+        topoOrder.push_back(topoStack.top());
+        topoStack.pop();
+    }
+    double end = stat->getClk();
+    sccTime += (end - start) / TIMEINTERVAL;
+}
+
+/*!
+ * Solve the SCCs level by level. Every SCC is solved in each iteration (as
+ * FlowSensitive starts from all SCCs), so the nodes pushed by updateCallGraph
+ * need no special treatment.
+ */
+void FlowSensitiveParallel::solveWorklist()
+{
+    while (!isWorklistEmpty())
+        popFromWorklist();
+
+    std::vector<NodeVector> levels;
+    computeLevels(levels);
+
+    changedDsts.assign(nodeToSCC.size(), 0);
+    deferredSCCs.assign(topoOrder.size(), 0);
+    if (parallelPtsData && Options::FsThreads() > 1)
+        initParallelPtsData();
+
+    for (const NodeVector& level : levels)
+    {
+        NodeBS changedNodes;
+        solveLevel(level, changedNodes);
+
+        propagateLevel(changedNodes);
+
+        for (NodeID id : changedNodes)
+            clearAllDFOutVarFlag(svfg->getSVFGNode(id));
+    }
+}
+
+/*!
+ * Group the SCCs by their longest distance from an SCC without predecessors,
+ * so that the SCCs of a level are not connected to each other and every SCC
+ * is solved after all of its predecessors.
+ */
+void FlowSensitiveParallel::computeLevels(std::vector<NodeVector>& levels)
+{
+    nodeToSCC.resize(svfg->getTotalNodeNum());
+    for (u32_t i = 0; i < topoOrder.size(); ++i)
+    {
+        for (NodeID sub : getSCCDetector()->subNodes(topoOrder[i]))
+        {
+            if (sub >= nodeToSCC.size())
+                nodeToSCC.resize(sub + 1);
+            nodeToSCC[sub] = i;
+        }
+    }
+
+    // The predecessors of an SCC come before it in topoOrder.
+    std::vector<u32_t> sccLevels(topoOrder.size());
+    for (u32_t i = 0; i < topoOrder.size(); ++i)
+    {
+        u32_t level = 0;
+        for (NodeID sub : getSCCDetector()->subNodes(topoOrder[i]))
+        {
+            for (const SVFGEdge* edge : svfg->getSVFGNode(sub)->getInEdges())
+            {
+                u32_t srcSCC = nodeToSCC[edge->getSrcID()];
+                if (srcSCC != i)
+                    level = std::max(level, sccLevels[srcSCC] + 1);
+            }
+        }
+
+        sccLevels[i] = level;
+        if (levels.size() <= level)
+            levels.resize(level + 1);
+        levels[level].push_back(topoOrder[i]);
+    }
+}
+
+/*!
+ * Create the IN/OUT entries of every SVFG node, the points-to entry of every
+ * SVFIR node and the field list of every base object. The workers then only
+ * look up existing entries of the maps shared by all nodes, and only write the
+ * entries of their own nodes and variables.
+ */
+void FlowSensitiveParallel::initParallelPtsData()
+{
+    PersDFPTDataTy* dfData = SVFUtil::cast<PersDFPTDataTy>(getDFPTDataTy());
+    for (SVFG::iterator it = svfg->begin(), eit = svfg->end(); it != eit; ++it)
+        dfData->initDFLoc(it->first);
+
+    for (SVFIR::iterator it = pag->begin(), eit = pag->end(); it != eit; ++it)
+    {
+        dfData->initPts(it->first);
+        if (const BaseObjVar* baseObj = SVFUtil::dyn_cast<BaseObjVar>(it->second))
+            pag->getAllFieldsObjVars(baseObj);
+    }
+    numOfInitialisedPAGNodes = pag->getTotalNodeNum();
+}
+
+/*!
+ * Solve the SCCs of a level. They are not connected to each other, so each
+ * is solved by one worker, which only writes the points-to data of its nodes
+ * and of the variables they define. A gep node which has to create a field
+ * object or collapse an object would change the SVFIR read by the other
+ * workers: its SCC is solved again sequentially once the workers are done.
+ */
+void FlowSensitiveParallel::solveLevel(const NodeVector& level, NodeBS& changedNodes)
+{
+    u32_t threads = 1;
+    if (parallelPtsData)
+        threads = std::min(Options::FsThreads(), std::max<u32_t>(1, level.size() / MinSCCsPerThread));
+
+    if (sccWorklists.size() < threads)
+        sccWorklists.resize(threads);
+
+    if (threads <= 1)
+    {
+        for (NodeID rep : level)
+            solveSCC(rep, changedNodes, 0);
+        return;
+    }
+
+    double start = stat->getClk(true);
+
+    numOfParallelSCCs += level.size();
+    if (workerStats.size() < threads)
+        workerStats.resize(threads);
+    std::vector<NodeBS> threadChangedNodes(threads);
+    solvingInParallel = true;
+    WorkStealingList<NodeID>::forEach(level, threads, [&](NodeID rep, u32_t tid)
+    {
+        solveSCC(rep, threadChangedNodes[tid], tid);
+    });
+    solvingInParallel = false;
+    mergeWorkerStats();
+
+    for (const NodeBS& nodes : threadChangedNodes)
+        changedNodes |= nodes;
+
+    double end = stat->getClk(true);
+    parallelSolveTime += (end - start) / TIMEINTERVAL;
+
+    for (NodeID rep : level)
+    {
+        u8_t& deferred = deferredSCCs[nodeToSCC[rep]];
+        if (deferred)
+        {
+            deferred = 0;
+            numOfDeferredSCCs++;
+            solveSCC(rep, changedNodes, 0);
+        }
+    }
+
+    // The deferred geps may have added field objects.
+    if (pag->getTotalNodeNum() != numOfInitialisedPAGNodes)
+        initParallelPtsData();
+}
+
+/*!
+ * Solve the SCC of rep. As in FlowSensitive, every node is processed at least
+ * once per solve; the nodes which received new data from earlier levels go
+ * first. Only the edges inside the SCC are propagated here; the nodes which
+ * changed are added to changedNodes and keep their OUT flags until the
+ * propagation out of the SCC is done. A worker stops as soon as the SCC is
+ * deferred: it is solved again from all of its nodes.
+ */
+void FlowSensitiveParallel::solveSCC(NodeID rep, NodeBS& changedNodes, u32_t tid)
+{
+    FIFOWorkList<NodeID>& sccWorklist = sccWorklists[tid];
+    const u8_t& deferred = deferredSCCs[nodeToSCC[rep]];
+    const NodeBS& members = getSCCDetector()->subNodes(rep);
+    for (NodeID id : members)
+    {
+        if (changedDsts[id])
+            sccWorklist.push(id);
+    }
+    for (NodeID id : members)
+        sccWorklist.push(id);
+
+    while (!sccWorklist.empty())
+    {
+        NodeID id = sccWorklist.pop();
+        SVFGNode* node = svfg->getSVFGNode(id);
+        bool changed = solvingInParallel ? processNodeInWorker(node, workerStats[tid]) : processSVFGNode(node);
+        if (!changed)
+        {
+            if (deferred)
+            {
+                sccWorklist.clear();
+                break;
+            }
+            continue;
+        }
+
+        bool leavesSCC = false;
+        for (SVFGEdge* edge : node->getOutEdges())
+        {
+            if (!inSameSCC(id, edge->getDstID()))
+                leavesSCC = true;
+            else if (solvingInParallel ? propInWorker(edge) : propFromSrcToDst(edge))
+                sccWorklist.push(edge->getDstID());
+        }
+
+        if (leavesSCC)
+            changedNodes.set(id);
+        else
+            clearAllDFOutVarFlag(node);
+    }
+}
+
+/*!
+ * Process a node in a worker. The transfer functions are those of
+ * FlowSensitive, but the statistics they write are shared by all workers:
+ * the node counts and strong updates go to the worker's own WorkerStat.
+ */
+bool FlowSensitiveParallel::processNodeInWorker(SVFGNode* node, WorkerStat& ws)
+{
+    if (AddrSVFGNode* addr = SVFUtil::dyn_cast<AddrSVFGNode>(node))
+    {
+        ws.numOfProcessedAddr++;
+        NodeID srcID = addr->getPAGSrcNodeID();
+        if (isFieldInsensitive(srcID))
+            srcID = getFIObjVar(srcID);
+        return addPts(addr->getPAGDstNodeID(), srcID);
+    }
+    else if (CopySVFGNode* copy = SVFUtil::dyn_cast<CopySVFGNode>(node))
+    {
+        ws.numOfProcessedCopy++;
+        return unionPts(copy->getPAGDstNodeID(), copy->getPAGSrcNodeID());
+    }
+    else if (GepSVFGNode* gep = SVFUtil::dyn_cast<GepSVFGNode>(node))
+    {
+        ws.numOfProcessedGep++;
+        return processGepInWorker(gep);
+    }
+    else if (LoadSVFGNode* load = SVFUtil::dyn_cast<LoadSVFGNode>(node))
+    {
+        ws.numOfProcessedLoad++;
+        return processLoadInWorker(load);
+    }
+    else if (StoreSVFGNode* store = SVFUtil::dyn_cast<StoreSVFGNode>(node))
+    {
+        ws.numOfProcessedStore++;
+        return processStoreInWorker(store, ws);
+    }
+    else if (PHISVFGNode* phi = SVFUtil::dyn_cast<PHISVFGNode>(node))
+    {
+        ws.numOfProcessedPhi++;
+        bool changed = false;
+        NodeID pagDst = phi->getRes()->getId();
+        for (PHISVFGNode::OPVers::const_iterator it = phi->opVerBegin(), eit = phi->opVerEnd(); it != eit; ++it)
+        {
+            if (unionPts(pagDst, getPts(it->second->getId())))
+                changed = true;
+        }
+        return changed;
+    }
+    else if (SVFUtil::isa<MSSAPHISVFGNode, FormalINSVFGNode,
+             FormalOUTSVFGNode, ActualINSVFGNode,
+             ActualOUTSVFGNode>(node))
+    {
+        ws.numOfProcessedMSSANode++;
+        return true;
+    }
+    else if (SVFUtil::isa<ActualParmSVFGNode, FormalParmSVFGNode,
+             ActualRetSVFGNode, FormalRetSVFGNode,
+             NullPtrSVFGNode>(node))
+    {
+        return true;
+    }
+    else if (SVFUtil::isa<CmpVFGNode, BinaryOPVFGNode>(node) ||
+             SVFUtil::dyn_cast<UnaryOPVFGNode>(node))
+    {
+        return false;
+    }
+
+    assert(false && "unexpected kind of SVFG nodes");
+    return false;
+}
+
+/*!
+ * Process a gep node in a worker. The field objects the gep needs must exist
+ * and the objects it collapses must be field-insensitive already: otherwise
+ * the gep would change the SVFIR read by the other workers, so the SCC of the
+ * gep is deferred and the gep changes nothing.
+ */
+bool FlowSensitiveParallel::processGepInWorker(const GepSVFGNode* edge)
+{
+    PointsTo tmpDstPts;
+    const GepStmt* gepStmt = SVFUtil::cast<GepStmt>(edge->getPAGEdge());
+    for (NodeID o : getPts(edge->getPAGSrcNodeID()))
+    {
+        if (isBlkObjOrConstantObj(o))
+        {
+            tmpDstPts.set(o);
+            continue;
+        }
+
+        if (isFieldInsensitive(o))
+        {
+            tmpDstPts.set(gepStmt->isVariantFieldGep() ? getFIObjVar(o) : o);
+            continue;
+        }
+
+        NodeID fieldObj;
+        if (gepStmt->isVariantFieldGep()
+                || !pag->findGepObjVar(o, gepStmt->getAccessPath().getConstantStructFldIdx(), fieldObj))
+        {
+            deferredSCCs[nodeToSCC[edge->getId()]] = 1;
+            return false;
+        }
+        tmpDstPts.set(fieldObj);
+    }
+
+    return unionPts(edge->getPAGDstNodeID(), tmpDstPts);
+}
+
+/*!
+ * Process a load node in a worker (see FlowSensitive::processLoad).
+ */
+bool FlowSensitiveParallel::processLoadInWorker(const LoadSVFGNode* load)
+{
+    // p = *q, the type of p must be a pointer
+    if (!load->getPAGDstNode()->isPointer())
+        return false;
+
+    bool changed = false;
+    NodeID dstVar = load->getPAGDstNodeID();
+    for (NodeID ptd : getPts(load->getPAGSrcNodeID()))
+    {
+        if (pag->isConstantObj(ptd))
+            continue;
+
+        if (unionPtsFromIn(load, ptd, dstVar))
+            changed = true;
+
+        if (isFieldInsensitive(ptd))
+        {
+            for (NodeID field : getAllFieldsObjVars(ptd))
+            {
+                if (unionPtsFromIn(load, field, dstVar))
+                    changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+/*!
+ * Process a store node in a worker (see FlowSensitive::processStore). Whether
+ * the store is a strong update is recorded in ws and added to svfgHasSU once
+ * the workers are done.
+ */
+bool FlowSensitiveParallel::processStoreInWorker(const StoreSVFGNode* store, WorkerStat& ws)
+{
+    const PointsTo& dstPts = getPts(store->getPAGDstNodeID());
+    if (dstPts.empty())
+        return false;
+
+    bool changed = false;
+    // *p = q, the type of q must be a pointer
+    if (getPts(store->getPAGSrcNodeID()).empty() == false && store->getPAGSrcNode()->isPointer())
+    {
+        for (NodeID ptd : dstPts)
+        {
+            if (pag->isConstantObj(ptd))
+                continue;
+
+            if (unionPtsFromTop(store, store->getPAGSrcNodeID(), ptd))
+                changed = true;
+        }
+    }
+
+    NodeID singleton;
+    if (isStrongUpdate(store, singleton))
+    {
+        ws.strongUpdates.set(store->getId());
+        ws.weakUpdates.reset(store->getId());
+        if (strongUpdateOutFromIn(store, singleton))
+            changed = true;
+    }
+    else
+    {
+        ws.weakUpdates.set(store->getId());
+        ws.strongUpdates.reset(store->getId());
+        if (weakUpdateOutFromIn(store))
+            changed = true;
+    }
+    return changed;
+}
+
+/*!
+ * Propagate along an edge in a worker (see FlowSensitive::propFromSrcToDst).
+ */
+bool FlowSensitiveParallel::propInWorker(const SVFGEdge* edge)
+{
+    const SVFGNode* src = edge->getSrcNode();
+    const SVFGNode* dst = edge->getDstNode();
+    if (SVFUtil::isa<DirectSVFGEdge>(edge))
+    {
+        if (const ActualParmSVFGNode* ap = SVFUtil::dyn_cast<ActualParmSVFGNode>(src))
+            return propagateFromAPToFP(ap, dst);
+        if (const FormalRetSVFGNode* fr = SVFUtil::dyn_cast<FormalRetSVFGNode>(src))
+            return propagateFromFRToAR(fr, dst);
+        return true;
+    }
+
+    bool changed = false;
+    for (NodeID ptd : SVFUtil::cast<IndirectSVFGEdge>(edge)->getPointsTo())
+    {
+        if (propVarPtsFromSrcToDst(ptd, src, dst))
+            changed = true;
+
+        if (isFieldInsensitive(ptd))
+        {
+            for (NodeID field : getAllFieldsObjVars(ptd))
+            {
+                if (propVarPtsFromSrcToDst(field, src, dst))
+                    changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+/*!
+ * Add the node counts and strong updates of the workers to those of
+ * FlowSensitive. A store is solved by a single worker, so its last state is
+ * the one recorded by that worker.
+ */
+void FlowSensitiveParallel::mergeWorkerStats()
+{
+    for (WorkerStat& ws : workerStats)
+    {
+        numOfProcessedAddr += ws.numOfProcessedAddr;
+        numOfProcessedCopy += ws.numOfProcessedCopy;
+        numOfProcessedGep += ws.numOfProcessedGep;
+        numOfProcessedPhi += ws.numOfProcessedPhi;
+        numOfProcessedLoad += ws.numOfProcessedLoad;
+        numOfProcessedStore += ws.numOfProcessedStore;
+        numOfProcessedMSSANode += ws.numOfProcessedMSSANode;
+        svfgHasSU |= ws.strongUpdates;
+        svfgHasSU.intersectWithComplement(ws.weakUpdates);
+        ws = WorkerStat();
+    }
+}
+
+/*!
+ * Propagate along the edges leaving the SCCs of a level. The destinations are
+ * in later levels, so the points-to data read by the workers is not written
+ * until all checks are done: a propagation is applied (sequentially) only if
+ * the worker found that it can add a target to its destination.
+ */
+void FlowSensitiveParallel::propagateLevel(const NodeBS& changedNodes)
+{
+    DFPTDataTy* dfData = getDFPTDataTy();
+    std::vector<SVFGEdge*> directEdges;
+    std::vector<IndirectProp> props;
+    for (NodeID id : changedNodes)
+    {
+        for (SVFGEdge* edge : svfg->getSVFGNode(id)->getOutEdges())
+        {
+            if (inSameSCC(id, edge->getDstID()))
+                continue;
+
+            const IndirectSVFGEdge* indEdge = SVFUtil::dyn_cast<IndirectSVFGEdge>(edge);
+            if (indEdge == nullptr)
+            {
+                directEdges.push_back(edge);
+                continue;
+            }
+            // The updated-var flags are filtered here rather than by the workers,
+            // as bit vector lookups may move the cursor cached by the vector.
+            const SVFGNode* src = indEdge->getSrcNode();
+            for (NodeID ptd : indEdge->getPointsTo())
+            {
+                if (varHasNewPts(dfData, src, ptd))
+                    props.push_back(std::make_pair(indEdge, ptd));
+                if (isFieldInsensitive(ptd))
+                {
+                    for (NodeID field : getAllFieldsObjVars(ptd))
+                    {
+                        if (varHasNewPts(dfData, src, field))
+                            props.push_back(std::make_pair(indEdge, field));
+                    }
+                }
+            }
+        }
+    }
+
+    // The destinations which changed are processed first when their SCC is solved.
+    for (SVFGEdge* edge : directEdges)
+    {
+        if (propFromSrcToDst(edge))
+            changedDsts[edge->getDstID()] = 1;
+    }
+
+    double start = stat->getClk(true);
+
+    u32_t threads = std::min(Options::FsThreads(), std::max<u32_t>(1, props.size() / MinPropsPerThread));
+    if (threads > 1)
+        numOfParallelLevels++;
+
+    // Each worker only writes the flags of the propagations it pops.
+    std::vector<u8_t> mayChange(props.size());
+    std::vector<u32_t> indices(props.size());
+    for (u32_t i = 0; i < props.size(); ++i)
+        indices[i] = i;
+    WorkStealingList<u32_t>::forEach(indices, threads, [&](u32_t i, u32_t)
+    {
+        mayChange[i] = mayAddPts(props[i]);
+    });
+
+    double end = stat->getClk(true);
+    parallelPropaTime += (end - start) / TIMEINTERVAL;
+
+    for (u32_t i = 0; i < props.size(); ++i)
+    {
+        if (!mayChange[i])
+        {
+            numOfSkippedProps++;
+            continue;
+        }
+        const IndirectSVFGEdge* edge = props[i].first;
+        if (propVarPtsFromSrcToDst(props[i].second, edge->getSrcNode(), edge->getDstNode()))
+            changedDsts[edge->getDstID()] = 1;
+    }
+}
+
+/*!
+ * Whether propagating var along the edge of prop can add a target to the IN
+ * set of its destination. This runs in a worker thread: it must only read the
+ * points-to data.
+ */
+bool FlowSensitiveParallel::mayAddPts(const IndirectProp& prop)
+{
+    const IndirectSVFGEdge* edge = prop.first;
+    NodeID var = prop.second;
+    NodeID src = edge->getSrcID();
+    NodeID dst = edge->getDstID();
+    DFPTDataTy* dfData = getDFPTDataTy();
+
+    // The OUT set of a store and the IN set of any other node flow along indirect edges.
+    bool fromOut = SVFUtil::isa<StoreSVFGNode>(edge->getSrcNode());
+    if (fromOut ? !dfData->hasDFOutSet(src, var) : !dfData->hasDFInSet(src, var))
+        return false;
+    if (!dfData->hasDFInSet(dst, var))
+        return true;
+
+    // Both sets exist, so the getters only look them up.
+    const PointsTo& srcPts = fromOut ? dfData->getDFOutPtsSet(src, var) : dfData->getDFInPtsSet(src, var);
+    return !dfData->getDFInPtsSet(dst, var).contains(srcPts);
+}
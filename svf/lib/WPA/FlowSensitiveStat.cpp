@@ -153,6 +153,8 @@ void FlowSensitiveStat::performStat()
     timeStatMap["StoreTime"] = fspta->storeTime;
     timeStatMap["UpdateCGTime"] = fspta->updateCallGraphTime;
     timeStatMap["PhiTime"] = fspta->phiTime;
+    timeStatMap["ParallelPropaTime"] = fspta->parallelPropaTime;
+    timeStatMap["ParallelSolveTime"] = fspta->parallelSolveTime;
 
     PTNumStatMap["TotalPointers"] = pag->getValueNodeNum() + pag->getFieldValNodeNum();
     PTNumStatMap["TotalObjects"] = pag->getObjectNodeNum() + pag->getFieldObjNodeNum();
@@ -166,6 +168,11 @@ void FlowSensitiveStat::performStat()
     PTNumStatMap["StoresNum"] = numOfStore;
 
     PTNumStatMap["SolveIterations"] = fspta->numOfIteration;
+    PTNumStatMap["Threads"] = Options::FsThreads();
+    PTNumStatMap["ParallelLevels"] = fspta->numOfParallelLevels;
+    PTNumStatMap["SkippedProps"] = fspta->numOfSkippedProps;
+    PTNumStatMap["ParallelSCCs"] = fspta->numOfParallelSCCs;
+    PTNumStatMap["DeferredSCCs"] = fspta->numOfDeferredSCCs;
 
     PTNumStatMap["IndEdgeSolved"] = fspta->getNumOfResolvedIndCallEdge();
 
@@ -11,10 +11,10 @@
 #include "WPA/VersionedFlowSensitive.h"
 #include "Util/Options.h"
 #include "MemoryModel/PointsTo.h"
+#include "Util/WorkList.h"
 #include <iostream>
-#include <queue>
-#include <thread>
 #include <mutex>
+#include <time.h>
 
 using namespace SVF;
 
@@ -31,8 +31,12 @@ VersionedFlowSensitive::VersionedFlowSensitive(SVFIR *_pag, PTATY type)
     : FlowSensitive(_pag, type)
 {
     numPrelabeledNodes = numPrelabelVersions = 0;
-    prelabelingTime = meldLabelingTime = versionPropTime = 0.0;
+    prelabelingTime = meldLabelingTime = versionPropTime = objectRoundTime = 0.0;
+    numOfVersionPropRounds = 0;
     // We'll grab vPtD in initialize.
+    vPtD = nullptr;
+    persVPtD = nullptr;
+    versionPropThreads = 1;
 
     for (SVFIR::const_iterator it = pag->begin(); it != pag->end(); ++it)
     {
@@ -50,6 +54,10 @@ void VersionedFlowSensitive::initialize()
     stat = new VersionedFlowSensitiveStat(this);
 
     vPtD = getVersionedPTDataTy();
+    // Workers propagate versions through the IDs of persistent points-to sets.
+    persVPtD = SVFUtil::dyn_cast<BVDataPTAImpl::PersVersionedPTDataTy>(vPtD);
+    versionPropThreads = persVPtD != nullptr ? Options::VfsThreads() : 1;
+    assert(versionPropThreads > 0 && "VFS::initialize: number of version propagation threads must be > 0!");
 
     buildIsStoreLoadMaps();
     buildDeltaMaps();
@@ -117,11 +125,28 @@ void VersionedFlowSensitive::prelabel(void)
     prelabelingTime = (end - start) / TIMEINTERVAL;
 }
 
+/// CPU time used by the calling thread, in seconds.
+static double threadCPUTime(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1000000000.0;
+}
+
+/// Wall time, in seconds.
+static double wallTime(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec / 1000000000.0;
+}
+
 void VersionedFlowSensitive::meldLabel(void)
 {
     double start = stat->getClk(true);
 
-    assert(Options::VersioningThreads() > 0 && "VFS::meldLabel: number of versioning threads must be > 0!");
+    const u32_t threads = Options::VersioningThreads();
+    assert(threads > 0 && "VFS::meldLabel: number of versioning threads must be > 0!");
 
     // Nodes which have at least one object on them given a prelabel + the Andersen's points-to
     // set of interest so we don't keep calling getPts. For Store nodes, we'll fill that in, for
@@ -150,160 +175,168 @@ void VersionedFlowSensitive::meldLabel(void)
 
     // Delta, delta source, store, and load nodes, which require versions during
     // solving, unlike other nodes with which we can make do with the reliance map.
-    std::vector<NodeID> nodesWhichNeedVersions;
+    std::vector<bool> needsVersion(svfg->getTotalNodeNum(), false);
     for (SVFG::const_iterator it = svfg->begin(); it != svfg->end(); ++it)
     {
         const NodeID n = it->first;
-        if (delta(n) || deltaSource(n) || isStore(n) || isLoad(n)) nodesWhichNeedVersions.push_back(n);
+        if (delta(n) || deltaSource(n) || isStore(n) || isLoad(n)) needsVersion[n] = true;
     }
 
-    std::mutex *versionMutexes = new std::mutex[nodesWhichNeedVersions.size()];
-
-    // Map of footprints to the canonical object "owning" the footprint.
-    Map<std::vector<const IndirectSVFGEdge *>, NodeID> footprintOwner;
-
-    std::queue<NodeID> objectQueue;
-    for (const NodeID o : prelabeledObjects)
+    // Objects are handed out to the threads through a work stealing list, sorted
+    // so that each thread starts on its own range of objects.
+    std::vector<NodeID> objects(prelabeledObjects.begin(), prelabeledObjects.end());
+    std::sort(objects.begin(), objects.end());
+    for (const NodeID o : objects)
     {
         // "Touch" maps with o so we don't need to lock on them.
         versionReliance[o];
         stmtReliance[o];
-        objectQueue.push(o);
     }
 
-    std::mutex objectQueueMutex;
-    std::mutex footprintOwnerMutex;
+    // Map of footprints to the canonical object "owning" the footprint, split
+    // into shards by the hash of the footprint, each with its own lock.
+    typedef Map<std::vector<const IndirectSVFGEdge *>, NodeID> FootprintOwnerMap;
+    struct alignas(64) FootprintShard
+    {
+        std::mutex lock;
+        FootprintOwnerMap owner;
+    };
+    static const u32_t numOfFootprintShards = 64;
+    std::unique_ptr<FootprintShard[]> footprintShards(new FootprintShard[numOfFootprintShards]);
 
-    auto meldVersionWorker = [this, &footprintOwner, &objectQueue,
-                                    &objectQueueMutex, &footprintOwnerMutex, &versionMutexes,
-                                    &prelabeledNodes, &isPrelabeled, &nodesWhichNeedVersions]
-         (const unsigned thread)
+    // Versions found by each thread, bucketed by location so that each bucket
+    // can be moved into consume/yield by one thread without locking.
+    struct LocVersion
     {
-        while (true)
+        NodeID l;
+        NodeID o;
+        Version v;
+    };
+    typedef std::vector<std::vector<LocVersion>> LocVersionBuckets;
+    std::vector<LocVersionBuckets> consumed(threads, LocVersionBuckets(threads));
+    std::vector<LocVersionBuckets> yielded(threads, LocVersionBuckets(threads));
+    // Objects whose footprint was owned by another (canonical) object, found by each thread.
+    std::vector<std::vector<std::pair<NodeID, NodeID>>> equivalents(threads);
+    std::vector<double> busyTime(threads, 0.0);
+
+    auto meldVersionObject = [this, &footprintShards, &consumed, &yielded, &equivalents, &busyTime,
+                                    &prelabeledNodes, &isPrelabeled, &needsVersion, threads]
+         (const NodeID o, const u32_t thread)
+    {
+        double busyStart = threadCPUTime();
+
+        // 1. Compute the SCCs for the nodes on the graph overlay of o.
+        // For starting nodes, we only need those which did prelabeling for o specifically.
+        // TODO: maybe we should move this to prelabel with a map (o -> starting nodes).
+        std::vector<const SVFGNode *> osStartingNodes;
+        for (std::pair<const SVFGNode *, const PointsTo *> snPts : prelabeledNodes)
         {
-            NodeID o;
+            const SVFGNode *sn = snPts.first;
+            const PointsTo *pts = snPts.second;
+            if (pts != nullptr)
             {
-                std::lock_guard<std::mutex> guard(objectQueueMutex);
-                // No more objects? Done.
-                if (objectQueue.empty()) return;
-                o = objectQueue.front();
-                objectQueue.pop();
+                if (pts->test(o)) osStartingNodes.push_back(sn);
             }
-
-            // 1. Compute the SCCs for the nodes on the graph overlay of o.
-            // For starting nodes, we only need those which did prelabeling for o specifically.
-            // TODO: maybe we should move this to prelabel with a map (o -> starting nodes).
-            std::vector<const SVFGNode *> osStartingNodes;
-            for (std::pair<const SVFGNode *, const PointsTo *> snPts : prelabeledNodes)
+            else if (const MRSVFGNode *mr = SVFUtil::dyn_cast<MRSVFGNode>(sn))
             {
-                const SVFGNode *sn = snPts.first;
-                const PointsTo *pts = snPts.second;
-                if (pts != nullptr)
-                {
-                    if (pts->test(o)) osStartingNodes.push_back(sn);
-                }
-                else if (const MRSVFGNode *mr = SVFUtil::dyn_cast<MRSVFGNode>(sn))
-                {
-                    if (mr->getPointsTo().test(o)) osStartingNodes.push_back(sn);
-                }
-                else
-                {
-                    assert(false && "VFS::meldLabel: unexpected prelabeled node!");
-                }
+                if (mr->getPointsTo().test(o)) osStartingNodes.push_back(sn);
             }
-
-            std::vector<int> partOf;
-            std::vector<const IndirectSVFGEdge *> footprint;
-            unsigned numSCCs = SCC::detectSCCs(this, this->svfg, o, osStartingNodes, partOf, footprint);
-
-            // 2. Skip any further processing of a footprint we have seen before.
+            else
             {
-                std::lock_guard<std::mutex> guard(footprintOwnerMutex);
-                const Map<std::vector<const IndirectSVFGEdge *>, NodeID>::const_iterator canonOwner
-                    = footprintOwner.find(footprint);
-                if (canonOwner == footprintOwner.end())
-                {
-                    this->equivalentObject[o] = o;
-                    footprintOwner[footprint] = o;
-                }
-                else
-                {
-                    this->equivalentObject[o] = canonOwner->second;
-                    // Same version and stmt reliance as the canonical. During solving we cannot just reuse
-                    // the canonical object's reliance because it may change due to on-the-fly call graph
-                    // construction. Something like copy-on-write could be good... probably negligible.
-                    this->versionReliance.at(o) = this->versionReliance.at(canonOwner->second);
-                    this->stmtReliance.at(o) = this->stmtReliance.at(canonOwner->second);
-                    continue;
-                }
+                assert(false && "VFS::meldLabel: unexpected prelabeled node!");
             }
+        }
 
-            // 3. a. Initialise the MeldVersion of prelabeled nodes (SCCs).
-            //    b. Initialise a todo list of all the nodes we need to version,
-            //       sorted according to topological order.
-            // We will use a map of sccs to meld versions for what is consumed.
-            std::vector<MeldVersion> sccToMeldVersion(numSCCs);
-            // At stores, what is consumed is different to what is yielded, so we
-            // maintain that separately.
-            Map<NodeID, MeldVersion> storesYieldedMeldVersion;
-            // SVFG nodes of interest -- those part of an SCC from the starting nodes.
-            std::vector<NodeID> todoList;
-            unsigned bit = 0;
-            // To calculate reachable nodes, we can see what nodes n exist where
-            // partOf[n] != -1. Since the SVFG can be large this can be expensive.
-            // Instead, we can gather this from the edges in the footprint and
-            // the starting nodes (incase such nodes have no edges).
-            // TODO: should be able to do this better: too many redundant inserts.
-            Set<NodeID> reachableNodes;
-            for (const SVFGNode *sn : osStartingNodes) reachableNodes.insert(sn->getId());
-            for (const SVFGEdge *se : footprint)
+        std::vector<int> partOf;
+        std::vector<const IndirectSVFGEdge *> footprint;
+        unsigned numSCCs = SCC::detectSCCs(this, this->svfg, o, osStartingNodes, partOf, footprint);
+
+        // 2. Skip any further processing of a footprint we have seen before.
+        //    The reliances of o are copied from its canonical object once all
+        //    objects are versioned.
+        {
+            FootprintShard &shard = footprintShards[FootprintOwnerMap::hasher()(footprint) % numOfFootprintShards];
+            std::lock_guard<std::mutex> guard(shard.lock);
+            const FootprintOwnerMap::const_iterator canonOwner = shard.owner.find(footprint);
+            if (canonOwner != shard.owner.end())
             {
-                reachableNodes.insert(se->getSrcNode()->getId());
-                reachableNodes.insert(se->getDstNode()->getId());
+                equivalents[thread].push_back(std::make_pair(o, canonOwner->second));
+                busyTime[thread] += threadCPUTime() - busyStart;
+                return;
             }
 
-            for (const NodeID n : reachableNodes)
-            {
-                if (isPrelabeled[n])
-                {
-                    if (this->isStore(n)) storesYieldedMeldVersion[n].set(bit);
-                    else sccToMeldVersion[partOf[n]].set(bit);
-                    ++bit;
-                }
+            shard.owner[footprint] = o;
+        }
 
-                todoList.push_back(n);
-            }
+        // 3. a. Initialise the MeldVersion of prelabeled nodes (SCCs).
+        //    b. Initialise a todo list of all the nodes we need to version,
+        //       sorted according to topological order.
+        // We will use a map of sccs to meld versions for what is consumed.
+        std::vector<MeldVersion> sccToMeldVersion(numSCCs);
+        // At stores, what is consumed is different to what is yielded, so we
+        // maintain that separately.
+        Map<NodeID, MeldVersion> storesYieldedMeldVersion;
+        // SVFG nodes of interest -- those part of an SCC from the starting nodes.
+        std::vector<NodeID> todoList;
+        unsigned bit = 0;
+        // To calculate reachable nodes, we can see what nodes n exist where
+        // partOf[n] != -1. Since the SVFG can be large this can be expensive.
+        // Instead, we can gather this from the edges in the footprint and
+        // the starting nodes (incase such nodes have no edges).
+        // TODO: should be able to do this better: too many redundant inserts.
+        Set<NodeID> reachableNodes;
+        for (const SVFGNode *sn : osStartingNodes) reachableNodes.insert(sn->getId());
+        for (const SVFGEdge *se : footprint)
+        {
+            reachableNodes.insert(se->getSrcNode()->getId());
+            reachableNodes.insert(se->getDstNode()->getId());
+        }
 
-            // Sort topologically so each nodes is only visited once.
-            auto cmp = [&partOf](const NodeID a, const NodeID b)
+        for (const NodeID n : reachableNodes)
+        {
+            if (isPrelabeled[n])
             {
-                return partOf[a] > partOf[b];
-            };
-            std::sort(todoList.begin(), todoList.end(), cmp);
-
-            // 4. a. Do meld versioning.
-            //    b. Determine SCC reliances.
-            //    c. Build a footprint for o (all edges which it is found on).
-            //    d. Determine which SCCs belong to stores.
-
-            // sccReliance[x] = { y_1, y_2, ... } if there exists an edge from a node
-            // in SCC x to SCC y_i.
-            std::vector<Set<int>> sccReliance(numSCCs);
-            // Maps SCC to the store it corresponds to or -1 if it doesn't. TODO: unsigned vs signed -- nasty.
-            std::vector<int> storeSCC(numSCCs, -1);
-            for (size_t i = 0; i < todoList.size(); ++i)
+                if (this->isStore(n)) storesYieldedMeldVersion[n].set(bit);
+                else sccToMeldVersion[partOf[n]].set(bit);
+                ++bit;
+            }
+
+            todoList.push_back(n);
+        }
+
+        // Sort topologically so each nodes is only visited once.
+        auto cmp = [&partOf](const NodeID a, const NodeID b)
+        {
+            return partOf[a] > partOf[b];
+        };
+        std::sort(todoList.begin(), todoList.end(), cmp);
+
+        // 4. a. Do meld versioning.
+        //    b. Determine SCC reliances.
+        //    c. Build a footprint for o (all edges which it is found on).
+        //    d. Determine which SCCs belong to stores.
+
+        // sccReliance[x] = { y_1, y_2, ... } if there exists an edge from a node
+        // in SCC x to SCC y_i.
+        std::vector<Set<int>> sccReliance(numSCCs);
+        // Maps SCC to the store it corresponds to or -1 if it doesn't. TODO: unsigned vs signed -- nasty.
+        std::vector<int> storeSCC(numSCCs, -1);
+        // SCCs which the yielded version of the current SCC is melded into.
+        std::vector<int> meldTargets;
+        for (size_t i = 0; i < todoList.size();)
+        {
+            // The nodes of an SCC are next to each other in todoList. Every node
+            // of an SCC yields the same meld version (a store is an SCC of its
+            // own), so it is melded into each target SCC once.
+            const int nSCC = partOf[todoList[i]];
+            meldTargets.clear();
+            for (; i < todoList.size() && partOf[todoList[i]] == nSCC; ++i)
             {
                 const NodeID n = todoList[i];
                 const SVFGNode *sn = this->svfg->getSVFGNode(n);
                 const bool nIsStore = this->isStore(n);
-
-                int nSCC = partOf[n];
                 if (nIsStore) storeSCC[nSCC] = n;
 
-                // Given n -> m, the yielded version of n will be melded into m.
-                // For stores, that is in storesYieldedMeldVersion, otherwise, consume == yield and
-                // we can just use sccToMeldVersion.
-                const MeldVersion &nMV = nIsStore ? storesYieldedMeldVersion[n] : sccToMeldVersion[nSCC];
                 for (const SVFGEdge *e : sn->getOutEdges())
                 {
                     const IndirectSVFGEdge *ie = SVFUtil::dyn_cast<IndirectSVFGEdge>(e);
@@ -323,101 +356,143 @@ void VersionedFlowSensitive::meldLabel(void)
                     // except when it is a store, because we are actually propagating n's yielded
                     // into m's consumed. Store nodes are in their own SCCs, so it is a self
                     // loop on a store node.
-                    if (!this->delta(m) && (nSCC != mSCC || nIsStore))
-                    {
-                        sccToMeldVersion[mSCC] |= nMV;
-                    }
+                    if (!this->delta(m) && (nSCC != mSCC || nIsStore)) meldTargets.push_back(mSCC);
                 }
             }
 
-            // 5. Transform meld versions belonging to SCCs into versions.
-            Map<MeldVersion, Version> mvv;
-            std::vector<Version> sccToVersion(numSCCs, invalidVersion);
-            Version curVersion = 0;
-            for (u32_t scc = 0; scc < sccToMeldVersion.size(); ++scc)
-            {
-                const MeldVersion &mv = sccToMeldVersion[scc];
-                Map<MeldVersion, Version>::const_iterator foundVersion = mvv.find(mv);
-                Version v = foundVersion == mvv.end() ? mvv[mv] = ++curVersion : foundVersion->second;
-                sccToVersion[scc] = v;
-            }
+            std::sort(meldTargets.begin(), meldTargets.end());
+            meldTargets.erase(std::unique(meldTargets.begin(), meldTargets.end()), meldTargets.end());
 
-            sccToMeldVersion.clear();
+            // For stores, the yielded version is in storesYieldedMeldVersion, otherwise,
+            // consume == yield and we can just use sccToMeldVersion.
+            const MeldVersion &nMV = storeSCC[nSCC] != -1 ? storesYieldedMeldVersion[storeSCC[nSCC]]
+                                     : sccToMeldVersion[nSCC];
+            for (const int mSCC : meldTargets) meld(sccToMeldVersion[mSCC], nMV);
+        }
 
-            // Same for storesYieldedMeldVersion.
-            Map<NodeID, Version> storesYieldedVersion;
-            for (auto const& nmv : storesYieldedMeldVersion)
-            {
-                const NodeID n = nmv.first;
-                const MeldVersion &mv = nmv.second;
+        // 5. Transform meld versions belonging to SCCs into versions.
+        Map<MeldVersion, Version> mvv;
+        std::vector<Version> sccToVersion(numSCCs, invalidVersion);
+        Version curVersion = 0;
+        for (u32_t scc = 0; scc < sccToMeldVersion.size(); ++scc)
+        {
+            const MeldVersion &mv = sccToMeldVersion[scc];
+            Map<MeldVersion, Version>::const_iterator foundVersion = mvv.find(mv);
+            Version v = foundVersion == mvv.end() ? mvv[mv] = ++curVersion : foundVersion->second;
+            sccToVersion[scc] = v;
+        }
 
-                Map<MeldVersion, Version>::const_iterator foundVersion = mvv.find(mv);
-                Version v = foundVersion == mvv.end() ? mvv[mv] = ++curVersion : foundVersion->second;
-                storesYieldedVersion[n] = v;
-            }
+        sccToMeldVersion.clear();
 
-            storesYieldedMeldVersion.clear();
+        // Same for storesYieldedMeldVersion.
+        Map<NodeID, Version> storesYieldedVersion;
+        for (auto const& nmv : storesYieldedMeldVersion)
+        {
+            const NodeID n = nmv.first;
+            const MeldVersion &mv = nmv.second;
 
-            mvv.clear();
+            Map<MeldVersion, Version>::const_iterator foundVersion = mvv.find(mv);
+            Version v = foundVersion == mvv.end() ? mvv[mv] = ++curVersion : foundVersion->second;
+            storesYieldedVersion[n] = v;
+        }
 
-            // 6. From SCC reliance, determine version reliances.
-            Map<Version, std::vector<Version>> &osVersionReliance = this->versionReliance.at(o);
-            for (u32_t scc = 0; scc < numSCCs; ++scc)
-            {
-                if (sccReliance[scc].empty()) continue;
+        storesYieldedMeldVersion.clear();
 
-                // Some consume relies on a yield. When it's a store, we need to pick whether to
-                // use the consume or yield unlike when it is not because they are the same.
-                const Version version
-                    = storeSCC[scc] != -1 ? storesYieldedVersion[storeSCC[scc]] : sccToVersion[scc];
+        mvv.clear();
 
-                std::vector<Version> &reliantVersions = osVersionReliance[version];
-                for (const int reliantSCC : sccReliance[scc])
+        // 6. From SCC reliance, determine version reliances.
+        Map<Version, std::vector<Version>> &osVersionReliance = this->versionReliance.at(o);
+        for (u32_t scc = 0; scc < numSCCs; ++scc)
+        {
+            if (sccReliance[scc].empty()) continue;
+
+            // Some consume relies on a yield. When it's a store, we need to pick whether to
+            // use the consume or yield unlike when it is not because they are the same.
+            const Version version
+                = storeSCC[scc] != -1 ? storesYieldedVersion[storeSCC[scc]] : sccToVersion[scc];
+
+            std::vector<Version> &reliantVersions = osVersionReliance[version];
+            for (const int reliantSCC : sccReliance[scc])
+            {
+                const Version reliantVersion = sccToVersion[reliantSCC];
+                if (version != reliantVersion)
                 {
-                    const Version reliantVersion = sccToVersion[reliantSCC];
-                    if (version != reliantVersion)
-                    {
-                        // sccReliance is a set, no need to worry about duplicates.
-                        reliantVersions.push_back(reliantVersion);
-                    }
+                    // sccReliance is a set, no need to worry about duplicates.
+                    reliantVersions.push_back(reliantVersion);
                 }
             }
+        }
 
-            // 7. a. Save versions for nodes which need them.
-            //    b. Fill in stmtReliance.
-            // TODO: maybe randomize iteration order for less contention? Needs profiling.
-            Map<Version, NodeBS> &osStmtReliance = this->stmtReliance.at(o);
-            for (size_t i = 0; i < nodesWhichNeedVersions.size(); ++i)
-            {
-                const NodeID n = nodesWhichNeedVersions[i];
-                std::mutex &mutex = versionMutexes[i];
-
-                const int scc = partOf[n];
-                if (scc == -1) continue;
+        // 7. a. Save versions for nodes which need them (only nodes in an SCC
+        //       of o can have a version of o).
+        //    b. Fill in stmtReliance.
+        Map<Version, NodeBS> &osStmtReliance = this->stmtReliance.at(o);
+        for (const NodeID n : todoList)
+        {
+            if (!needsVersion[n]) continue;
 
-                std::lock_guard<std::mutex> guard(mutex);
+            const int scc = partOf[n];
+            if (scc == -1) continue;
 
-                const Version c = sccToVersion[scc];
-                if (c != invalidVersion)
-                {
-                    this->setConsume(n, o, c);
-                    if (this->isStore(n) || this->isLoad(n)) osStmtReliance[c].set(n);
-                }
+            const Version c = sccToVersion[scc];
+            if (c != invalidVersion)
+            {
+                consumed[thread][n % threads].push_back({n, o, c});
+                if (this->isStore(n) || this->isLoad(n)) osStmtReliance[c].set(n);
+            }
 
-                if (this->isStore(n))
-                {
-                    const Map<NodeID, Version>::const_iterator yIt = storesYieldedVersion.find(n);
-                    if (yIt != storesYieldedVersion.end()) this->setYield(n, o, yIt->second);
-                }
+            if (this->isStore(n))
+            {
+                const Map<NodeID, Version>::const_iterator yIt = storesYieldedVersion.find(n);
+                if (yIt != storesYieldedVersion.end()) yielded[thread][n % threads].push_back({n, o, yIt->second});
             }
         }
+
+        busyTime[thread] += threadCPUTime() - busyStart;
     };
 
-    std::vector<std::thread> workers;
-    for (unsigned i = 0; i < Options::VersioningThreads(); ++i) workers.push_back(std::thread(meldVersionWorker, i));
-    for (std::thread &worker : workers) worker.join();
+    double versioningStart = wallTime();
+    WorkStealingList<NodeID>::forEach(objects, threads, meldVersionObject);
+    double versioningTime = wallTime() - versioningStart;
+
+    versioningThreadUtil.resize(threads);
+    for (u32_t t = 0; t < threads; ++t)
+    {
+        versioningThreadUtil[t] = versioningTime > 0.0 ? busyTime[t] / versioningTime : 0.0;
+    }
 
-    delete[] versionMutexes;
+    // Move the versions into consume and yield, one bucket of locations per thread.
+    std::vector<u32_t> buckets(threads);
+    for (u32_t b = 0; b < threads; ++b) buckets[b] = b;
+    WorkStealingList<u32_t>::forEach(buckets, threads, [this, &consumed, &yielded, threads](const u32_t b, u32_t)
+    {
+        for (u32_t t = 0; t < threads; ++t)
+        {
+            for (const LocVersion &lv : consumed[t][b]) consume[lv.l].push_back(std::make_pair(lv.o, lv.v));
+            for (const LocVersion &lv : yielded[t][b]) yield[lv.l].push_back(std::make_pair(lv.o, lv.v));
+            std::vector<LocVersion>().swap(consumed[t][b]);
+            std::vector<LocVersion>().swap(yielded[t][b]);
+        }
+
+        for (NodeID l = b; l < consume.size(); l += threads)
+        {
+            std::sort(consume[l].begin(), consume[l].end());
+            std::sort(yield[l].begin(), yield[l].end());
+        }
+    });
+
+    // Same version and stmt reliance as the canonical. During solving we cannot just reuse
+    // the canonical object's reliance because it may change due to on-the-fly call graph
+    // construction. Something like copy-on-write could be good... probably negligible.
+    for (const std::vector<std::pair<NodeID, NodeID>> &threadEquivalents : equivalents)
+    {
+        for (const std::pair<NodeID, NodeID> &oc : threadEquivalents)
+        {
+            equivalentObject[oc.first] = oc.second;
+            versionReliance.at(oc.first) = versionReliance.at(oc.second);
+            stmtReliance.at(oc.first) = stmtReliance.at(oc.second);
+        }
+    }
 
     double end = stat->getClk(true);
     meldLabelingTime = (end - start) / TIMEINTERVAL;
@@ -545,6 +620,13 @@ void VersionedFlowSensitive::removeAllIndirectSVFGEdges(void)
 
 void VersionedFlowSensitive::propagateVersion(NodeID o, Version v)
 {
+    // Left to processByObject at the end of the round.
+    if (versionPropThreads > 1)
+    {
+        pendingVersions[o].push_back(v);
+        return;
+    }
+
     double start = stat->getClk();
 
     const std::vector<Version> &reliantVersions = getReliantVersions(o, v);
@@ -587,6 +669,223 @@ void VersionedFlowSensitive::propagateVersion(const NodeID o, const Version v, c
     if (time) versionPropTime += (end - start) / TIMEINTERVAL;
 }
 
+void VersionedFlowSensitive::solveWorklist()
+{
+    if (versionPropThreads <= 1)
+    {
+        FlowSensitive::solveWorklist();
+        return;
+    }
+
+    // Loads and stores only read top-level pointers and write address-taken
+    // objects (or the other way around), so they are left to processByObject.
+    // A node is processed at most once per round, with the points-to sets at
+    // the end of it; nodes changed meanwhile are pushed again.
+    while (!isWorklistEmpty() || !pendingVersions.empty())
+    {
+        std::vector<const LoadSVFGNode *> loads;
+        std::vector<const StoreSVFGNode *> stores;
+        NodeBS inRound;
+        while (!isWorklistEmpty())
+        {
+            NodeID n = popFromWorklist();
+            // Not isLoad/isStore: the dummy version propagation nodes added
+            // while solving lie past the end of isLoadMap/isStoreMap.
+            const SVFGNode *sn = svfg->getSVFGNode(n);
+            if (const LoadSVFGNode *load = SVFUtil::dyn_cast<LoadSVFGNode>(sn))
+            {
+                if (inRound.test_and_set(n)) loads.push_back(load);
+                continue;
+            }
+            if (const StoreSVFGNode *store = SVFUtil::dyn_cast<StoreSVFGNode>(sn))
+            {
+                if (inRound.test_and_set(n)) stores.push_back(store);
+                continue;
+            }
+
+            processNode(n);
+            collapseFields();
+        }
+
+        processByObject(loads, stores);
+    }
+}
+
+void VersionedFlowSensitive::processByObject(const std::vector<const LoadSVFGNode *> &loads,
+        const std::vector<const StoreSVFGNode *> &stores)
+{
+    if (loads.empty() && stores.empty() && pendingVersions.empty()) return;
+
+    double start = stat->getClk(true);
+
+    Map<NodeID, ObjectWork> work;
+    for (u32_t i = 0; i < loads.size(); ++i)
+    {
+        // l: p = *q
+        const LoadSVFGNode *load = loads[i];
+        numOfProcessedLoad++;
+        // p = *q, the type of p must be a pointer
+        if (!load->getPAGDstNode()->isPointer()) continue;
+
+        const NodeID l = load->getId();
+        for (NodeID o : getPts(load->getPAGSrcNodeID()))
+        {
+            if (pag->isConstantObj(o)) continue;
+
+            work[o].loads.push_back(std::make_pair(i, l));
+            if (isFieldInsensitive(o))
+            {
+                // Also read the fields of a field-insensitive object.
+                for (NodeID of : getAllFieldsObjVars(o)) work[of].loads.push_back(std::make_pair(i, l));
+            }
+        }
+    }
+
+    for (const StoreSVFGNode *store : stores)
+    {
+        // l: *p = q
+        numOfProcessedStore++;
+        const PointsTo &ppt = getPts(store->getPAGDstNodeID());
+        if (ppt.empty()) continue;
+
+        const NodeID l = store->getId();
+        const NodeID q = store->getPAGSrcNodeID();
+        // *p = q, the type of q must be a pointer
+        if (!getPts(q).empty() && store->getPAGSrcNode()->isPointer())
+        {
+            const PointsToID qPts = persVPtD->getPtsId(q);
+            for (NodeID o : ppt)
+            {
+                if (!pag->isConstantObj(o)) work[o].stores.push_back(std::make_pair(l, qPts));
+            }
+        }
+
+        NodeID singleton = 0;
+        bool isSU = isStrongUpdate(store, singleton);
+        if (isSU) svfgHasSU.set(l);
+        else svfgHasSU.reset(l);
+
+        // pts(o:y) = pts(o:y) U pts(o:c), except for a strongly updated object.
+        for (const ObjToVersionMap::value_type &oc : consume[l])
+        {
+            if (!isSU || oc.first != singleton) work[oc.first].weakStores.push_back(std::make_pair(l, oc.second));
+        }
+    }
+
+    for (Map<NodeID, std::vector<Version>>::value_type &ov : pendingVersions) work[ov.first].versions.swap(ov.second);
+    pendingVersions.clear();
+
+    std::vector<NodeID> objects;
+    objects.reserve(work.size());
+    for (const Map<NodeID, ObjectWork>::value_type &ow : work) objects.push_back(ow.first);
+    std::sort(objects.begin(), objects.end());
+
+    // Each object is owned by one task, which only writes its result.
+    std::vector<ObjectResult> results(objects.size());
+    std::vector<u32_t> tasks(objects.size());
+    for (u32_t i = 0; i < tasks.size(); ++i) tasks[i] = i;
+    WorkStealingList<u32_t>::forEach(tasks, versionPropThreads, [this, &objects, &work, &results](const u32_t i, u32_t)
+    {
+        processObject(objects[i], work.at(objects[i]), results[i]);
+    });
+
+    ++numOfVersionPropRounds;
+
+    NodeBS changedLoads;
+    NodeBS changedStores;
+    for (u32_t i = 0; i < objects.size(); ++i)
+    {
+        const NodeID o = objects[i];
+        for (const std::pair<Version, PointsToID> &vp : results[i].versions)
+        {
+            // o:vp has changed: notify nodes which rely on it.
+            if (persVPtD->unionPtsFromId(atKey(o, vp.first), vp.second))
+            {
+                for (NodeID s : getStmtReliance(o, vp.first)) pushIntoWorklist(s);
+            }
+        }
+
+        for (const std::pair<u32_t, PointsToID> &lp : results[i].loads)
+        {
+            if (persVPtD->unionPtsFromId(loads[lp.first]->getPAGDstNodeID(), lp.second)) changedLoads.set(lp.first);
+        }
+
+        for (NodeID l : results[i].stores) changedStores.set(l);
+    }
+
+    for (u32_t i : changedLoads)
+    {
+        SVFGNode *sn = svfg->getSVFGNode(loads[i]->getId());
+        propagate(&sn);
+    }
+    for (NodeID l : changedStores)
+    {
+        SVFGNode *sn = svfg->getSVFGNode(l);
+        propagate(&sn);
+    }
+
+    double end = stat->getClk(true);
+    objectRoundTime += (end - start) / TIMEINTERVAL;
+}
+
+void VersionedFlowSensitive::processObject(const NodeID o, const ObjectWork &work, ObjectResult &result) const
+{
+    // Points-to sets of the versions of o changed so far.
+    Map<Version, PointsToID> newPts;
+    auto getPtsId = [this, o, &newPts](const Version v)
+    {
+        const Map<Version, PointsToID>::const_iterator foundPts = newPts.find(v);
+        return foundPts != newPts.end() ? foundPts->second : persVPtD->getPtsId(atKey(o, v));
+    };
+
+    FIFOWorkList<Version> worklist;
+    for (const Version v : work.versions) worklist.push(v);
+    // Unions pts into o:v, returns whether o:v changed.
+    auto unionPts = [this, &newPts, &worklist, &getPtsId](const Version v, const PointsToID pts)
+    {
+        const PointsToID vPts = getPtsId(v);
+        const PointsToID newVPts = persVPtD->unionPtsIds(vPts, pts);
+        if (newVPts == vPts) return false;
+        newPts[v] = newVPts;
+        worklist.push(v);
+        return true;
+    };
+
+    for (const std::pair<NodeID, PointsToID> &lq : work.stores)
+    {
+        const Version y = getYield(lq.first, o);
+        if (y != invalidVersion && unionPts(y, lq.second)) result.stores.push_back(lq.first);
+    }
+    for (const std::pair<NodeID, Version> &lc : work.weakStores)
+    {
+        const Version y = getYield(lc.first, o);
+        if (y != invalidVersion && unionPts(y, getPtsId(lc.second))) result.stores.push_back(lc.first);
+    }
+
+    // Propagate the versions which changed to the versions relying on them.
+    const VersionRelianceMap::const_iterator osRelianceIt = versionReliance.find(o);
+    while (osRelianceIt != versionReliance.end() && !worklist.empty())
+    {
+        const Version v = worklist.pop();
+        const Map<Version, std::vector<Version>>::const_iterator reliantIt = osRelianceIt->second.find(v);
+        if (reliantIt == osRelianceIt->second.end()) continue;
+
+        const PointsToID vPts = getPtsId(v);
+        for (const Version r : reliantIt->second) unionPts(r, vPts);
+    }
+
+    for (const std::pair<u32_t, NodeID> &il : work.loads)
+    {
+        const Version c = getConsume(il.second, o);
+        if (c == invalidVersion) continue;
+        const PointsToID cPts = getPtsId(c);
+        if (cPts != PersistentPointsToCache<PointsTo>::emptyPointsToId()) result.loads.push_back(std::make_pair(il.first, cPts));
+    }
+
+    result.versions.assign(newPts.begin(), newPts.end());
+    std::sort(result.versions.begin(), result.versions.end());
+}
+
 void VersionedFlowSensitive::processNode(NodeID n)
 {
     SVFGNode* sn = svfg->getSVFGNode(n);
@@ -804,8 +1103,9 @@ Version VersionedFlowSensitive::getVersion(const NodeID l, const NodeID o, const
     const NodeID op = canonObjectIt == equivalentObject.end() ? o : canonObjectIt->second;
 
     const ObjToVersionMap &ovm = lvm[l];
-    const ObjToVersionMap::const_iterator foundVersion = ovm.find(op);
-    return foundVersion == ovm.end() ? invalidVersion : foundVersion->second;
+    const ObjToVersionMap::const_iterator foundVersion
+        = std::lower_bound(ovm.begin(), ovm.end(), std::make_pair(op, invalidVersion));
+    return foundVersion == ovm.end() || foundVersion->first != op ? invalidVersion : foundVersion->second;
 }
 
 Version VersionedFlowSensitive::getConsume(const NodeID l, const NodeID o) const
@@ -823,7 +1123,10 @@ Version VersionedFlowSensitive::getYield(const NodeID l, const NodeID o) const
 void VersionedFlowSensitive::setVersion(const NodeID l, const NodeID o, const Version v, LocVersionMap &lvm)
 {
     ObjToVersionMap &ovm = lvm[l];
-    ovm[o] = v;
+    const ObjToVersionMap::iterator foundVersion
+        = std::lower_bound(ovm.begin(), ovm.end(), std::make_pair(o, invalidVersion));
+    if (foundVersion != ovm.end() && foundVersion->first == o) foundVersion->second = v;
+    else ovm.insert(foundVersion, std::make_pair(o, v));
 }
 
 void VersionedFlowSensitive::setConsume(const NodeID l, const NodeID o, const Version v)
@@ -968,13 +1271,13 @@ void VersionedFlowSensitive::readPtsFromFile(const std::string& filename)
     {
         SVFUtil::outs() << "Loading versioned pointer analysis results from '" << filename << "'...";
 
-        std::ifstream F(filename.c_str());
-        if (!F.is_open())
+        PointsToFileReader F(filename);
+        if (!F.good())
         {
             SVFUtil::outs() << "  error opening file for reading!\n";
             return ;
         }
-        readAndSetObjFieldSensitivity(F,"------");
+        readAndSetObjFieldSensitivity(F);
 
         readVersionedAnalysisResultFromFile(F);
 
@@ -982,12 +1285,11 @@ void VersionedFlowSensitive::readPtsFromFile(const std::string& filename)
 
         readGepObjVarMapFromFile(F);
 
-        readAndSetObjFieldSensitivity(F,"");
+        readAndSetObjFieldSensitivity(F);
 
         // Update callgraph
         updateCallGraph(pag->getIndirectCallsites());
 
-        F.close();
         SVFUtil::outs() << "\n";
     }
 
@@ -1014,14 +1316,14 @@ void VersionedFlowSensitive::solveAndwritePtsToFile(const std::string& filename)
 void VersionedFlowSensitive::writeVersionedAnalysisResultToFile(const std::string& filename)
 {
     SVFUtil::outs() << "Storing Versioned Analysis Result to '" << filename << "'...";
-    std::error_code err;
-    std::fstream f(filename.c_str(), std::ios_base::app);
+    PointsToFileWriter f(filename, true);
     if (!f.good())
     {
         SVFUtil::outs() << "  error opening file for writing!\n";
         return;
     }
 
+    f.beginSection(PointsToFile::VersionedPtsResult);
     for (const VersionedFlowSensitive::LocVersionMap *lvm :
             {
                 &this->consume, &this->yield
@@ -1033,29 +1335,17 @@ void VersionedFlowSensitive::writeVersionedAnalysisResultToFile(const std::strin
             {
                 const NodeID o = ov.first;
                 const Version v = ov.second;
-                if (vPtD->getPts(atKey(o, v)).empty()) continue;
-
-                f <<"[ " <<o <<" " <<v<<" ]"<< " -> { ";
                 const PointsTo &ovPts = vPtD->getPts(atKey(o, v));
-                if (!ovPts.empty())
-                {
-                    for (NodeID n: ovPts)
-                    {
-                        f << n << " ";
-                    }
-                }
-                else
-                {
-                    f << " ";
-                }
-                f << "}\n";
+                if (ovPts.empty()) continue;
+
+                f.writeVarint(o);
+                f.writeVarint(v);
+                f.writePts(ovPts);
             }
         }
     }
+    f.endSection();
 
-    f << "---VERSIONED---\n";
-
-    f.close();
     if (f.good())
     {
         SVFUtil::outs() << "\n";
@@ -1063,46 +1353,18 @@ void VersionedFlowSensitive::writeVersionedAnalysisResultToFile(const std::strin
     }
 }
 
-void VersionedFlowSensitive::readVersionedAnalysisResultFromFile(std::ifstream& F)
+void VersionedFlowSensitive::readVersionedAnalysisResultFromFile(PointsToFileReader& F)
 {
-    std::string line;
-    std::string delimiter1 = " -> { ";
-    std::string delimiter2 = " }";
-    while (F.good())
+    if (!F.seekSection(PointsToFile::VersionedPtsResult))
+        return;
+    while (!F.atSectionEnd())
     {
-        // Parse a single line in the form of "[ var version ] -> { obj1 obj2 obj3 }"
-        getline(F, line);
-        if (line == "---VERSIONED---")     break;
-        std::string pair = line.substr(line.find("[ ")+1, line.find(" ]"));
-
-        // Parse VersionKey
-        std::istringstream ss(pair);
-        NodeID nodeID;
-        Version nodeVersion;
-        ss>> nodeID >> nodeVersion;
+        NodeID nodeID = F.readVarint();
+        Version nodeVersion = F.readVarint();
         VersionedVar keyPair = atKey(nodeID,nodeVersion);
 
-        // Parse Point-to set
-        size_t pos = line.find(delimiter1);
-        if (pos == std::string::npos)    break;
-        if (line.back() != '}')     break;
-        pos = pos + delimiter1.length();
-        size_t len = line.length() - pos - delimiter2.length();
-        std::string objs = line.substr(pos, len);
-        PointsTo dstPts;
-        if (!objs.empty())
-        {
-            std::istringstream pt(objs);
-            NodeID obj;
-            while (pt.good())
-            {
-                pt >> obj;
-                dstPts.set(obj);
-            }
-        }
-
         // union point-to reuslt
-        vPtD->unionPts(keyPair, dstPts);
+        vPtD->unionPts(keyPair, F.readPts());
     }
 
 }
@@ -97,6 +97,11 @@ void VersionedFlowSensitiveStat::performStat()
     timeStatMap["meldLabelingTime"]   = vfspta->meldLabelingTime;
     timeStatMap["PrelabelingTime"]    = vfspta->prelabelingTime;
     timeStatMap["VersionPropTime"]    = vfspta->versionPropTime;
+    timeStatMap["ObjectRoundTime"]    = vfspta->objectRoundTime;
+    for (u32_t t = 0; t < vfspta->versioningThreadUtil.size(); ++t)
+    {
+        timeStatMap["VersioningUtil" + std::to_string(t)] = vfspta->versioningThreadUtil[t];
+    }
 
     PTNumStatMap["TotalPointers"]  = pag->getValueNodeNum() + pag->getFieldValNodeNum();
     PTNumStatMap["TotalObjects"]   = pag->getObjectNodeNum() + pag->getFieldObjNodeNum();
@@ -118,6 +123,10 @@ void VersionedFlowSensitiveStat::performStat()
 
     PTNumStatMap["SolveIterations"] = vfspta->numOfIteration;
 
+    PTNumStatMap["VersioningThreads"] = vfspta->versioningThreadUtil.size();
+    PTNumStatMap["VersionPropThreads"] = vfspta->versionPropThreads;
+    PTNumStatMap["VersionPropRounds"] = vfspta->numOfVersionPropRounds;
+
     PTNumStatMap["IndEdgeSolved"] = vfspta->getNumOfResolvedIndCallEdge();
 
     PTNumStatMap["StrongUpdates"] = vfspta->svfgHasSU.count();
@@ -95,13 +95,19 @@ void WPAPass::runPointerAnalysis(SVFIR* pag, u32_t kind)
         _pta = new AndersenSFR(pag);
         break;
     case PointerAnalysis::AndersenWaveDiff_WPA:
-        _pta = new AndersenWaveDiff(pag);
+        if (Options::AnderThreads() > 1)
+            _pta = new AndersenParallel(pag);
+        else
+            _pta = new AndersenWaveDiff(pag);
         break;
     case PointerAnalysis::Steensgaard_WPA:
         _pta = new Steensgaard(pag);
         break;
     case PointerAnalysis::FSSPARSE_WPA:
-        _pta = new FlowSensitive(pag);
+        if (Options::FsThreads() > 1)
+            _pta = new FlowSensitiveParallel(pag);
+        else
+            _pta = new FlowSensitive(pag);
         break;
     case PointerAnalysis::VFS_WPA:
         _pta = new VersionedFlowSensitive(pag);